@@ -308,7 +308,7 @@ int mReceiveMessage(struct mbn_handler *m, struct mbn_message *msg) {
 
 
 void mError(struct mbn_handler *m, int code, char *str) {
-  log_write("MambaNet Error: %s (%d)", str, code);
+  log_write_level(LOG_LEVEL_ERROR, "MambaNet Error: %s (%d)", str, code);
   m++;
 }
 
@@ -360,7 +360,7 @@ void init(int argc, char **argv) {
   strcpy(socket_path, DEFAULT_UNIX_MAMBANET_PATH);
 
   /* parse options */
-  while((c = getopt(argc, argv, "e:d:l:g:i:v")) != -1) {
+  while((c = getopt(argc, argv, "e:d:l:L:g:i:v")) != -1) {
     switch(c) {
       case 'e':
         if(strlen(optarg) > 50) {
@@ -389,15 +389,22 @@ void init(int argc, char **argv) {
       case 'l':
         strcpy(log_file, optarg);
         break;
+      case 'L':
+        if((log_level = log_level_parse(optarg)) < 0) {
+          fprintf(stderr, "Invalid log level\n");
+          exit(1);
+        }
+        break;
       case 'v':
         verbose=1;
         break;
       default:
-        fprintf(stderr, "Usage: %s [-e dev] [-u path] [-g path] [-d str] [-l path] [-i id]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-e dev] [-u path] [-g path] [-d str] [-l path] [-L level] [-i id]\n", argv[0]);
         fprintf(stderr, "  -e dev   Ethernet device for MambaNet communication.\n");
         fprintf(stderr, "  -i id    UniqueIDPerProduct for the MambaNet node\n");
         fprintf(stderr, "  -g path  Hardware parent or path to gateway socket.\n");
         fprintf(stderr, "  -l path  Path to log file.\n");
+        fprintf(stderr, "  -L level Log level: error, warning, info or debug (default info).\n");
         fprintf(stderr, "  -d str   PostgreSQL database connection options.\n");
         fprintf(stderr, "  -v       Verbose debug output.\n");
         exit(1);
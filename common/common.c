@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 #include <errno.h>
 #include <execinfo.h>
@@ -39,67 +40,98 @@ char sql_lastnotify_changed_in_callback = 0;
 pthread_mutex_t sql_mutex = PTHREAD_MUTEX_INITIALIZER;
 PGconn *sql_conn;
 
-void log_linecount() {
+/* Asynchronous logging
+ * Each thread that logs gets its own single-producer/single-consumer ring,
+ * so log_write() only formats the message and stores it without taking
+ * any lock. The log thread merges the rings in the order the messages were
+ * written (by sequence number) and does the file I/O. */
+#define LOG_RING_SIZE 128 /* power of two */
+#define LOG_IDLE_USEC 20000
+
+struct log_record {
+  unsigned int seq;
+  int level;
+  time_t time;
+  char msg[500];
+};
+
+struct log_ring {
+  volatile unsigned int head, tail; /* head written by producer, tail by consumer */
+  volatile unsigned int dropped;
+  volatile int unused; /* set when the owning thread exited */
+  struct log_ring *next;
+  struct log_record rec[LOG_RING_SIZE];
+};
+
+struct log_ring *log_rings = NULL;
+/* messages dropped by threads that couldn't get a ring */
+volatile unsigned int log_dropped = 0;
+__thread struct log_ring *log_ring_self = NULL;
+pthread_key_t log_ring_key;
+pthread_mutex_t log_rings_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* held while writing to the log file, only one consumer at a time */
+pthread_mutex_t log_write_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_once_t log_once = PTHREAD_ONCE_INIT;
+volatile int log_thread_running = 0;
+volatile int log_reopen_pending = 0;
+unsigned int log_seq = 0;
+int log_level = LOG_LEVEL_INFO;
+
+void log_file_linecount() {
   char str[500];
   linecount=0;
 
   /* re-open the stream in read-mode to count the number of lines of log file */
-  log_close();
-  logfd = fopen(log_file, "r");
-  while( fgets(str, 500, logfd) != NULL ) {
-    linecount++;
+  if(logfd != NULL)
+    fclose(logfd);
+  if((logfd = fopen(log_file, "r")) != NULL) {
+    while( fgets(str, 500, logfd) != NULL ) {
+      linecount++;
+    }
+    fclose(logfd);
   }
   /* re-open the file again in appending mode, ready for logging */
-  log_close();
   logfd = fopen(log_file, "a");
 }
 
-void log_open() {
+int log_file_open() {
   if(logfd != NULL)
     fclose(logfd);
-  if((logfd = fopen(log_file, "a")) == NULL) {
-    fprintf(stderr, "Couldn't open log file: %s\n", strerror(errno));
-    exit(1);
-  }
-  log_linecount();
+  if((logfd = fopen(log_file, "a")) == NULL)
+    return 1;
+  log_file_linecount();
+  return 0;
 }
 
-void log_close() {
+void log_file_close() {
   if(logfd != NULL)
     fclose(logfd);
   logfd = NULL;
 }
 
-
-void log_reopen() {
-  if(logfd == NULL)
-    return;
-  log_write("SIGHUP received, re-opening log file");
-  log_close();
-  log_open();
-}
-
-void log_write(const char *fmt, ...) {
-  va_list ap;
-  char buf[500], tm[20];
-  time_t t = time(NULL);
+/* writes one message to the log file, requires log_write_mutex */
+void log_file_write(int level, time_t t, const char *buf) {
+  static time_t tm_cached = 0;
+  static char tm[20];
   FILE *fd = logfd == NULL ? stderr : logfd;
-  va_start(ap, fmt);
-  vsnprintf(buf, 500, fmt, ap);
-  va_end(ap);
+  const char *lvl = level == LOG_LEVEL_ERROR ? "ERROR: " : (level == LOG_LEVEL_WARNING ? "WARNING: " : "");
+
+  /* only format the time when the second changed */
+  if(t != tm_cached) {
 //  strftime(tm, 20, "%Y-%m-%d %H:%M:%S", gmtime(&t));
-  strftime(tm, 20, "%Y-%m-%d %H:%M:%S", localtime(&t));
-  
+    strftime(tm, 20, "%Y-%m-%d %H:%M:%S", localtime(&t));
+    tm_cached = t;
+  }
+
   if( strncmp(last_error, buf, 500) != 0 )
   {
     if( duplicate_error_cnt )
     {
       fprintf(fd, "[%s] DUPLICATE LOG MESSAGE #%d: %s\n", tm, duplicate_error_cnt+1, last_error );
       duplicate_error_cnt=0;
-    }  
-    fprintf(fd, "[%s] %s\n", tm, buf);
-    fflush(fd);
-    sprintf(last_error, "%s", buf);
+    }
+    fprintf(fd, "[%s] %s%s\n", tm, lvl, buf);
+    snprintf(last_error, 500, "%s", buf);
   }
   else{
     duplicate_error_cnt++;
@@ -108,11 +140,268 @@ void log_write(const char *fmt, ...) {
   if(++linecount > MAX_LINECOUNT_LOGFILE)
   {
     linecount=0;
-    log_close();
+    log_file_close();
     /* re-open to clear the log file */
     logfd = fopen(log_file, "w+");
-    log_open();
-  }  
+    log_file_open();
+  }
+}
+
+/* writes all queued messages, requires log_write_mutex,
+ * returns the number of messages written */
+int log_drain() {
+  struct log_ring *r, *min;
+  struct log_record *rec;
+  unsigned int dropped;
+  char buf[100];
+  int n = 0;
+
+  if(log_reopen_pending) {
+    log_reopen_pending = 0;
+    if(logfd != NULL) {
+      log_file_close();
+      log_file_open();
+      log_file_write(LOG_LEVEL_INFO, time(NULL), "SIGHUP received, re-opened log file");
+    }
+  }
+
+  while(1) {
+    /* find the oldest message of all rings */
+    min = NULL;
+    for(r=log_rings; r!=NULL; r=r->next)
+      if(r->tail != r->head && (min == NULL ||
+          (int)(r->rec[r->tail & (LOG_RING_SIZE-1)].seq - min->rec[min->tail & (LOG_RING_SIZE-1)].seq) < 0))
+        min = r;
+    if(min == NULL)
+      break;
+    __sync_synchronize();
+    rec = &(min->rec[min->tail & (LOG_RING_SIZE-1)]);
+    log_file_write(rec->level, rec->time, rec->msg);
+    __sync_synchronize();
+    min->tail++;
+    n++;
+  }
+
+  dropped = log_dropped ? __sync_lock_test_and_set(&log_dropped, 0) : 0;
+  for(r=log_rings; r!=NULL; r=r->next)
+    if(r->dropped)
+      dropped += __sync_lock_test_and_set(&(r->dropped), 0);
+  if(dropped > 0) {
+    sprintf(buf, "%u log messages dropped, log queue full", dropped);
+    log_file_write(LOG_LEVEL_WARNING, time(NULL), buf);
+    n++;
+  }
+
+  if(n > 0)
+    fflush(logfd == NULL ? stderr : logfd);
+  return n;
+}
+
+void *log_thread_loop(void *arg) {
+  int n;
+  while(1) {
+    pthread_mutex_lock(&log_write_mutex);
+    n = log_drain();
+    pthread_mutex_unlock(&log_write_mutex);
+    if(n == 0)
+      usleep(LOG_IDLE_USEC);
+  }
+  return NULL;
+  arg = NULL;
+}
+
+void log_thread_exit(void *ptr) {
+  ((struct log_ring *)ptr)->unused = 1;
+}
+
+/* make sure nothing is queued while forking, and restart the log thread
+ * in the child (threads don't survive a fork) */
+void log_fork_prepare() {
+  pthread_mutex_lock(&log_rings_mutex);
+  pthread_mutex_lock(&log_write_mutex);
+  log_drain();
+}
+
+void log_fork_parent() {
+  pthread_mutex_unlock(&log_write_mutex);
+  pthread_mutex_unlock(&log_rings_mutex);
+}
+
+void log_fork_child() {
+  pthread_mutex_unlock(&log_write_mutex);
+  pthread_mutex_unlock(&log_rings_mutex);
+  log_thread_running = 0;
+}
+
+/* at exit, but don't hang if the log thread died while writing */
+void log_exit() {
+  int i;
+  for(i=0; i<100; i++) {
+    if(pthread_mutex_trylock(&log_write_mutex) == 0) {
+      log_drain();
+      pthread_mutex_unlock(&log_write_mutex);
+      return;
+    }
+    usleep(1000);
+  }
+}
+
+void log_init() {
+  pthread_key_create(&log_ring_key, log_thread_exit);
+  pthread_atfork(log_fork_prepare, log_fork_parent, log_fork_child);
+  atexit(log_exit);
+}
+
+void log_start_thread() {
+  pthread_t thread;
+  pthread_attr_t attr;
+
+  pthread_mutex_lock(&log_rings_mutex);
+  if(!log_thread_running) {
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if(pthread_create(&thread, &attr, log_thread_loop, NULL) == 0)
+      log_thread_running = 1;
+    pthread_attr_destroy(&attr);
+  }
+  pthread_mutex_unlock(&log_rings_mutex);
+}
+
+struct log_ring *log_get_ring() {
+  struct log_ring *r;
+
+  pthread_once(&log_once, log_init);
+  pthread_mutex_lock(&log_rings_mutex);
+  /* re-use the ring of a thread that exited */
+  for(r=log_rings; r!=NULL; r=r->next)
+    if(r->unused) {
+      r->unused = 0;
+      break;
+    }
+  if(r == NULL && (r = (struct log_ring *)calloc(1, sizeof(struct log_ring))) != NULL) {
+    r->next = log_rings;
+    log_rings = r;
+  }
+  pthread_mutex_unlock(&log_rings_mutex);
+  if(r != NULL)
+    pthread_setspecific(log_ring_key, r);
+  return r;
+}
+
+void log_queue(int level, const char *fmt, va_list ap) {
+  struct log_ring *r = log_ring_self;
+  struct log_record *rec;
+
+  if(level > log_level)
+    return;
+  if(r == NULL && (r = log_ring_self = log_get_ring()) == NULL) {
+    __sync_fetch_and_add(&log_dropped, 1);
+    return;
+  }
+  if(!log_thread_running)
+    log_start_thread();
+
+  if(r->head - r->tail >= LOG_RING_SIZE) {
+    __sync_fetch_and_add(&(r->dropped), 1);
+    return;
+  }
+  rec = &(r->rec[r->head & (LOG_RING_SIZE-1)]);
+  vsnprintf(rec->msg, 500, fmt, ap);
+  rec->level = level;
+  rec->time = time(NULL);
+  rec->seq = __sync_fetch_and_add(&log_seq, 1);
+  __sync_synchronize();
+  r->head++;
+}
+
+void log_flush() {
+  struct log_ring *r;
+  int busy;
+
+  /* the log thread may be writing, wait for the queues to be empty */
+  do {
+    pthread_mutex_lock(&log_write_mutex);
+    log_drain();
+    pthread_mutex_unlock(&log_write_mutex);
+    busy = 0;
+    for(r=log_rings; r!=NULL; r=r->next)
+      if(r->head != r->tail)
+        busy = 1;
+  } while(busy);
+}
+
+void log_linecount() {
+  pthread_mutex_lock(&log_write_mutex);
+  log_file_linecount();
+  pthread_mutex_unlock(&log_write_mutex);
+}
+
+void log_open() {
+  int err;
+  pthread_mutex_lock(&log_write_mutex);
+  err = log_file_open();
+  pthread_mutex_unlock(&log_write_mutex);
+  if(err) {
+    fprintf(stderr, "Couldn't open log file: %s\n", strerror(errno));
+    exit(1);
+  }
+}
+
+void log_close() {
+  log_flush();
+  pthread_mutex_lock(&log_write_mutex);
+  log_file_close();
+  pthread_mutex_unlock(&log_write_mutex);
+}
+
+
+/* called from the signal handler, the log thread does the actual work */
+void log_reopen() {
+  log_reopen_pending = 1;
+}
+
+int log_level_parse(const char *str) {
+  static const char *names[] = { "error", "warning", "info", "debug" };
+  int i;
+
+  for(i=LOG_LEVEL_ERROR; i<=LOG_LEVEL_DEBUG; i++)
+    if(strcasecmp(str, names[i]) == 0 || (str[0] == '0'+i && str[1] == 0))
+      return i;
+  return -1;
+}
+
+void log_write(const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  log_queue(LOG_LEVEL_INFO, fmt, ap);
+  va_end(ap);
+}
+
+void log_write_level(int level, const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  log_queue(level, fmt, ap);
+  va_end(ap);
+}
+
+void log_write_site(struct log_site *site, int max, int level, const char *fmt, ...) {
+  va_list ap;
+  long now = (long)time(NULL);
+  unsigned int suppressed;
+
+  if(site->second != now) {
+    site->second = now;
+    site->count = 0;
+    if(site->suppressed && (suppressed = __sync_lock_test_and_set(&(site->suppressed), 0)) > 0)
+      log_write_level(level, "(%u similar messages suppressed)", suppressed);
+  }
+  if(__sync_fetch_and_add(&(site->count), 1) >= max) {
+    __sync_fetch_and_add(&(site->suppressed), 1);
+    return;
+  }
+  va_start(ap, fmt);
+  log_queue(level, fmt, ap);
+  va_end(ap);
 }
 
 void log_backtrace()
@@ -125,6 +414,13 @@ void log_backtrace()
   char tmp_log[1024];
   Dl_info segvinfo;
 
+  /* write what's queued, unless the log thread itself crashed while writing */
+  if(pthread_mutex_trylock(&log_write_mutex) == 0) {
+    log_drain();
+    pthread_mutex_unlock(&log_write_mutex);
+  }
+  fd = logfd == NULL ? stderr : logfd;
+
   // get void*'s for all entries on the stack
   size = backtrace(array, 10);
 
@@ -261,11 +557,11 @@ PGresult *sql_exec(const char *query, char res, int nparams, const char * const
   PGresult *qs;
   qs = PQexecParams(sql_conn, query, nparams, NULL, values, NULL, NULL, 0);
   if(qs == NULL) {
-    log_write("Fatal PostgreSQL error: %s", PQerrorMessage(sql_conn));
+    log_write_level(LOG_LEVEL_ERROR, "Fatal PostgreSQL error: %s", PQerrorMessage(sql_conn));
     return NULL;
   }
   if(PQresultStatus(qs) != (res ? PGRES_TUPLES_OK : PGRES_COMMAND_OK)) {
-    log_write("SQL Error for %s: %s", query, PQresultErrorMessage(qs));
+    log_write_limit(LOG_LEVEL_ERROR, 10, "SQL Error for %s: %s", query, PQresultErrorMessage(qs));
     PQclear(qs);
     return NULL;
   }
@@ -11,12 +11,40 @@
 extern "C" {
 #endif
 
-/* Logging functions. */
+/* Logging functions. Messages are formatted in the calling thread and
+ * queued in a per-thread ring, a background thread writes them to the
+ * log file, so log_write() never waits on disk I/O. */
+#define LOG_LEVEL_ERROR   0
+#define LOG_LEVEL_WARNING 1
+#define LOG_LEVEL_INFO    2
+#define LOG_LEVEL_DEBUG   3
+
 extern char log_file[500];
+/* messages with a higher level are discarded, default LOG_LEVEL_INFO */
+extern int log_level;
+/* parses a level number (0-3) or name (error, warning, info, debug),
+ * returns -1 if invalid */
+int log_level_parse(const char *);
 void log_write(const char *, ...);
+void log_write_level(int, const char *, ...);
 void log_close();
 void log_open();
 void log_linecount();
+/* wait until all queued messages are written */
+void log_flush();
+
+/* Rate limiting per call site, use log_write_limit(level, max, fmt, ...) to
+ * log at most max messages per second from that line. */
+struct log_site {
+  long second;
+  int count;
+  unsigned int suppressed;
+};
+void log_write_site(struct log_site *, int, int, const char *, ...);
+#define log_write_limit(level, max, ...) do {\
+    static struct log_site _log_site;\
+    log_write_site(&_log_site, max, level, __VA_ARGS__);\
+  } while(0)
 
 
 /* Handles daemonizing and sets signal handling.
@@ -238,6 +238,10 @@ int db_get_matrix_sources()
   }
   PQclear(qres);
 
+  //the mix-minus index is relative to the source offset
+  RebuildSourceUsageIndex();
+  RebuildSourcePosIndex();
+
   LOG_DEBUG("[%s] leave", __func__);
 
   return 1;
@@ -275,6 +279,7 @@ int db_read_slot_config()
     AxumData.RackOrganization[slot_nr-1] = addr;
   }
   PQclear(qres);
+  RebuildSlotAddressIndex();
 
   LOG_DEBUG("[%s] leave", __func__);
 
@@ -453,6 +458,7 @@ int db_read_src_preset(unsigned short int first_preset, unsigned short int last_
     }
   }
   PQclear(qres);
+  RebuildPresetPosIndex();
 
   LOG_DEBUG("[%s] leave", __func__);
   return 1;
@@ -615,6 +621,12 @@ int db_read_src_config(unsigned short int first_src, unsigned short int last_src
 
   db_get_matrix_sources();
 
+  //the redlight/monitor mute settings and source offsets may have changed
+  if (AxumApplicationAndDSPInitialized)
+  {
+    RebuildSourceActivity();
+  }
+
   LOG_DEBUG("[%s] leave", __func__);
 
   return 1;
@@ -892,6 +904,7 @@ int db_read_module_config(unsigned char first_mod, unsigned char last_mod, unsig
       {
         ModuleData->ProcessingPreset4B = 0;
       }
+      InvalidateModulePresetActive(ModuleNr);
       ModuleData->OverruleActive = strcmp(PQgetvalue(qres, cntRow, cntField++), "f");
       DefaultModuleData->InsertUsePreset = strcmp(PQgetvalue(qres, cntRow, cntField++), "f");
       sscanf(PQgetvalue(qres, cntRow, cntField++), "%d", &DefaultModuleData->InsertSource);
@@ -940,6 +953,7 @@ int db_read_module_config(unsigned char first_mod, unsigned char last_mod, unsig
 
         //for now initialize with first settings
       }
+      UpdateModuleHotState(ModuleNr);
 
       //Check if module preset source/preset/routing changeda
       unsigned int FunctionNrToSent = ModuleNr<<12;
@@ -1175,6 +1189,12 @@ int db_read_module_config(unsigned char first_mod, unsigned char last_mod, unsig
   }
   PQclear(qres);
 
+  //source, buss routing and levels feed the source activity
+  if (AxumApplicationAndDSPInitialized)
+  {
+    RebuildSourceActivity();
+  }
+
   LOG_DEBUG("[%s] leave", __func__);
 
   return 1;
@@ -1253,6 +1273,12 @@ int db_read_module_pre_level(unsigned char first_mod, unsigned char last_mod, un
   }
   PQclear(qres);
 
+  //PreModuleLevel may have changed which modules are on-air
+  if (AxumApplicationAndDSPInitialized)
+  {
+    RebuildSourceActivity();
+  }
+
   LOG_DEBUG("[%s] leave", __func__);
 
   return 1;
@@ -1344,6 +1370,12 @@ int db_read_buss_config(unsigned char first_buss, unsigned char last_buss, unsig
   }
   PQclear(qres);
 
+  //PreModuleOn may have changed which modules are on-air
+  if (AxumApplicationAndDSPInitialized)
+  {
+    RebuildSourceActivity();
+  }
+
   LOG_DEBUG("[%s] leave", __func__);
 
   return 1;
@@ -1802,6 +1834,7 @@ int db_read_dest_config(unsigned short int first_dest, unsigned short int last_d
     sscanf(PQgetvalue(qres, cntRow, cntField++), "%d", &DestinationData->Source);
     sscanf(PQgetvalue(qres, cntRow, cntField++), "%hhd", &DestinationData->Routing);
     sscanf(PQgetvalue(qres, cntRow, cntField++), "%d", &DestinationData->MixMinusSource);
+    IndexDestinationMixMinus(number-1);
 
     if ((DestinationData->OutputData[0].MambaNetAddress == 0) && (OldOutput1Address > 0))
     {
@@ -2619,6 +2652,7 @@ int db_read_routing_preset(unsigned char first_mod, unsigned char last_mod)
         RoutingPresetData->On = strcmp(PQgetvalue(qres, cntRow, cntField++), "f");
         RoutingPresetData->PreModuleLevel = strcmp(PQgetvalue(qres, cntRow, cntField++), "f");
         sscanf(PQgetvalue(qres, cntRow, cntField++), "%d", &RoutingPresetData->Balance);
+        InvalidateModulePresetActive(ModuleNr);
 
         if (AxumData.BussMasterData[cntBuss].Console == AxumData.ModuleData[ModuleNr].Console)
         {
@@ -2955,6 +2989,9 @@ int db_insert_slot_config(unsigned char slot_nr, unsigned long int addr, unsigne
   sprintf(str[2], "%d", input_ch_cnt);
   sprintf(str[3], "%d", output_ch_cnt);
 
+  //RackOrganization is already updated by the caller
+  RebuildSlotAddressIndex();
+
   sql_exec("DELETE FROM slot_config WHERE slot_nr = $1", 0, 1, params);
   PGresult *qres = sql_exec("INSERT INTO slot_config (slot_nr, addr, input_ch_cnt, output_ch_cnt) VALUES ($1, $2, $3, $4)", 0, 4, params);
   if (qres == NULL)
@@ -2987,6 +3024,9 @@ int db_delete_slot_config(unsigned char slot_nr)
 
   sprintf(str[0], "%d", slot_nr+1);
 
+  //RackOrganization is already updated by the caller
+  RebuildSlotAddressIndex();
+
   PGresult *qres = sql_exec("DELETE FROM slot_config WHERE slot_nr=$1", 0, 1, params);
   if (qres == NULL)
   {
@@ -127,6 +127,8 @@ long PhaseMeterFrequency = 10; //10Hz
 AXUM_DATA_STRUCT AxumData;
 matrix_sources_struct matrix_sources;
 preset_pos_struct presets;
+pos_index_struct SourcePosIndex;
+pos_index_struct PresetPosIndex;
 
 float dBLevel[256];
 float Phase[128];
@@ -134,6 +136,19 @@ float SummingdBLevel[64];
 float SummingPhase[32];
 unsigned int BackplaneMambaNetAddress = 0x00000000;
 
+//Routing plan: while the axum data lock is held SetBackplaneRouting() only
+//records the wanted input per channel, the changed crosspoints are sent when
+//the lock is released. BackplaneRoutingSent holds what the backplane was last
+//set to, -1 if unknown.
+#define NUMBER_OF_BACKPLANE_CHANNELS 2048
+int BackplaneRoutingSent[NUMBER_OF_BACKPLANE_CHANNELS];
+int BackplaneRoutingPlan[NUMBER_OF_BACKPLANE_CHANNELS];
+unsigned char BackplaneRoutingPlanned[NUMBER_OF_BACKPLANE_CHANNELS];
+unsigned short int BackplaneRoutingPlanChannel[NUMBER_OF_BACKPLANE_CHANNELS];
+int BackplaneRoutingPlanCount = 0;
+unsigned char BackplaneRoutingPlanActive = 0;
+struct timeval BackplaneRoutingPlanStart;
+
 DSP_HANDLER_STRUCT *dsp_handler;
 
 AXUM_FUNCTION_INFORMATION_STRUCT *SourceFunctions[NUMBER_OF_SOURCES+4][NUMBER_OF_SOURCE_FUNCTIONS];
@@ -144,8 +159,82 @@ AXUM_FUNCTION_INFORMATION_STRUCT *DestinationFunctions[NUMBER_OF_DESTINATIONS+4]
 AXUM_FUNCTION_INFORMATION_STRUCT *GlobalFunctions[NUMBER_OF_GLOBAL_FUNCTIONS];
 AXUM_FUNCTION_INFORMATION_STRUCT *ConsoleFunctions[NUMBER_OF_CONSOLES][NUMBER_OF_CONSOLE_FUNCTIONS];
 
+//Number of objects in each function list, kept by MakeObjectListPerFunction()
+unsigned short int SourceFunctionsCount[NUMBER_OF_SOURCES+4][NUMBER_OF_SOURCE_FUNCTIONS];
+unsigned short int ModuleFunctionsCount[NUMBER_OF_MODULES+4][NUMBER_OF_MODULE_FUNCTIONS];
+unsigned short int BussFunctionsCount[NUMBER_OF_BUSSES+4][NUMBER_OF_BUSS_FUNCTIONS];
+unsigned short int MonitorBussFunctionsCount[NUMBER_OF_MONITOR_BUSSES+4][NUMBER_OF_MONITOR_BUSS_FUNCTIONS];
+unsigned short int DestinationFunctionsCount[NUMBER_OF_DESTINATIONS+4][NUMBER_OF_DESTINATION_FUNCTIONS];
+unsigned short int GlobalFunctionsCount[NUMBER_OF_GLOBAL_FUNCTIONS];
+unsigned short int ConsoleFunctionsCount[NUMBER_OF_CONSOLES][NUMBER_OF_CONSOLE_FUNCTIONS];
+
+//ModulePresetActive() of all eight presets as bits, computed at once and
+//invalidated when the module routing/source/preset changes or a new
+//operation takes the axum data lock.
+unsigned char ModulePresetActiveMask[NUMBER_OF_MODULES];
+unsigned char ModulePresetActiveValid[NUMBER_OF_MODULES];
+
 float Position2dB[1024];
 unsigned short int dB2Position[1500];
+
+//Source activity is kept up to date per module event instead of rescanning
+//all modules. Each module counts for at most one source, a source is active
+//while its count is non zero. The redlight and monitor mute counts hold the
+//number of active sources with that setting.
+int ModuleActiveSource[128];
+unsigned short int SourceActiveCount[1280];
+unsigned short int RedlightActiveCount[8];
+unsigned short int MonitorMuteActiveCount[16];
+AXUM_MODULE_HOT_STATE_STRUCT ModuleHotState;
+
+//Signal/peak detection, a module signal/peak goes off when its level drops the
+//hysteresis (dB) below the detect level and the hold time (ms) has passed.
+float SignalDetectHysteresis = DEFAULT_SIGNAL_DETECT_HYSTERESIS;
+unsigned int SignalDetectHoldTime = DEFAULT_SIGNAL_DETECT_HOLD_TIME;
+float PeakDetectHysteresis = DEFAULT_PEAK_DETECT_HYSTERESIS;
+unsigned int PeakDetectHoldTime = DEFAULT_PEAK_DETECT_HOLD_TIME;
+unsigned long ModuleSignalTime[128];
+unsigned long ModulePeakTime[128];
+
+//Start/stop triggers of a source within the debounce time (ms) after its last
+//sent trigger are kept pending, the timer sends the settled state once the
+//debounce time has passed.
+unsigned int StartStopDebounceTime = DEFAULT_START_STOP_DEBOUNCE_TIME;
+unsigned long SourceStartStopTime[NUMBER_OF_SOURCES];
+unsigned char SourceStartStopPending[NUMBER_OF_SOURCES];
+unsigned char SourceStartStopPendingState[NUMBER_OF_SOURCES];
+int StartStopPendingCount;
+START_STOP_TRIGGER_STATISTICS_STRUCT StartStopTriggerStatistics;
+//Indexed by function type, in the order of the *_FUNCTIONS defines.
+SENSOR_CHANGE_HANDLER_STRUCT SensorChangeHandlers[NUMBER_OF_FUNCTION_TYPES] =
+{
+  {SensorChangedModule,       "module",       0, 0, 0},
+  {SensorChangedBuss,         "buss",         0, 0, 0},
+  {SensorChangedMonitorBuss,  "monitor buss", 0, 0, 0},
+  {SensorChangedConsole,      "console",      0, 0, 0},
+  {SensorChangedGlobal,       "global",       0, 0, 0},
+  {SensorChangedSource,       "source",       0, 0, 0},
+  {SensorChangedDestination,  "destination",  0, 0, 0},
+};
+//Receipt time of the sensor change being processed, valid while the axum
+//data lock taken by mSensorDataChanged() is held.
+struct timeval SensorReceiveTime;
+unsigned char SensorReceiveTimeValid;
+volatile sig_atomic_t LogStatisticsRequested;
+
+//Reverse index for the mix-minus checks, kept by SetAxum_ModuleSource() and
+//the destination config: the modules on each source as bitmask and the
+//number of destinations using each source as mix-minus source.
+unsigned int SourceModuleMask[1280][4];
+unsigned short int MixMinusDestinationCount[1280];
+int ModuleIndexedSource[128];
+int DestinationIndexedMixMinus[1280];
+
+//MambaNet address to rack slot lookup for the routing setters, rebuilt
+//from RackOrganization whenever the slot config changes.
+#define SLOT_ADDRESS_HASH_SIZE 64
+unsigned int SlotAddressHashAddr[SLOT_ADDRESS_HASH_SIZE];
+signed char SlotAddressHashSlot[SLOT_ADDRESS_HASH_SIZE];
 unsigned int PulseTime;
 
 unsigned char TraceValue;           //To set the MambaNet trace (0x01=packets, 0x02=address table)
@@ -221,13 +310,23 @@ void axum_data_lock(int l)
   if (l)
   {
     pthread_mutex_lock(&axum_data_mutex);
+    BeginBackplaneRouting();
+    InvalidateAllModulePresetActive();
   }
   else
   {
+    EndBackplaneRouting();
+    SensorReceiveTimeValid = 0;
     pthread_mutex_unlock(&axum_data_mutex);
   }
 }
 
+//SIGUSR1 requests the statistics in the log at runtime, written by the timer.
+void RequestStatistics(int)
+{
+  LogStatisticsRequested = 1;
+}
+
 void init(int argc, char **argv)
 {
   //struct mbn_interface *itf;
@@ -254,7 +353,7 @@ void init(int argc, char **argv)
   strcpy(backup_file, DEFAULT_BACKUP_FILE);
 
   /* parse options */
-  while((c = getopt(argc, argv, "e:d:l:g:i:f:v")) != -1) {
+  while((c = getopt(argc, argv, "e:d:l:L:g:i:f:s:p:t:v")) != -1) {
     switch(c) {
       case 'e':
         if(strlen(optarg) > 50) {
@@ -288,9 +387,33 @@ void init(int argc, char **argv)
       case 'l':
         strcpy(log_file, optarg);
         break;
+      case 'L':
+        if((log_level = log_level_parse(optarg)) < 0) {
+          fprintf(stderr, "Invalid log level\n");
+          exit(1);
+        }
+        break;
       case 'v':
         verbose = 1;
         break;
+      case 's':
+        if(sscanf(optarg, "%f,%u", &SignalDetectHysteresis, &SignalDetectHoldTime) < 1) {
+          fprintf(stderr, "Invalid signal detect hysteresis/hold time\n");
+          exit(1);
+        }
+        break;
+      case 'p':
+        if(sscanf(optarg, "%f,%u", &PeakDetectHysteresis, &PeakDetectHoldTime) < 1) {
+          fprintf(stderr, "Invalid peak detect hysteresis/hold time\n");
+          exit(1);
+        }
+        break;
+      case 't':
+        if(sscanf(optarg, "%u", &StartStopDebounceTime) != 1) {
+          fprintf(stderr, "Invalid start/stop debounce time\n");
+          exit(1);
+        }
+        break;
       case 'f':
         if (dsp_force_eeprom_prg(optarg))
         {
@@ -303,13 +426,17 @@ void init(int argc, char **argv)
         exit(1);
         break;
       default:
-        fprintf(stderr, "Usage: %s [-e dev] [-u path] [-g path] [-d str] [-l path] [-i id]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-e dev] [-u path] [-g path] [-d str] [-l path] [-L level] [-i id] [-s dB[,ms]] [-p dB[,ms]] [-t ms]\n", argv[0]);
         fprintf(stderr, "  -e dev   Ethernet device for MambaNet communication.\n");
         fprintf(stderr, "  -i id    UniqueIDPerProduct for the MambaNet node.\n");
         fprintf(stderr, "  -g path  Hardware parent or path to gateway socket.\n");
         fprintf(stderr, "  -l path  Path to log file.\n");
+        fprintf(stderr, "  -L level Log level: error, warning, info or debug (default info).\n");
         fprintf(stderr, "  -d str   PostgreSQL database connection options.\n");
         fprintf(stderr, "  -v       Verbose output.\n");
+        fprintf(stderr, "  -s dB,ms Signal detect hysteresis and hold time (default %g,%d).\n", (float)DEFAULT_SIGNAL_DETECT_HYSTERESIS, DEFAULT_SIGNAL_DETECT_HOLD_TIME);
+        fprintf(stderr, "  -p dB,ms Peak detect hysteresis and hold time (default %g,%d).\n", (float)DEFAULT_PEAK_DETECT_HYSTERESIS, DEFAULT_PEAK_DETECT_HOLD_TIME);
+        fprintf(stderr, "  -t ms    Start/stop trigger debounce time (default %d), SIGUSR1 logs the trigger and sensor handler latency.\n", DEFAULT_START_STOP_DEBOUNCE_TIME);
         fprintf(stderr, "  -f dev   force EEPROM programming on device 'dev'.\n");
         exit(1);
     }
@@ -392,6 +519,8 @@ void init(int argc, char **argv)
   }
 
 
+  signal(SIGUSR1, RequestStatistics);
+
   if (!verbose)
     daemonize_finish();
 
@@ -450,6 +579,9 @@ int main(int argc, char *argv[])
   AxumApplicationAndDSPInitialized = 1;
   log_write("Parameters in DSPs initialized");
 
+  //module and source configuration were read during init()
+  RebuildSourceActivity();
+
   //Slot configuration, former rack organization
   db_lock(1);
   db_empty_slot_config();
@@ -527,11 +659,15 @@ int main(int argc, char *argv[])
         SetAxum_MonitorBuss(cntBuss);
       }
     }
+    //module data is replaced by the backup
+    RebuildSourceUsageIndex();
+    RebuildSourceActivity();
   }
   for (unsigned char cntSlot=0; cntSlot<42; cntSlot++)
   {
     AxumData.RackOrganization[cntSlot] = 0x00000000;
   }
+  RebuildSlotAddressIndex();
   axum_data_lock(0);
 
   if((mbn = mbnInit(&this_node, NULL, itf, error)) == NULL) {
@@ -597,6 +733,8 @@ int main(int argc, char *argv[])
     }
   }
   log_write("Closing Engine");
+  LogStartStopTriggerStatistics();
+  LogSensorChangeStatistics();
 
   axum_data_lock(1);
   backup_close(0);
@@ -643,26 +781,31 @@ int main(int argc, char *argv[])
 //normally response on a sensor change
 int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, short unsigned int object, unsigned char type, union mbn_data data)
 {
+  struct timeval ReceiveTime;
+
+  gettimeofday(&ReceiveTime, NULL);
   axum_data_lock(1);
+  SensorReceiveTime = ReceiveTime;
+  SensorReceiveTimeValid = 1;
   node_info_lock(1);
   ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement = GetOnlineNodeInformation(message->AddressFrom);
   if (OnlineNodeInformationElement == NULL)
   {
-    log_write("[mSensorDataChanged] OnlineNodeInformationElement not found for address: 0x%08X", message->AddressFrom);
+    log_write_limit(LOG_LEVEL_WARNING, 10, "[mSensorDataChanged] OnlineNodeInformationElement not found for address: 0x%08X", message->AddressFrom);
     node_info_lock(0);
     axum_data_lock(0);
     return 1;
   }
   if (object>=(OnlineNodeInformationElement->UsedNumberOfCustomObjects+1024))
   {
-    log_write("[mSensorDataChanged] Object: %d is unknown, this node (0x%08x), contains %d objects", object, message->AddressFrom, OnlineNodeInformationElement->UsedNumberOfCustomObjects);
+    log_write_limit(LOG_LEVEL_WARNING, 10, "[mSensorDataChanged] Object: %d is unknown, this node (0x%08x), contains %d objects", object, message->AddressFrom, OnlineNodeInformationElement->UsedNumberOfCustomObjects);
     node_info_lock(0);
     axum_data_lock(0);
     return 1;
   }
   else if (object<1024)
   {
-    log_write("[mSensorDataChanged] On node 0x%08X a sensor change is not allowed for object: %d (<1024)", message->AddressFrom, object);
+    log_write_limit(LOG_LEVEL_WARNING, 10, "[mSensorDataChanged] On node 0x%08X a sensor change is not allowed for object: %d (<1024)", message->AddressFrom, object);
     node_info_lock(0);
     axum_data_lock(0);
     return 1;
@@ -708,10 +851,39 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
       {
         unsigned char SensorReceiveFunctionType = (SensorReceiveFunctionNumber>>24)&0xFF;
 
-        switch (SensorReceiveFunctionType)
+        if (SensorReceiveFunctionType < NUMBER_OF_FUNCTION_TYPES)
         {
-          case MODULE_FUNCTIONS:
-          {   //Module
+          SENSOR_CHANGE_HANDLER_STRUCT *SensorChangeHandler = &SensorChangeHandlers[SensorReceiveFunctionType];
+          struct timeval StartTime, EndTime;
+
+          gettimeofday(&StartTime, NULL);
+          SensorChangeHandler->Handler(SensorReceiveFunctionNumber, SensorReceiveFunction, OnlineNodeInformationElement, type, data, DataType, DataSize, DataMinimal, DataMaximal);
+          gettimeofday(&EndTime, NULL);
+
+          unsigned long Latency = ((EndTime.tv_sec-StartTime.tv_sec)*1000000)+(EndTime.tv_usec-StartTime.tv_usec);
+          SensorChangeHandler->Calls++;
+          SensorChangeHandler->TotalLatency += Latency;
+          if (Latency > SensorChangeHandler->MaxLatency)
+          {
+            SensorChangeHandler->MaxLatency = Latency;
+          }
+        }
+      }
+      SensorReceiveFunction->PreviousLastChangedTime = SensorReceiveFunction->LastChangedTime;
+    }
+  }
+  node_info_lock(0);
+  axum_data_lock(0);
+
+  return 0;
+
+  mbn=NULL;
+}
+
+//Sensor change handlers per function type, called by mSensorDataChanged()
+//through SensorChangeHandlers[] with the axum data and node info locks held.
+void SensorChangedModule(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal)
+{   //Module
             unsigned int ModuleNr = (SensorReceiveFunctionNumber>>12)&0xFFF;
             unsigned int FunctionNr = SensorReceiveFunctionNumber&0xFFF;
             unsigned char ConsoleNr = AxumData.ModuleData[ModuleNr].Console;
@@ -1067,7 +1239,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                       for (int cntModule=0; cntModule<128; cntModule++)
                       {
-                        if (AxumData.ModuleData[cntModule].SelectedSource == AxumData.ModuleData[ModuleNr].SelectedSource)
+                        if (ModuleHotState.SelectedSource[cntModule] == AxumData.ModuleData[ModuleNr].SelectedSource)
                         {
                           FunctionNrToSent = (cntModule<<12);
                           CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_PHANTOM);
@@ -1109,7 +1281,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                       for (int cntModule=0; cntModule<128; cntModule++)
                       {
-                        if (AxumData.ModuleData[cntModule].SelectedSource == AxumData.ModuleData[ModuleNr].SelectedSource)
+                        if (ModuleHotState.SelectedSource[cntModule] == AxumData.ModuleData[ModuleNr].SelectedSource)
                         {
                           FunctionNrToSent = (cntModule<<12);
                           CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_PAD);
@@ -1154,7 +1326,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                     for (int cntModule=0; cntModule<128; cntModule++)
                     {
-                      if (AxumData.ModuleData[cntModule].SelectedSource == AxumData.ModuleData[ModuleNr].SelectedSource)
+                      if (ModuleHotState.SelectedSource[cntModule] == AxumData.ModuleData[ModuleNr].SelectedSource)
                       {
                         FunctionNrToSent = (cntModule<<12);
                         CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_GAIN_LEVEL);
@@ -1188,7 +1360,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                           for (int cntModule=0; cntModule<128; cntModule++)
                           {
-                            if (AxumData.ModuleData[cntModule].SelectedSource == AxumData.ModuleData[ModuleNr].SelectedSource)
+                            if (ModuleHotState.SelectedSource[cntModule] == AxumData.ModuleData[ModuleNr].SelectedSource)
                             {
                               FunctionNrToSent = (cntModule<<12);
                               CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_GAIN_LEVEL);
@@ -2168,6 +2340,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                   int FunctionOffset = (MODULE_CONTROL_MODE_BUSS_1_2-MODULE_CONTROL_MODE_BUSS_3_4)*BussNr;
                   DoAxum_UpdateModuleControlMode(ModuleNr, MODULE_CONTROL_MODE_BUSS_1_2+FunctionOffset);
                 }
+                InvalidateModulePresetActive(ModuleNr);
                 for (cntPreset=0; cntPreset<8; cntPreset++)
                 {
                   if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -2233,6 +2406,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                     }
                   }
                 }
+                InvalidateModulePresetActive(ModuleNr);
                 for (cntPreset=0; cntPreset<8; cntPreset++)
                 {
                   if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -2402,6 +2576,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                   unsigned int FunctionNrToSend = ModuleNr<<12;
                   CheckObjectsToSent(FunctionNrToSend | FunctionNr);
                 }
+                InvalidateModulePresetActive(ModuleNr);
                 for (cntPreset=0; cntPreset<8; cntPreset++)
                 {
                   if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -2567,7 +2742,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                       for (int cntModule=0; cntModule<128; cntModule++)
                       {
-                        if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                        if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                         {
                           DisplayFunctionNr = (cntModule<<12);
                           CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_START);
@@ -2620,7 +2795,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                       for (int cntModule=0; cntModule<128; cntModule++)
                       {
-                        if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                        if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                         {
                           DisplayFunctionNr = (cntModule<<12) | MODULE_FUNCTION_SOURCE_ALERT;
                           CheckObjectsToSent(DisplayFunctionNr);
@@ -2992,10 +3167,10 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
               }
               break;
             }
-          }
-          break;
-          case BUSS_FUNCTIONS:
-          {   //Busses
+}
+
+void SensorChangedBuss(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal)
+{   //Busses
             unsigned int BussNr = (SensorReceiveFunctionNumber>>12)&0xFFF;
             unsigned int FunctionNr = SensorReceiveFunctionNumber&0xFFF;
 
@@ -3279,10 +3454,10 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
               }
               break;
             }
-          }
-          break;
-          case MONITOR_BUSS_FUNCTIONS:
-          {   //Monitor Busses
+}
+
+void SensorChangedMonitorBuss(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal)
+{   //Monitor Busses
             int MonitorBussNr = (SensorReceiveFunctionNumber>>12)&0xFFF;
             int FunctionNr = SensorReceiveFunctionNumber&0xFFF;
 
@@ -3780,10 +3955,10 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
               }
               break;
             }
-          }
-          break;
-          case CONSOLE_FUNCTIONS:
-          {
+}
+
+void SensorChangedConsole(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal)
+{
             unsigned int ConsoleNr = (SensorReceiveFunctionNumber>>12)&0xFFF;
             int FunctionNr = SensorReceiveFunctionNumber&0xFFF;
 
@@ -4684,10 +4859,10 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
               }
               break;
             }
-          }
-          break;
-          case GLOBAL_FUNCTIONS:
-          {   //Global
+}
+
+void SensorChangedGlobal(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal)
+{   //Global
             unsigned int GlobalNr = (SensorReceiveFunctionNumber>>12)&0xFFF;
             unsigned int FunctionNr = SensorReceiveFunctionNumber&0xFFF;
 
@@ -4776,10 +4951,10 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                 break;
               }
             }
-          }
-          break;
-          case SOURCE_FUNCTIONS:
-          { //Source
+}
+
+void SensorChangedSource(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal)
+{ //Source
             int SourceNr = ((SensorReceiveFunctionNumber>>12)&0xFFF);
             unsigned int FunctionNr = SensorReceiveFunctionNumber&0xFFF;
 
@@ -4800,7 +4975,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                 {
                   for (int cntModule=0; cntModule<128; cntModule++)
                   {
-                    if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                    if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                     {
                       int CurrentOn = AxumData.ModuleData[cntModule].On;
 
@@ -4887,7 +5062,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                 {
                   for (int cntModule=0; cntModule<128; cntModule++)
                   {
-                    if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                    if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                     {
                       float CurrentLevel = AxumData.ModuleData[cntModule].FaderLevel;
                       if (data.State)
@@ -4991,7 +5166,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                 {
                   for (int cntModule=0; cntModule<128; cntModule++)
                   {
-                    if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                    if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                     {
                       float CurrentLevel = AxumData.ModuleData[cntModule].FaderLevel;
                       float CurrentOn = AxumData.ModuleData[cntModule].On;
@@ -5123,7 +5298,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                 for (int cntModule=0; cntModule<128; cntModule++)
                 {
-                  if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                  if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                   {
                     unsigned char NewState = 1;
 
@@ -5153,7 +5328,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                 for (int cntModule=0; cntModule<128; cntModule++)
                 {
-                  if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                  if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                   {
                     unsigned char NewState = 0;
                     DoAxum_SetBussOnOff(cntModule, BussNr, NewState, 0);
@@ -5184,7 +5359,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
                   for (int cntModule=0; cntModule<128; cntModule++)
                   {
                     unsigned char NewState = AxumData.ModuleData[cntModule].Buss[BussNr].On;
-                    if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                    if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                     {
                       if (data.State)
                       {
@@ -5273,7 +5448,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                     for (int cntModule=0; cntModule<128; cntModule++)
                     {
-                      if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                      if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                       {
                         DisplayFunctionNr = (cntModule<<12);
                         CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_START);
@@ -5316,7 +5491,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                       for (int cntModule=0; cntModule<128; cntModule++)
                       {
-                        if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                        if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                         {
                           FunctionNrToSent = (cntModule<<12);
                           CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_PHANTOM);
@@ -5360,7 +5535,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                       for (int cntModule=0; cntModule<128; cntModule++)
                       {
-                        if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                        if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                         {
                           DisplayFunctionNr = (cntModule<<12) | MODULE_FUNCTION_SOURCE_PAD;
                           CheckObjectsToSent(DisplayFunctionNr);
@@ -5403,7 +5578,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                       for (int cntModule=0; cntModule<128; cntModule++)
                       {
-                        if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                        if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                         {
                           unsigned int FunctionNrToSent = (cntModule<<12);
                           CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_GAIN_LEVEL);
@@ -5431,7 +5606,7 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
 
                     for (int cntModule=0; cntModule<128; cntModule++)
                     {
-                      if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                      if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                       {
                         DisplayFunctionNr = (cntModule<<12) | MODULE_FUNCTION_SOURCE_ALERT;
                         CheckObjectsToSent(DisplayFunctionNr);
@@ -5474,10 +5649,10 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
               }
               break;
             }
-          }
-          break;
-          case DESTINATION_FUNCTIONS:
-          { //Destination
+}
+
+void SensorChangedDestination(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal)
+{ //Destination
             unsigned int DestinationNr = ((SensorReceiveFunctionNumber>>12)&0xFFF);
             unsigned int FunctionNr = SensorReceiveFunctionNumber&0xFFF;
 
@@ -5814,19 +5989,6 @@ int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, sho
               }
               break;
             }
-          }
-          break;
-        }
-      }
-      SensorReceiveFunction->PreviousLastChangedTime = SensorReceiveFunction->LastChangedTime;
-    }
-  }
-  node_info_lock(0);
-  axum_data_lock(0);
-
-  return 0;
-
-  mbn=NULL;
 }
 
 //normally response on GetSensorData
@@ -5839,14 +6001,14 @@ int mSensorDataResponse(struct mbn_handler *mbn, struct mbn_message *message, sh
 
   if (OnlineNodeInformationElement == NULL)
   {
-    log_write("[mSensorDataResponse] OnlineNodeInformationElement not found for address: 0x%08X", message->AddressFrom);
+    log_write_limit(LOG_LEVEL_WARNING, 10, "[mSensorDataResponse] OnlineNodeInformationElement not found for address: 0x%08X", message->AddressFrom);
     node_info_lock(0);
     axum_data_lock(0);
     return 1;
   }
   if (object>=(OnlineNodeInformationElement->UsedNumberOfCustomObjects+1024))
   {
-    log_write("[mSensorDataResponse] Object: %d is unknown, this node (0x%08x), contains %d objects", object, message->AddressFrom, OnlineNodeInformationElement->UsedNumberOfCustomObjects);
+    log_write_limit(LOG_LEVEL_WARNING, 10, "[mSensorDataResponse] Object: %d is unknown, this node (0x%08x), contains %d objects", object, message->AddressFrom, OnlineNodeInformationElement->UsedNumberOfCustomObjects);
     node_info_lock(0);
     axum_data_lock(0);
     return 1;
@@ -5872,6 +6034,7 @@ int mSensorDataResponse(struct mbn_handler *mbn, struct mbn_message *message, sh
             if (BackplaneMambaNetAddress != OnlineNodeInformationElement->MambaNetAddress)
             { //Initialize all routing
               BackplaneMambaNetAddress = OnlineNodeInformationElement->MambaNetAddress;
+              ResetBackplaneRouting();
 
               SetBackplaneClock();
 
@@ -6017,7 +6180,7 @@ int mSensorDataResponse(struct mbn_handler *mbn, struct mbn_message *message, sh
 
             for (int cntModule=0; cntModule<128; cntModule++)
             {
-              if (AxumData.ModuleData[cntModule].SelectedSource == (cntSource+matrix_sources.src_offset.min.source))
+              if (ModuleHotState.SelectedSource[cntModule] == (cntSource+matrix_sources.src_offset.min.source))
               {
                 //Found source @ module 'cntModule'
                 SetAxum_ModuleSource(cntModule);
@@ -6520,6 +6683,13 @@ void mAddressTableChange(struct mbn_handler *mbn, struct mbn_address_node *old_i
           }
         }
 
+        if (old_info->MambaNetAddr == BackplaneMambaNetAddress)
+        { //backplane offline, after it is back all routing must be sent again
+          log_write("Backplane 0x%08lX removed", old_info->MambaNetAddr);
+          BackplaneMambaNetAddress = 0x00000000;
+          ResetBackplaneRouting();
+        }
+
         //remove audio routing if set..
         db_lock(1);
         for (unsigned char cntSlot=0; cntSlot<42; cntSlot++)
@@ -6548,7 +6718,7 @@ void mAddressTableChange(struct mbn_handler *mbn, struct mbn_address_node *old_i
             //Found source 'cntSource'
             for (int cntModule=0; cntModule<128; cntModule++)
             {
-              if (AxumData.ModuleData[cntModule].SelectedSource == (cntSource+matrix_sources.src_offset.min.source))
+              if (ModuleHotState.SelectedSource[cntModule] == (cntSource+matrix_sources.src_offset.min.source))
               {
                 //Found source @ module 'cntModule'
                 SetAxum_ModuleSource(cntModule);
@@ -6645,12 +6815,18 @@ void mAddressTableChange(struct mbn_handler *mbn, struct mbn_address_node *old_i
 }
 
 void mError(struct mbn_handler *m, int code, char *str) {
-  log_write("MambaNet Error: %s (%d)", str, code);
+  log_write_level(LOG_LEVEL_ERROR, "MambaNet Error: %s (%d)", str, code);
   m=NULL;
 }
 
 void mAcknowledgeTimeout(struct mbn_handler *m, struct mbn_message *msg) {
-  log_write("Acknowledge timeout for message to %08lX, obj: %d", msg->AddressTo, msg->Message.Object.Number);
+  log_write_level(LOG_LEVEL_WARNING, "Acknowledge timeout for message to %08lX, obj: %d", msg->AddressTo, msg->Message.Object.Number);
+  if ((msg->AddressTo == BackplaneMambaNetAddress) &&
+      (msg->Message.Object.Number >= 1032) && (msg->Message.Object.Number < (1032+NUMBER_OF_BACKPLANE_CHANNELS)))
+  { //crosspoint state unknown, so it is sent again on the next routing
+    //(single store, no axum data lock from the MambaNet callback)
+    BackplaneRoutingSent[msg->Message.Object.Number-1032] = -1;
+  }
   m=NULL;
 }
 
@@ -6739,60 +6915,23 @@ void Timer100HzDone(int Value)
     dsp_read_module_levelmeters(dsp_handler, dBLevel);
 
     axum_data_lock(1);
-    for (int cntModule=0; cntModule<128; cntModule++)
-    {
-      int FirstChannelNr = cntModule<<1;
-      unsigned int DisplayFunctionNumber;
-
-      CheckObjectsToSent((cntModule<<12) | MODULE_FUNCTION_AUDIO_LEVEL_LEFT);
-      CheckObjectsToSent((cntModule<<12) | MODULE_FUNCTION_AUDIO_LEVEL_RIGHT);
-
-      if (((dBLevel[FirstChannelNr]+AxumData.Headroom)>-30) || ((dBLevel[FirstChannelNr+1]+AxumData.Headroom)>-30))
-      {   //Signal
-        if (!AxumData.ModuleData[cntModule].Signal)
-        {
-          AxumData.ModuleData[cntModule].Signal = 1;
-
-          DisplayFunctionNumber = (cntModule<<12) | MODULE_FUNCTION_SIGNAL;
-          CheckObjectsToSent(DisplayFunctionNumber);
-        }
+    DetectModuleSignalAndPeak(dBLevel);
+    axum_data_lock(0);
+  }
 
-        if ((dBLevel[FirstChannelNr]>-3) || (dBLevel[FirstChannelNr+1]>-3))
-        {   //Peak
-          if (!AxumData.ModuleData[cntModule].Peak)
-          {
-            AxumData.ModuleData[cntModule].Peak = 1;
-            DisplayFunctionNumber = (cntModule<<12) | MODULE_FUNCTION_PEAK;
-            CheckObjectsToSent(DisplayFunctionNumber);
-          }
-        }
-        else
-        {
-          if (AxumData.ModuleData[cntModule].Peak)
-          {
-            AxumData.ModuleData[cntModule].Peak = 0;
-            DisplayFunctionNumber = (cntModule<<12) | MODULE_FUNCTION_PEAK;
-            CheckObjectsToSent(DisplayFunctionNumber);
-          }
-        }
-      }
-      else
-      {
-        if (AxumData.ModuleData[cntModule].Signal)
-        {
-          AxumData.ModuleData[cntModule].Signal = 0;
-          DisplayFunctionNumber = (cntModule<<12) | MODULE_FUNCTION_SIGNAL;
-          CheckObjectsToSent(DisplayFunctionNumber);
+  if (StartStopPendingCount>0)
+  {
+    axum_data_lock(1);
+    SettleStartStopTriggers();
+    axum_data_lock(0);
+  }
 
-          if (AxumData.ModuleData[cntModule].Peak)
-          {
-            AxumData.ModuleData[cntModule].Peak = 0;
-            DisplayFunctionNumber = (cntModule<<12) | MODULE_FUNCTION_PEAK;
-            CheckObjectsToSent(DisplayFunctionNumber);
-          }
-        }
-      }
-    }
+  if (LogStatisticsRequested)
+  {
+    LogStatisticsRequested = 0;
+    axum_data_lock(1);
+    LogStartStopTriggerStatistics();
+    LogSensorChangeStatistics();
     axum_data_lock(0);
   }
 
@@ -7531,7 +7670,7 @@ float CalculateEQ(float *Coefficients, float Gain, int Frequency, float Bandwidt
   return a0/b0;
 }
 
-void SetBackplaneRouting(unsigned int FormInputNr, unsigned int ChannelNr)
+void SendBackplaneRouting(unsigned int FormInputNr, unsigned int ChannelNr)
 {
   int ObjectNr = 1032+ChannelNr;
 
@@ -7541,6 +7680,86 @@ void SetBackplaneRouting(unsigned int FormInputNr, unsigned int ChannelNr)
 
     data.UInt = FormInputNr;
     mbnSetActuatorData(mbn, BackplaneMambaNetAddress, ObjectNr, MBN_DATATYPE_UINT, 2, data, 1);
+
+    if (ChannelNr<NUMBER_OF_BACKPLANE_CHANNELS)
+    {
+      BackplaneRoutingSent[ChannelNr] = FormInputNr;
+    }
+  }
+}
+
+void SetBackplaneRouting(unsigned int FormInputNr, unsigned int ChannelNr)
+{
+  if (ChannelNr>=NUMBER_OF_BACKPLANE_CHANNELS)
+  {
+    SendBackplaneRouting(FormInputNr, ChannelNr);
+  }
+  else if (!BackplaneRoutingPlanActive)
+  {
+    if (BackplaneRoutingSent[ChannelNr] != (int)FormInputNr)
+    {
+      SendBackplaneRouting(FormInputNr, ChannelNr);
+    }
+  }
+  else
+  {
+    if (!BackplaneRoutingPlanned[ChannelNr])
+    {
+      if (BackplaneRoutingPlanCount == 0)
+      {
+        gettimeofday(&BackplaneRoutingPlanStart, NULL);
+      }
+      BackplaneRoutingPlanChannel[BackplaneRoutingPlanCount++] = ChannelNr;
+      BackplaneRoutingPlanned[ChannelNr] = 1;
+    }
+    BackplaneRoutingPlan[ChannelNr] = FormInputNr;
+  }
+}
+
+void BeginBackplaneRouting()
+{
+  BackplaneRoutingPlanActive = 1;
+}
+
+//Sends the crosspoints of the plan that differ from the backplane state
+void EndBackplaneRouting()
+{
+  int NumberOfChanges = 0;
+
+  BackplaneRoutingPlanActive = 0;
+  if (BackplaneRoutingPlanCount == 0)
+  {
+    return;
+  }
+
+  for (int cntPlan=0; cntPlan<BackplaneRoutingPlanCount; cntPlan++)
+  {
+    unsigned int ChannelNr = BackplaneRoutingPlanChannel[cntPlan];
+
+    if (BackplaneRoutingSent[ChannelNr] != BackplaneRoutingPlan[ChannelNr])
+    {
+      SendBackplaneRouting(BackplaneRoutingPlan[ChannelNr], ChannelNr);
+      NumberOfChanges++;
+    }
+    BackplaneRoutingPlanned[ChannelNr] = 0;
+  }
+
+  if (NumberOfChanges)
+  {
+    struct timeval Now;
+    gettimeofday(&Now, NULL);
+    LOG_DEBUG("[%s] %d of %d crosspoints changed, queued %ld us after the first change", __func__, NumberOfChanges, BackplaneRoutingPlanCount,
+              ((Now.tv_sec-BackplaneRoutingPlanStart.tv_sec)*1000000)+(Now.tv_usec-BackplaneRoutingPlanStart.tv_usec));
+  }
+  BackplaneRoutingPlanCount = 0;
+}
+
+//Forget the backplane state, all crosspoints are sent again
+void ResetBackplaneRouting()
+{
+  for (int cntChannel=0; cntChannel<NUMBER_OF_BACKPLANE_CHANNELS; cntChannel++)
+  {
+    BackplaneRoutingSent[cntChannel] = -1;
   }
 }
 
@@ -7700,6 +7919,9 @@ void SetAxum_BussLevels(unsigned int ModuleNr)
 
   DSPCARD_STRUCT *dspcard = &dsp_handler->dspcard[DSPCardNr];
 
+  InvalidateModulePresetActive(ModuleNr);
+  UpdateModuleHotState(ModuleNr);
+
   //Panorama
   float RightPos = AxumData.ModuleData[ModuleNr].Panorama;
   float LeftPos = 1023-RightPos;
@@ -7847,6 +8069,72 @@ void SetAxum_BussLevels(unsigned int ModuleNr)
   }
 }
 
+//First backplane channel of a rack slot, -1 for slots without I/O routing
+int SlotChannelBase(int SlotNr)
+{
+  if ((SlotNr>=0) && (SlotNr<15))
+  {
+    return SlotNr*32;
+  }
+  else if ((SlotNr>=15) && (SlotNr<19))
+  {
+    return 480+((SlotNr-15)*32*5);
+  }
+  else if ((SlotNr>=21) && (SlotNr<42))
+  {
+    return 1120+((SlotNr-21)*32);
+  }
+  return -1;
+}
+
+unsigned int SlotAddressHash(unsigned int MambaNetAddress)
+{
+  return (MambaNetAddress*2654435761u)>>26;
+}
+
+//If an address is listed in more slots the highest routable slot is used
+void RebuildSlotAddressIndex()
+{
+  memset(SlotAddressHashAddr, 0, sizeof(SlotAddressHashAddr));
+  memset(SlotAddressHashSlot, -1, sizeof(SlotAddressHashSlot));
+
+  for (int cntSlot=0; cntSlot<42; cntSlot++)
+  {
+    unsigned int MambaNetAddress = AxumData.RackOrganization[cntSlot];
+    if ((MambaNetAddress != 0) && (SlotChannelBase(cntSlot) != -1))
+    {
+      unsigned int HashNr = SlotAddressHash(MambaNetAddress);
+      while ((SlotAddressHashSlot[HashNr] != -1) && (SlotAddressHashAddr[HashNr] != MambaNetAddress))
+      {
+        HashNr = (HashNr+1)&(SLOT_ADDRESS_HASH_SIZE-1);
+      }
+      SlotAddressHashAddr[HashNr] = MambaNetAddress;
+      SlotAddressHashSlot[HashNr] = cntSlot;
+    }
+  }
+}
+
+//Returns the first backplane channel of the slot holding MambaNetAddress,
+//-1 if the address is not in a routable slot
+int GetSlotChannelBase(unsigned int MambaNetAddress)
+{
+  if (MambaNetAddress == 0)
+  {
+    return -1;
+  }
+
+  unsigned int HashNr = SlotAddressHash(MambaNetAddress);
+  while (SlotAddressHashSlot[HashNr] != -1)
+  {
+    if (SlotAddressHashAddr[HashNr] == MambaNetAddress)
+    {
+      return SlotChannelBase(SlotAddressHashSlot[HashNr]);
+    }
+    HashNr = (HashNr+1)&(SLOT_ADDRESS_HASH_SIZE-1);
+  }
+  return -1;
+}
+
 void axum_get_mtrx_chs_from_src(int src, unsigned int *l_ch, unsigned int *r_ch)
 {
   *l_ch = 0;
@@ -7923,44 +8211,17 @@ void axum_get_mtrx_chs_from_src(int src, unsigned int *l_ch, unsigned int *r_ch)
     char SourceFound = 0;
 
     //Get slot number from MambaNet Address
-    for (int cntSlot=0; cntSlot<15; cntSlot++)
-    {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.SourceData[SourceNr].InputData[0].MambaNetAddress)
-      {
-        *l_ch = cntSlot*32;
-        SourceFound=1;
-      }
-      if (AxumData.RackOrganization[cntSlot] == AxumData.SourceData[SourceNr].InputData[1].MambaNetAddress)
-      {
-        *r_ch = cntSlot*32;
-        SourceFound=1;
-      }
-    }
-    for (int cntSlot=15; cntSlot<19; cntSlot++)
+    int Input1 = GetSlotChannelBase(AxumData.SourceData[SourceNr].InputData[0].MambaNetAddress);
+    int Input2 = GetSlotChannelBase(AxumData.SourceData[SourceNr].InputData[1].MambaNetAddress);
+    if (Input1 != -1)
     {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.SourceData[SourceNr].InputData[0].MambaNetAddress)
-      {
-        *l_ch = 480+((cntSlot-15)*32*5);
-        SourceFound=1;
-      }
-      if (AxumData.RackOrganization[cntSlot] == AxumData.SourceData[SourceNr].InputData[1].MambaNetAddress)
-      {
-        *r_ch = 480+((cntSlot-15)*32*5);
-        SourceFound=1;
-      }
+      *l_ch = Input1;
+      SourceFound=1;
     }
-    for (int cntSlot=21; cntSlot<42; cntSlot++)
+    if (Input2 != -1)
     {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.SourceData[SourceNr].InputData[0].MambaNetAddress)
-      {
-        *l_ch = 1120+((cntSlot-21)*32);
-        SourceFound=1;
-      }
-      if (AxumData.RackOrganization[cntSlot] == AxumData.SourceData[SourceNr].InputData[1].MambaNetAddress)
-      {
-        *r_ch = 1120+((cntSlot-21)*32);
-        SourceFound=1;
-      }
+      *r_ch = Input2;
+      SourceFound=1;
     }
 
     if (SourceFound)
@@ -7992,6 +8253,10 @@ void SetAxum_ModuleSource(unsigned int ModuleNr)
   unsigned int ToChannelNr;
   unsigned int Input1, Input2;
 
+  IndexModuleSource(ModuleNr);
+  InvalidateModulePresetActive(ModuleNr);
+  UpdateModuleHotState(ModuleNr);
+
   if (dsp_card_available(dsp_handler, DSPCardNr))
   {
     DSPCARD_STRUCT *dspcard = &dsp_handler->dspcard[DSPCardNr];
@@ -8140,39 +8405,8 @@ void SetAxum_ModuleInsertSource(unsigned int ModuleNr)
 
 void SetAxum_RemoveOutputRouting(unsigned int OutputMambaNetAddress, unsigned char OutputSubChannel)
 {
-  int Output = -1;
-
   //Get slot number from MambaNet Address
-  for (int cntSlot=0; cntSlot<15; cntSlot++)
-  {
-    if (OutputMambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == OutputMambaNetAddress)
-      {
-        Output = cntSlot*32;
-      }
-    }
-  }
-  for (int cntSlot=15; cntSlot<19; cntSlot++)
-  {
-    if (OutputMambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == OutputMambaNetAddress)
-      {
-        Output = 480+((cntSlot-15)*32*5);
-      }
-    }
-  }
-  for (int cntSlot=21; cntSlot<42; cntSlot++)
-  {
-    if (OutputMambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == OutputMambaNetAddress)
-      {
-        Output = 1120+((cntSlot-21)*32);
-      }
-    }
-  }
+  int Output = GetSlotChannelBase(OutputMambaNetAddress);
 
   if (Output != -1)
   {
@@ -8192,64 +8426,17 @@ void SetAxum_DestinationSource(unsigned int DestinationNr)
   unsigned int FromChannel1 = 0;
   unsigned int FromChannel2 = 0;
 
+  IndexDestinationMixMinus(DestinationNr);
+
   //Get slot number from MambaNet Address
-  for (int cntSlot=0; cntSlot<15; cntSlot++)
+  Output1 = GetSlotChannelBase(AxumData.DestinationData[DestinationNr].OutputData[0].MambaNetAddress);
+  Output2 = GetSlotChannelBase(AxumData.DestinationData[DestinationNr].OutputData[1].MambaNetAddress);
+
+  if (Output1 != -1)
   {
-    if (AxumData.DestinationData[DestinationNr].OutputData[0].MambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.DestinationData[DestinationNr].OutputData[0].MambaNetAddress)
-      {
-        Output1 = cntSlot*32;
-      }
-    }
-    if (AxumData.DestinationData[DestinationNr].OutputData[1].MambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.DestinationData[DestinationNr].OutputData[1].MambaNetAddress)
-      {
-        Output2 = cntSlot*32;
-      }
-    }
+    Output1 += AxumData.DestinationData[DestinationNr].OutputData[0].SubChannel;
   }
-  for (int cntSlot=15; cntSlot<19; cntSlot++)
-  {
-    if (AxumData.DestinationData[DestinationNr].OutputData[0].MambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.DestinationData[DestinationNr].OutputData[0].MambaNetAddress)
-      {
-        Output1 = 480+((cntSlot-15)*32*5);
-      }
-    }
-    if (AxumData.DestinationData[DestinationNr].OutputData[1].MambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.DestinationData[DestinationNr].OutputData[1].MambaNetAddress)
-      {
-        Output2 = 480+((cntSlot-15)*32*5);
-      }
-    }
-  }
-  for (int cntSlot=21; cntSlot<42; cntSlot++)
-  {
-    if (AxumData.DestinationData[DestinationNr].OutputData[0].MambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.DestinationData[DestinationNr].OutputData[0].MambaNetAddress)
-      {
-        Output1 = 1120+((cntSlot-21)*32);
-      }
-    }
-    if (AxumData.DestinationData[DestinationNr].OutputData[1].MambaNetAddress)
-    {
-      if (AxumData.RackOrganization[cntSlot] == AxumData.DestinationData[DestinationNr].OutputData[1].MambaNetAddress)
-      {
-        Output2 = 1120+((cntSlot-21)*32);
-      }
-    }
-  }
-
-  if (Output1 != -1)
-  {
-    Output1 += AxumData.DestinationData[DestinationNr].OutputData[0].SubChannel;
-  }
-  if (Output2 != -1)
+  if (Output2 != -1)
   {
     Output2 += AxumData.DestinationData[DestinationNr].OutputData[1].SubChannel;
   }
@@ -8263,15 +8450,10 @@ void SetAxum_DestinationSource(unsigned int DestinationNr)
       int MixMinusNr = -1;
       while ((MixMinusNr == -1) && (cntModule<128))
       {
-        if ((AxumData.ModuleData[cntModule].SelectedSource == AxumData.DestinationData[DestinationNr].MixMinusSource))
+        if ((ModuleHotState.SelectedSource[cntModule] == AxumData.DestinationData[DestinationNr].MixMinusSource) &&
+            (ModuleBit(ModuleHotState.BussRouted, cntModule)))
         {
-          for (int cntBuss=0; cntBuss<16; cntBuss++)
-          {
-            if ((AxumData.ModuleData[cntModule].Buss[cntBuss].Assigned) && (AxumData.ModuleData[cntModule].Buss[cntBuss].On))
-            {
-              MixMinusNr = cntModule;
-            }
-          }
+          MixMinusNr = cntModule;
         }
         cntModule++;
       }
@@ -11506,14 +11688,11 @@ void SentDataToObject(unsigned int SensorReceiveFunctionNumber, AXUM_FUNCTION_IN
         case SOURCE_FUNCTION_MODULE_ON_OFF:
         {
           Active = 0;
-          for (int cntModule=0; cntModule<128; cntModule++)
+          for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (AxumData.ModuleData[cntModule].On)
             {
-              if (AxumData.ModuleData[cntModule].On)
-              {
-                Active = 1;
-              }
+              Active = 1;
             }
           }
 
@@ -11533,14 +11712,11 @@ void SentDataToObject(unsigned int SensorReceiveFunctionNumber, AXUM_FUNCTION_IN
         case SOURCE_FUNCTION_MODULE_FADER_ON_OFF:
         {
           Active = 0;
-          for (int cntModule=0; cntModule<128; cntModule++)
+          for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (AxumData.ModuleData[cntModule].FaderLevel>-80)
             {
-              if (AxumData.ModuleData[cntModule].FaderLevel>-80)
-              {
-                Active = 1;
-              }
+              Active = 1;
             }
           }
 
@@ -11560,16 +11736,13 @@ void SentDataToObject(unsigned int SensorReceiveFunctionNumber, AXUM_FUNCTION_IN
         case SOURCE_FUNCTION_MODULE_FADER_AND_ON_ACTIVE_INACTIVE:
         {
           Active = 0;
-          for (int cntModule=0; cntModule<128; cntModule++)
+          for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (AxumData.ModuleData[cntModule].FaderLevel>-80)
             {
-              if (AxumData.ModuleData[cntModule].FaderLevel>-80)
+              if (AxumData.ModuleData[cntModule].On)
               {
-                if (AxumData.ModuleData[cntModule].On)
-                {
-                  Active = 1;
-                }
+                Active = 1;
               }
             }
           }
@@ -11605,14 +11778,11 @@ void SentDataToObject(unsigned int SensorReceiveFunctionNumber, AXUM_FUNCTION_IN
           int BussNr = (FunctionNr-SOURCE_FUNCTION_MODULE_BUSS_1_2_ON)/(SOURCE_FUNCTION_MODULE_BUSS_3_4_ON-SOURCE_FUNCTION_MODULE_BUSS_1_2_ON);
 
           Active = 0;
-          for (int cntModule=0; cntModule<128; cntModule++)
+          for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (AxumData.ModuleData[cntModule].Buss[BussNr].On)
             {
-              if (AxumData.ModuleData[cntModule].Buss[BussNr].On)
-              {
-                Active = 1;
-              }
+              Active = 1;
             }
           }
 
@@ -11640,14 +11810,11 @@ void SentDataToObject(unsigned int SensorReceiveFunctionNumber, AXUM_FUNCTION_IN
           int BussNr = (FunctionNr-SOURCE_FUNCTION_MODULE_BUSS_1_2_OFF)/(SOURCE_FUNCTION_MODULE_BUSS_3_4_OFF-SOURCE_FUNCTION_MODULE_BUSS_1_2_OFF);
 
           Active = 0;
-          for (int cntModule=0; cntModule<128; cntModule++)
+          for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (AxumData.ModuleData[cntModule].Buss[BussNr].On)
             {
-              if (AxumData.ModuleData[cntModule].Buss[BussNr].On)
-              {
-                Active = 1;
-              }
+              Active = 1;
             }
           }
 
@@ -11675,14 +11842,11 @@ void SentDataToObject(unsigned int SensorReceiveFunctionNumber, AXUM_FUNCTION_IN
           int BussNr = (FunctionNr-SOURCE_FUNCTION_MODULE_BUSS_1_2_ON_OFF)/(SOURCE_FUNCTION_MODULE_BUSS_3_4_ON_OFF-SOURCE_FUNCTION_MODULE_BUSS_1_2_ON_OFF);
 
           Active = 0;
-          for (int cntModule=0; cntModule<128; cntModule++)
+          for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (AxumData.ModuleData[cntModule].Buss[BussNr].On)
             {
-              if (AxumData.ModuleData[cntModule].Buss[BussNr].On)
-              {
-                Active = 1;
-              }
+              Active = 1;
             }
           }
           data.State = Active;
@@ -11692,14 +11856,11 @@ void SentDataToObject(unsigned int SensorReceiveFunctionNumber, AXUM_FUNCTION_IN
         case SOURCE_FUNCTION_MODULE_COUGH_ON_OFF:
         {
           Active = 0;
-          for (int cntModule=0; cntModule<128; cntModule++)
+          for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (AxumData.ModuleData[cntModule].Cough)
             {
-              if (AxumData.ModuleData[cntModule].Cough)
-              {
-                Active = 1;
-              }
+              Active = 1;
             }
           }
 
@@ -12405,6 +12566,14 @@ void InitalizeAllObjectListPerFunction()
       DestinationFunctions[cntDestination][cntFunction] = NULL;
     }
   }
+
+  memset(SourceFunctionsCount, 0, sizeof(SourceFunctionsCount));
+  memset(ModuleFunctionsCount, 0, sizeof(ModuleFunctionsCount));
+  memset(BussFunctionsCount, 0, sizeof(BussFunctionsCount));
+  memset(MonitorBussFunctionsCount, 0, sizeof(MonitorBussFunctionsCount));
+  memset(DestinationFunctionsCount, 0, sizeof(DestinationFunctionsCount));
+  memset(GlobalFunctionsCount, 0, sizeof(GlobalFunctionsCount));
+  memset(ConsoleFunctionsCount, 0, sizeof(ConsoleFunctionsCount));
 }
 
 //Make object list per functions
@@ -12414,6 +12583,7 @@ void MakeObjectListPerFunction(unsigned int SensorReceiveFunctionNumber)
   unsigned int FunctionNumber = (SensorReceiveFunctionNumber>>12)&0xFFF;
   unsigned int Function = SensorReceiveFunctionNumber&0xFFF;
   AXUM_FUNCTION_INFORMATION_STRUCT *WalkAxumFunctionInformationStruct = NULL;
+  unsigned short int *NumberOfObjects = NULL;
 
   //Clear function list
   switch (FunctionType)
@@ -12422,42 +12592,49 @@ void MakeObjectListPerFunction(unsigned int SensorReceiveFunctionNumber)
     {   //Module
       WalkAxumFunctionInformationStruct = ModuleFunctions[FunctionNumber][Function];
       ModuleFunctions[FunctionNumber][Function] = NULL;
+      NumberOfObjects = &ModuleFunctionsCount[FunctionNumber][Function];
     }
     break;
     case BUSS_FUNCTIONS:
     {   //Buss
       WalkAxumFunctionInformationStruct = BussFunctions[FunctionNumber][Function];
       BussFunctions[FunctionNumber][Function] = NULL;
+      NumberOfObjects = &BussFunctionsCount[FunctionNumber][Function];
     }
     break;
     case MONITOR_BUSS_FUNCTIONS:
     {   //Monitor Buss
       WalkAxumFunctionInformationStruct = MonitorBussFunctions[FunctionNumber][Function];
       MonitorBussFunctions[FunctionNumber][Function] = NULL;
+      NumberOfObjects = &MonitorBussFunctionsCount[FunctionNumber][Function];
     }
     break;
     case CONSOLE_FUNCTIONS:
     {   //Console
       WalkAxumFunctionInformationStruct = ConsoleFunctions[FunctionNumber][Function];
       ConsoleFunctions[FunctionNumber][Function] = NULL;
+      NumberOfObjects = &ConsoleFunctionsCount[FunctionNumber][Function];
     }
     break;
     case GLOBAL_FUNCTIONS:
     {   //Global
       WalkAxumFunctionInformationStruct = GlobalFunctions[Function];
       GlobalFunctions[Function] = NULL;
+      NumberOfObjects = &GlobalFunctionsCount[Function];
     }
     break;
     case SOURCE_FUNCTIONS:
     {   //Source
       WalkAxumFunctionInformationStruct = SourceFunctions[FunctionNumber][Function];
       SourceFunctions[FunctionNumber][Function] = NULL;
+      NumberOfObjects = &SourceFunctionsCount[FunctionNumber][Function];
     }
     break;
     case DESTINATION_FUNCTIONS:
     {   //Destination
       WalkAxumFunctionInformationStruct = DestinationFunctions[FunctionNumber][Function];
       DestinationFunctions[FunctionNumber][Function] = NULL;
+      NumberOfObjects = &DestinationFunctionsCount[FunctionNumber][Function];
     }
     break;
   }
@@ -12467,6 +12644,10 @@ void MakeObjectListPerFunction(unsigned int SensorReceiveFunctionNumber)
     WalkAxumFunctionInformationStruct = (AXUM_FUNCTION_INFORMATION_STRUCT *)WalkAxumFunctionInformationStruct->Next;
     delete AxumFunctionInformationStructToDelete;
   }
+  if (NumberOfObjects != NULL)
+  {
+    *NumberOfObjects = 0;
+  }
 
   ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement = OnlineNodeInformationList;
   while (OnlineNodeInformationElement != NULL)
@@ -12532,6 +12713,10 @@ void MakeObjectListPerFunction(unsigned int SensorReceiveFunctionNumber)
                 break;
               }
               WalkAxumFunctionInformationStruct = AxumFunctionInformationStructToAdd;
+              if (NumberOfObjects != NULL)
+              {
+                (*NumberOfObjects)++;
+              }
             }
           }
         }
@@ -12704,6 +12889,14 @@ void DeleteAllObjectListPerFunction()
       }
     }
   }
+
+  memset(SourceFunctionsCount, 0, sizeof(SourceFunctionsCount));
+  memset(ModuleFunctionsCount, 0, sizeof(ModuleFunctionsCount));
+  memset(BussFunctionsCount, 0, sizeof(BussFunctionsCount));
+  memset(MonitorBussFunctionsCount, 0, sizeof(MonitorBussFunctionsCount));
+  memset(DestinationFunctionsCount, 0, sizeof(DestinationFunctionsCount));
+  memset(GlobalFunctionsCount, 0, sizeof(GlobalFunctionsCount));
+  memset(ConsoleFunctionsCount, 0, sizeof(ConsoleFunctionsCount));
 }
 
 void ModeControllerSensorChange(unsigned int SensorReceiveFunctionNr, unsigned char type, mbn_data data, unsigned char DataType, unsigned char DataSize, float DataMinimal, float DataMaximal)
@@ -12801,7 +12994,7 @@ void ModeControllerSensorChange(unsigned int SensorReceiveFunctionNr, unsigned c
 
               for (int cntModule=0; cntModule<128; cntModule++)
               {
-                if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+                if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
                 {
                   unsigned int FunctionNrToSent = (cntModule<<12);
                   CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_GAIN_LEVEL);
@@ -13274,6 +13467,7 @@ void ModeControllerSensorChange(unsigned int SensorReceiveFunctionNr, unsigned c
             DoAxum_ModuleStatusChanged(ModuleNr, 0);
           }
         }
+        InvalidateModulePresetActive(ModuleNr);
         for (cntPreset=0; cntPreset<8; cntPreset++)
         {
           if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -13471,7 +13665,7 @@ void ModeControllerResetSensorChange(unsigned int SensorReceiveFunctionNr, unsig
 
                 for (int cntModule=0; cntModule<128; cntModule++)
                 {
-                  if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+1))
+                  if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+1))
                   {
                     DoAxum_UpdateModuleControlMode(cntModule, ControlMode);
                     FunctionNrToSent = (cntModule<<12);
@@ -13815,7 +14009,7 @@ void ModeControllerResetSensorChange(unsigned int SensorReceiveFunctionNr, unsig
 
               for (int cntModule=0; cntModule<128; cntModule++)
               {
-                if (AxumData.ModuleData[cntModule].SelectedSource == AxumData.ModuleData[ModuleNr].SelectedSource)
+                if (ModuleHotState.SelectedSource[cntModule] == AxumData.ModuleData[ModuleNr].SelectedSource)
                 {
                   unsigned int FunctionNrToSent = (cntModule<<12);
                   CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_PHANTOM);
@@ -13843,7 +14037,7 @@ void ModeControllerResetSensorChange(unsigned int SensorReceiveFunctionNr, unsig
 
               for (int cntModule=0; cntModule<128; cntModule++)
               {
-                if (AxumData.ModuleData[cntModule].SelectedSource == AxumData.ModuleData[ModuleNr].SelectedSource)
+                if (ModuleHotState.SelectedSource[cntModule] == AxumData.ModuleData[ModuleNr].SelectedSource)
                 {
                   FunctionNrToSent = (cntModule<<12);
                   CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_SOURCE_PAD);
@@ -14836,429 +15030,765 @@ void DoAxum_BussReset(int BussNr)
   }
 }
 
-int SourceActive(int InputSourceNr)
+//Reads the hot state mirror, UpdateModuleSourceActivity() refreshes the
+//module in ModuleHotState before calling this.
+unsigned char ModuleSourceActive(int ModuleNr)
 {
-  unsigned int cntModule;
   unsigned int cntBuss;
   unsigned char Active = 0;
+  unsigned char ModuleLevelActive = ModuleBit(ModuleHotState.FaderOpen, ModuleNr);
+  unsigned char ModuleOnActive = ModuleBit(ModuleHotState.On, ModuleNr);
 
-  for (cntModule=0; cntModule<128; cntModule++)
+  for (cntBuss=0; cntBuss<16; cntBuss++)
   {
-    if (AxumData.ModuleData[cntModule].SelectedSource == (InputSourceNr+matrix_sources.src_offset.min.source))
+    unsigned char LevelActive = 0;
+    unsigned char OnActive = 0;
+
+    if (ModuleHotState.BussLevel[cntBuss][ModuleNr]>-80)
+    {
+      LevelActive = ModuleLevelActive | AxumData.ModuleData[ModuleNr].Buss[cntBuss].PreModuleLevel;
+    }
+    if (ModuleBit(ModuleHotState.BussOn[cntBuss], ModuleNr))
     {
-      unsigned char ModuleLevelActive = 0;
-      unsigned char ModuleOnActive = 0;
+      OnActive = ModuleOnActive | AxumData.BussMasterData[cntBuss].PreModuleOn;
+    }
 
-      if (AxumData.ModuleData[cntModule].FaderLevel>-80)
-      {   //fader open
-        ModuleLevelActive = 1;
-      }
-      if (AxumData.ModuleData[cntModule].On)
-      { //module on
-        ModuleOnActive = 1;
-      }
-      for (cntBuss=0; cntBuss<16; cntBuss++)
-      {
-        unsigned char BussPreModuleLevelActive = 0;
-        unsigned char BussPreModuleOnActive = 0;
-        unsigned char BussLevelActive = 0;
-        unsigned char BussOnActive = 0;
-        unsigned char LevelActive = 0;
-        unsigned char OnActive = 0;
+    Active |= (OnActive && LevelActive);
+  }
 
-        if (AxumData.ModuleData[cntModule].Buss[cntBuss].PreModuleLevel)
-        {
-          BussPreModuleLevelActive = 1;
-        }
-        if (AxumData.BussMasterData[cntBuss].PreModuleOn)
-        {
-          BussPreModuleOnActive = 1;
-        }
-        if (AxumData.ModuleData[cntModule].Buss[cntBuss].Level>-80)
-        {
-          BussLevelActive = 1;
-        }
-        if (AxumData.ModuleData[cntModule].Buss[cntBuss].On)
-        {
-          BussOnActive = 1;
-        }
+  return Active;
+}
 
-        if (BussLevelActive)
-        {
-          LevelActive |= ModuleLevelActive;
-          if (BussPreModuleLevelActive)
-          {
-            LevelActive = 1;
-          }
-        }
+int SourceActive(int InputSourceNr)
+{
+  return (SourceActiveCount[InputSourceNr] != 0);
+}
 
-        if (BussOnActive)
-        {
-          OnActive |= ModuleOnActive;
-          if (BussPreModuleOnActive)
-          {
-            OnActive = 1;
-          }
-        }
+void SetSourceActivity(int SourceNr, unsigned char Active)
+{
+  int Delta = Active ? 1 : -1;
 
-        Active |= (OnActive && LevelActive);
-      }
+  AxumData.SourceData[SourceNr].Active = Active;
+  for (int cntRedlight=0; cntRedlight<8; cntRedlight++)
+  {
+    if (AxumData.SourceData[SourceNr].Redlight[cntRedlight])
+    {
+      RedlightActiveCount[cntRedlight] += Delta;
+    }
+  }
+  for (int cntMonitorBuss=0; cntMonitorBuss<16; cntMonitorBuss++)
+  {
+    if (AxumData.SourceData[SourceNr].MonitorMute[cntMonitorBuss])
+    {
+      MonitorMuteActiveCount[cntMonitorBuss] += Delta;
     }
   }
-
-  return Active;
 }
 
-void DoAxum_ModuleStatusChanged(int ModuleNr, int ByModule)
+//Recounts the source this module is on-air for, returns 1 if a source
+//became active or inactive.
+int UpdateModuleSourceActivity(int ModuleNr)
 {
-  unsigned char Redlight[8] = {0,0,0,0,0,0,0,0};
-  unsigned char MonitorMute[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+  int OldSource = ModuleActiveSource[ModuleNr];
+  int NewSource = -1;
+  int Changed = 0;
+
+  UpdateModuleHotState(ModuleNr);
 
   if ((AxumData.ModuleData[ModuleNr].SelectedSource>=matrix_sources.src_offset.min.source) && (AxumData.ModuleData[ModuleNr].SelectedSource<=matrix_sources.src_offset.max.source))
   {
-    int SourceNr = AxumData.ModuleData[ModuleNr].SelectedSource-matrix_sources.src_offset.min.source;
-    unsigned int CurrentSourceActive = AxumData.SourceData[SourceNr].Active;
-    unsigned int NewSourceActive = 0;
-
-    NewSourceActive = SourceActive(SourceNr);
-
-    if (CurrentSourceActive != NewSourceActive)
+    if (ModuleSourceActive(ModuleNr))
     {
-      AxumData.SourceData[SourceNr].Active = NewSourceActive;
-
-      //Check current state or redlights/mutes
-      for (int cntModule=0; cntModule<128; cntModule++)
-      {
-        if (AxumData.ModuleData[cntModule].SelectedSource != 0)
-        {
-          if ((AxumData.ModuleData[cntModule].SelectedSource>=matrix_sources.src_offset.min.source) && (AxumData.ModuleData[cntModule].SelectedSource<=matrix_sources.src_offset.max.source))
-          {
-            int SourceToCheck = AxumData.ModuleData[cntModule].SelectedSource-matrix_sources.src_offset.min.source;
-            if (AxumData.SourceData[SourceToCheck].Active)
-            {
-              for (int cntRedlight=0; cntRedlight<8; cntRedlight++)
-              {
-                if (AxumData.SourceData[SourceToCheck].Redlight[cntRedlight])
-                {
-                  Redlight[cntRedlight] = 1;
-                }
-              }
-              for (int cntMonitorBuss=0; cntMonitorBuss<16; cntMonitorBuss++)
-              {
-                if (AxumData.SourceData[SourceToCheck].MonitorMute[cntMonitorBuss])
-                {
-                  MonitorMute[cntMonitorBuss] = 1;
-                }
-              }
-            }
-          }
-        }
-      }
-
-      //redlights
-      for (int cntRedlight=0; cntRedlight<8; cntRedlight++)
-      {
-        if (Redlight[cntRedlight] != AxumData.Redlight[cntRedlight])
-        {
-          AxumData.Redlight[cntRedlight] = Redlight[cntRedlight];
-
-          unsigned int FunctionNrToSent = 0x04000000 | (GLOBAL_FUNCTION_REDLIGHT_1+(cntRedlight*(GLOBAL_FUNCTION_REDLIGHT_2-GLOBAL_FUNCTION_REDLIGHT_1)));
-          CheckObjectsToSent(FunctionNrToSent);
-        }
-      }
-
-      //mutes
-      for (int cntMonitorBuss=0; cntMonitorBuss<16; cntMonitorBuss++)
-      {
-        if (MonitorMute[cntMonitorBuss] != AxumData.Monitor[cntMonitorBuss].Mute)
-        {
-          AxumData.Monitor[cntMonitorBuss].Mute = MonitorMute[cntMonitorBuss];
-          unsigned int FunctionNrToSent = 0x02000000 | (cntMonitorBuss<<12);
-
-          CheckObjectsToSent(FunctionNrToSent | MONITOR_BUSS_FUNCTION_MUTE);
-          for (int cntDestination=0; cntDestination<1280; cntDestination++)
-          {
-            if (AxumData.DestinationData[cntDestination].Source == (17+cntMonitorBuss))
-            {
-              FunctionNrToSent = 0x06000000 | (cntDestination<<12);
-              CheckObjectsToSent(FunctionNrToSent | DESTINATION_FUNCTION_MUTE_AND_MONITOR_MUTE);
-            }
-          }
-        }
-      }
-    }
-  }
-
-  char ModuleActive = 0;
-  if (AxumData.ModuleData[ModuleNr].On == 1)
-  { //module turned on
-    if (AxumData.ModuleData[ModuleNr].FaderLevel>-80)
-    {   //fader open
-      ModuleActive = 1;
+      NewSource = AxumData.ModuleData[ModuleNr].SelectedSource-matrix_sources.src_offset.min.source;
     }
   }
 
-  if (ByModule)
+  if (NewSource != OldSource)
   {
-    if (ModuleActive)
+    ModuleActiveSource[ModuleNr] = NewSource;
+    if (OldSource != -1)
     {
-      //Module active, check global buss reset
-      for (int cntBuss=0; cntBuss<16; cntBuss++)
+      if (--SourceActiveCount[OldSource] == 0)
       {
-        if (AxumData.ModuleData[ModuleNr].Buss[cntBuss].Assigned)
-        {
-          if (AxumData.BussMasterData[cntBuss].GlobalBussReset)
-          {
-            DoAxum_BussReset(cntBuss);
-          }
-        }
+        SetSourceActivity(OldSource, 0);
+        Changed = 1;
+      }
+    }
+    if (NewSource != -1)
+    {
+      if (SourceActiveCount[NewSource]++ == 0)
+      {
+        SetSourceActivity(NewSource, 1);
+        Changed = 1;
       }
     }
   }
+  return Changed;
+}
 
-  if (!ModuleActive)
+//Sends the redlights and monitor mutes that differ from the counts
+void SetAxum_SourceActivityOutputs()
+{
+  //redlights
+  for (int cntRedlight=0; cntRedlight<8; cntRedlight++)
   {
-    if (AxumData.ModuleData[ModuleNr].WaitingSource != 0)
-    {
-      int SourceNr = AxumData.ModuleData[ModuleNr].WaitingSource;
-      DoAxum_SetNewSource(ModuleNr, SourceNr, 0);
-      AxumData.ModuleData[ModuleNr].WaitingSource = 0;
-    }
-    if (AxumData.ModuleData[ModuleNr].WaitingProcessingPreset != 0)
+    unsigned char Redlight = (RedlightActiveCount[cntRedlight] != 0);
+    if (Redlight != AxumData.Redlight[cntRedlight])
     {
-      int PresetNr = AxumData.ModuleData[ModuleNr].WaitingProcessingPreset;
+      AxumData.Redlight[cntRedlight] = Redlight;
 
-      DoAxum_LoadProcessingPreset(ModuleNr, PresetNr, 0, 0, 0);
-      AxumData.ModuleData[ModuleNr].WaitingProcessingPreset = 0;
-    }
-    if (AxumData.ModuleData[ModuleNr].WaitingRoutingPreset != 0)
-    {
-      int PresetNr = AxumData.ModuleData[ModuleNr].WaitingRoutingPreset;
-      DoAxum_LoadRoutingPreset(ModuleNr, PresetNr, 0, 0, 0);
-      AxumData.ModuleData[ModuleNr].WaitingRoutingPreset = 0;
+      unsigned int FunctionNrToSent = 0x04000000 | (GLOBAL_FUNCTION_REDLIGHT_1+(cntRedlight*(GLOBAL_FUNCTION_REDLIGHT_2-GLOBAL_FUNCTION_REDLIGHT_1)));
+      CheckObjectsToSent(FunctionNrToSent);
     }
   }
-}
 
-int MixMinusSourceUsed(int CurrentSource)
-{
-  int ModuleNr = -1;
-  int cntModule = 0;
-  while ((cntModule<128) && (ModuleNr == -1))
+  //mutes
+  for (int cntMonitorBuss=0; cntMonitorBuss<16; cntMonitorBuss++)
   {
-    if (cntModule != ModuleNr)
+    unsigned char MonitorMute = (MonitorMuteActiveCount[cntMonitorBuss] != 0);
+    if (MonitorMute != AxumData.Monitor[cntMonitorBuss].Mute)
     {
-      if (AxumData.ModuleData[cntModule].SelectedSource == (CurrentSource+matrix_sources.src_offset.min.source))
+      AxumData.Monitor[cntMonitorBuss].Mute = MonitorMute;
+      unsigned int FunctionNrToSent = 0x02000000 | (cntMonitorBuss<<12);
+
+      CheckObjectsToSent(FunctionNrToSent | MONITOR_BUSS_FUNCTION_MUTE);
+      for (int cntDestination=0; cntDestination<1280; cntDestination++)
       {
-        int cntDestination = 0;
-        while ((cntDestination<1280) && (ModuleNr == -1))
+        if (AxumData.DestinationData[cntDestination].Source == (17+cntMonitorBuss))
         {
-          if (AxumData.DestinationData[cntDestination].MixMinusSource == (CurrentSource+matrix_sources.src_offset.min.source))
-          {
-            ModuleNr = cntModule;
-          }
-          cntDestination++;
+          FunctionNrToSent = 0x06000000 | (cntDestination<<12);
+          CheckObjectsToSent(FunctionNrToSent | DESTINATION_FUNCTION_MUTE_AND_MONITOR_MUTE);
         }
       }
     }
-    cntModule++;
   }
-  return ModuleNr;
 }
 
-void GetSourceLabel(int SourceNr, char *TextString, int MaxLength)
+void ClearSourceActivity()
 {
-  if (SourceNr == -1)
-  {
-    strncpy(TextString, "Mute", MaxLength);
-  }
-  if (SourceNr == 0)
+  for (int cntModule=0; cntModule<128; cntModule++)
   {
-    strncpy(TextString, "None", MaxLength);
+    ModuleActiveSource[cntModule] = -1;
   }
-  else if ((SourceNr >= matrix_sources.src_offset.min.buss) && (SourceNr <= matrix_sources.src_offset.max.buss))
+  for (int cntSource=0; cntSource<1280; cntSource++)
   {
-    int BussNr = SourceNr-matrix_sources.src_offset.min.buss;
-    strncpy(TextString, AxumData.BussMasterData[BussNr].Label, MaxLength);
+    SourceActiveCount[cntSource] = 0;
+    AxumData.SourceData[cntSource].Active = 0;
   }
-  else if ((SourceNr >= matrix_sources.src_offset.min.insert_out) && (SourceNr <= matrix_sources.src_offset.max.insert_out))
-  {
-    int ModuleNr = SourceNr-matrix_sources.src_offset.min.insert_out;
-    char InsertText[32];
-
-    //eventual depending on MaxLength
-    sprintf(InsertText, "Ins. %3d", ModuleNr+1);
+  memset(RedlightActiveCount, 0, sizeof(RedlightActiveCount));
+  memset(MonitorMuteActiveCount, 0, sizeof(MonitorMuteActiveCount));
+}
 
-    strncpy(TextString, InsertText, MaxLength);
-  }
-  else if ((SourceNr >= matrix_sources.src_offset.min.monitor_buss) && (SourceNr <= matrix_sources.src_offset.max.monitor_buss))
+void SetModuleBit(unsigned int *Mask, int ModuleNr, unsigned char State)
+{
+  if (State)
   {
-    int BussNr = SourceNr-matrix_sources.src_offset.min.monitor_buss;
-    strncpy(TextString, AxumData.Monitor[BussNr].Label, MaxLength);
+    Mask[ModuleNr>>5] |= (1u<<(ModuleNr&0x1F));
   }
-  else if ((SourceNr >= matrix_sources.src_offset.min.mixminus) && (SourceNr <= matrix_sources.src_offset.max.mixminus))
+  else
   {
-    int ModuleNr = SourceNr-matrix_sources.src_offset.min.mixminus;
-    char MixMinusText[32];
+    Mask[ModuleNr>>5] &= ~(1u<<(ModuleNr&0x1F));
+  }
+}
 
-    //eventual depending on MaxLength
-    sprintf(MixMinusText, "N-1 %3d", ModuleNr+1);
+unsigned char ModuleBit(const unsigned int *Mask, int ModuleNr)
+{
+  return (Mask[ModuleNr>>5]>>(ModuleNr&0x1F))&0x01;
+}
 
-    strncpy(TextString, MixMinusText, MaxLength);
-  }
-  else if ((SourceNr >= matrix_sources.src_offset.min.source) && (SourceNr <= matrix_sources.src_offset.max.source))
+//Copies the hot fields of a module to ModuleHotState, called by the setters
+//(source, buss levels, module status) after they changed AxumData.
+void UpdateModuleHotState(int ModuleNr)
+{
+  AXUM_MODULE_DATA_STRUCT *ModuleData = &AxumData.ModuleData[ModuleNr];
+  unsigned char BussRouted = 0;
+
+  SetModuleBit(ModuleHotState.On, ModuleNr, ModuleData->On);
+  SetModuleBit(ModuleHotState.FaderOpen, ModuleNr, (ModuleData->FaderLevel>-80));
+  SetModuleBit(ModuleHotState.Signal, ModuleNr, ModuleData->Signal);
+  SetModuleBit(ModuleHotState.Peak, ModuleNr, ModuleData->Peak);
+  ModuleHotState.SelectedSource[ModuleNr] = ModuleData->SelectedSource;
+  ModuleHotState.FaderLevel[ModuleNr] = ModuleData->FaderLevel;
+  for (int cntBuss=0; cntBuss<16; cntBuss++)
   {
-    int LabelSourceNr = SourceNr-matrix_sources.src_offset.min.source;
-    strncpy(TextString, AxumData.SourceData[LabelSourceNr].SourceName, MaxLength);
+    SetModuleBit(ModuleHotState.BussOn[cntBuss], ModuleNr, ModuleData->Buss[cntBuss].On);
+    ModuleHotState.BussLevel[cntBuss][ModuleNr] = ModuleData->Buss[cntBuss].Level;
+    if ((ModuleData->Buss[cntBuss].Assigned) && (ModuleData->Buss[cntBuss].On))
+    {
+      BussRouted = 1;
+    }
   }
+  SetModuleBit(ModuleHotState.BussRouted, ModuleNr, BussRouted);
 }
 
-int AdjustModuleSource(int CurrentSource, int Offset, unsigned char Pool)
+void RebuildModuleHotState()
 {
-  char check_for_next_pos;
-  int cntPos;
-  int StartPos;
-  int CurrentPos;
-  int PosBefore;
-  int PosAfter;
+  for (int cntModule=0; cntModule<128; cntModule++)
+  {
+    UpdateModuleHotState(cntModule);
+  }
+}
 
-  //Determin the current position
-  CurrentPos = -1;
-  PosBefore = -1;
-  PosAfter = MAX_POS_LIST_SIZE;
-  for (cntPos=0; cntPos<MAX_POS_LIST_SIZE; cntPos++)
+//Meters of a module are only sent if objects are attached to the module
+//itself or to the console select functions of a console that selected it.
+void ModuleMeterObjectsMask(unsigned int *Mask)
+{
+  memset(Mask, 0, 4*sizeof(unsigned int));
+  for (int cntModule=0; cntModule<128; cntModule++)
   {
-    if (matrix_sources.pos[cntPos].src != INT_MIN)
+    if ((ModuleFunctionsCount[cntModule][MODULE_FUNCTION_AUDIO_LEVEL_LEFT]) ||
+        (ModuleFunctionsCount[cntModule][MODULE_FUNCTION_AUDIO_LEVEL_RIGHT]))
+    {
+      Mask[cntModule>>5] |= 1<<(cntModule&0x1F);
+    }
+  }
+  for (int cntConsole=0; cntConsole<4; cntConsole++)
+  {
+    unsigned int ModuleNr = AxumData.ConsoleData[cntConsole].SelectedModule;
+    if ((ModuleNr<128) &&
+        ((ModuleFunctionsCount[NUMBER_OF_MODULES+cntConsole][MODULE_FUNCTION_AUDIO_LEVEL_LEFT]) ||
+         (ModuleFunctionsCount[NUMBER_OF_MODULES+cntConsole][MODULE_FUNCTION_AUDIO_LEVEL_RIGHT])))
+    {
+      Mask[ModuleNr>>5] |= 1<<(ModuleNr&0x1F);
+    }
+  }
+}
+
+//Signal/peak detection in two passes. The threshold pass runs over the level
+//array only and builds the new signal/peak masks, after that only modules
+//with a changed bit or attached meter objects are visited. Hold times are in
+//ms, cntMillisecondTimer counts 10ms ticks.
+void DetectModuleSignalAndPeak(float *Level)
+{
+  unsigned int Signal[4] = {0, 0, 0, 0};
+  unsigned int Peak[4] = {0, 0, 0, 0};
+  unsigned int Visit[4];
+  float SignalOnLevel = SIGNAL_DETECT_LEVEL-AxumData.Headroom;
+  float SignalOffLevel = SignalOnLevel-SignalDetectHysteresis;
+  float PeakOnLevel = PEAK_DETECT_LEVEL;
+  float PeakOffLevel = PeakOnLevel-PeakDetectHysteresis;
+
+  for (int cntModule=0; cntModule<128; cntModule++)
+  {
+    int Word = cntModule>>5;
+    unsigned int Bit = 1<<(cntModule&0x1F);
+    float ModuleLevel = Level[cntModule<<1];
+    if (Level[(cntModule<<1)+1] > ModuleLevel)
+    {
+      ModuleLevel = Level[(cntModule<<1)+1];
+    }
+
+    if ((ModuleLevel>SignalOnLevel) ||
+        ((ModuleHotState.Signal[Word]&Bit) && (ModuleLevel>SignalOffLevel)))
+    {
+      ModuleSignalTime[cntModule] = cntMillisecondTimer;
+    }
+    if ((ModuleLevel>PeakOnLevel) ||
+        ((ModuleHotState.Peak[Word]&Bit) && (ModuleLevel>PeakOffLevel)))
+    {
+      ModulePeakTime[cntModule] = cntMillisecondTimer;
+    }
+
+    if ((ModuleLevel>SignalOnLevel) ||
+        ((ModuleHotState.Signal[Word]&Bit) && (((cntMillisecondTimer-ModuleSignalTime[cntModule])*10)<SignalDetectHoldTime)))
+    {
+      Signal[Word] |= Bit;
+    }
+    if ((ModuleLevel>PeakOnLevel) ||
+        ((ModuleHotState.Peak[Word]&Bit) && (((cntMillisecondTimer-ModulePeakTime[cntModule])*10)<PeakDetectHoldTime)))
+    {
+      Peak[Word] |= Bit;
+    }
+  }
+
+  ModuleMeterObjectsMask(Visit);
+  for (int cntWord=0; cntWord<4; cntWord++)
+  {
+    Peak[cntWord] &= Signal[cntWord];
+    Visit[cntWord] |= (Signal[cntWord]^ModuleHotState.Signal[cntWord]) | (Peak[cntWord]^ModuleHotState.Peak[cntWord]);
+  }
+
+  for (int cntWord=0; cntWord<4; cntWord++)
+  {
+    while (Visit[cntWord])
     {
-      if (matrix_sources.pos[cntPos].src == CurrentSource)
+      int cntModule = (cntWord<<5) | __builtin_ctz(Visit[cntWord]);
+      unsigned char ModuleSignal = (Signal[cntWord]>>(cntModule&0x1F))&1;
+      unsigned char ModulePeak = (Peak[cntWord]>>(cntModule&0x1F))&1;
+      Visit[cntWord] &= Visit[cntWord]-1;
+
+      CheckObjectsToSent((cntModule<<12) | MODULE_FUNCTION_AUDIO_LEVEL_LEFT);
+      CheckObjectsToSent((cntModule<<12) | MODULE_FUNCTION_AUDIO_LEVEL_RIGHT);
+
+      if (ModuleSignal != ModuleBit(ModuleHotState.Signal, cntModule))
       {
-        CurrentPos = cntPos;
+        AxumData.ModuleData[cntModule].Signal = ModuleSignal;
+        SetModuleBit(ModuleHotState.Signal, cntModule, ModuleSignal);
+        CheckObjectsToSent((cntModule<<12) | MODULE_FUNCTION_SIGNAL);
       }
-      else if (matrix_sources.pos[cntPos].src < CurrentSource)
+      if (ModulePeak != ModuleBit(ModuleHotState.Peak, cntModule))
       {
-        if (cntPos>PosBefore)
-        {
-          PosBefore = cntPos;
-        }
+        AxumData.ModuleData[cntModule].Peak = ModulePeak;
+        SetModuleBit(ModuleHotState.Peak, cntModule, ModulePeak);
+        CheckObjectsToSent((cntModule<<12) | MODULE_FUNCTION_PEAK);
       }
-      else if (matrix_sources.pos[cntPos].src > CurrentSource)
+    }
+  }
+}
+
+//Full recount, for changes that affect many modules or the source settings
+void RebuildSourceActivity()
+{
+  ClearSourceActivity();
+  for (int cntModule=0; cntModule<128; cntModule++)
+  {
+    UpdateModuleSourceActivity(cntModule);
+  }
+  SetAxum_SourceActivityOutputs();
+}
+
+void DoAxum_ModuleStatusChanged(int ModuleNr, int ByModule)
+{
+  if (UpdateModuleSourceActivity(ModuleNr))
+  {
+    SetAxum_SourceActivityOutputs();
+  }
+
+  char ModuleActive = 0;
+  if (AxumData.ModuleData[ModuleNr].On == 1)
+  { //module turned on
+    if (AxumData.ModuleData[ModuleNr].FaderLevel>-80)
+    {   //fader open
+      ModuleActive = 1;
+    }
+  }
+
+  if (ByModule)
+  {
+    if (ModuleActive)
+    {
+      //Module active, check global buss reset
+      for (int cntBuss=0; cntBuss<16; cntBuss++)
       {
-        if (cntPos<PosAfter)
+        if (AxumData.ModuleData[ModuleNr].Buss[cntBuss].Assigned)
         {
-          PosAfter = cntPos;
+          if (AxumData.BussMasterData[cntBuss].GlobalBussReset)
+          {
+            DoAxum_BussReset(cntBuss);
+          }
         }
       }
     }
   }
 
-  //If current position not found...
-  if (CurrentPos == -1)
+  if (!ModuleActive)
   {
-    if (Offset<0)
+    if (AxumData.ModuleData[ModuleNr].WaitingSource != 0)
     {
-      CurrentPos = PosBefore;
+      int SourceNr = AxumData.ModuleData[ModuleNr].WaitingSource;
+      DoAxum_SetNewSource(ModuleNr, SourceNr, 0);
+      AxumData.ModuleData[ModuleNr].WaitingSource = 0;
     }
-    else
+    if (AxumData.ModuleData[ModuleNr].WaitingProcessingPreset != 0)
     {
-      CurrentPos = PosAfter;
+      int PresetNr = AxumData.ModuleData[ModuleNr].WaitingProcessingPreset;
+
+      DoAxum_LoadProcessingPreset(ModuleNr, PresetNr, 0, 0, 0);
+      AxumData.ModuleData[ModuleNr].WaitingProcessingPreset = 0;
+    }
+    if (AxumData.ModuleData[ModuleNr].WaitingRoutingPreset != 0)
+    {
+      int PresetNr = AxumData.ModuleData[ModuleNr].WaitingRoutingPreset;
+      DoAxum_LoadRoutingPreset(ModuleNr, PresetNr, 0, 0, 0);
+      AxumData.ModuleData[ModuleNr].WaitingRoutingPreset = 0;
     }
   }
+}
 
-  if (CurrentPos != -1)
+//Returns the source index of a source number, -1 if it is not an input source
+int SourceIndex(int SourceNr)
+{
+  if ((SourceNr>=matrix_sources.src_offset.min.source) && (SourceNr<=matrix_sources.src_offset.max.source))
   {
-    while (Offset != 0)
+    int Index = SourceNr-matrix_sources.src_offset.min.source;
+    if (Index<1280)
     {
-      StartPos = CurrentPos;
-      if (Offset>0)
-      {
-        check_for_next_pos = 1;
-        while (check_for_next_pos)
-        {
-          check_for_next_pos = 0;
+      return Index;
+    }
+  }
+  return -1;
+}
 
-          CurrentPos++;
-          if (CurrentPos>=MAX_POS_LIST_SIZE)
-          {
-            CurrentPos = 0;
-          }
+void IndexModuleSource(unsigned int ModuleNr)
+{
+  int OldIndex = ModuleIndexedSource[ModuleNr];
+  int NewIndex = SourceIndex(AxumData.ModuleData[ModuleNr].SelectedSource);
 
-          CurrentSource = matrix_sources.pos[CurrentPos].src;
+  if (OldIndex != NewIndex)
+  {
+    if (OldIndex != -1)
+    {
+      SourceModuleMask[OldIndex][ModuleNr>>5] &= ~(1U<<(ModuleNr&0x1F));
+    }
+    if (NewIndex != -1)
+    {
+      SourceModuleMask[NewIndex][ModuleNr>>5] |= (1U<<(ModuleNr&0x1F));
+    }
+    ModuleIndexedSource[ModuleNr] = NewIndex;
+  }
+}
 
-          //check if hybrid is used
-          if (CurrentSource > 0)
-          {
-            if (MixMinusSourceUsed(CurrentSource) != -1)
-            {
-              check_for_next_pos = 1;
-            }
-          }
+void IndexDestinationMixMinus(unsigned int DestinationNr)
+{
+  int OldIndex = DestinationIndexedMixMinus[DestinationNr];
+  int NewIndex = SourceIndex(AxumData.DestinationData[DestinationNr].MixMinusSource);
 
-          //not active, go further.
-          if (!matrix_sources.pos[CurrentPos].active)
-          {
-            check_for_next_pos = 1;
-          }
+  if (OldIndex != NewIndex)
+  {
+    if (OldIndex != -1)
+    {
+      MixMinusDestinationCount[OldIndex]--;
+    }
+    if (NewIndex != -1)
+    {
+      MixMinusDestinationCount[NewIndex]++;
+    }
+    DestinationIndexedMixMinus[DestinationNr] = NewIndex;
+  }
+}
 
-          if (Pool<8)
-          {
-            if (!matrix_sources.pos[CurrentPos].pool[Pool])
-            {
-              check_for_next_pos = 1;
-            }
-          }
+//Also used after the source offsets changed, the index is relative to them
+void RebuildSourceUsageIndex()
+{
+  memset(SourceModuleMask, 0, sizeof(SourceModuleMask));
+  memset(MixMinusDestinationCount, 0, sizeof(MixMinusDestinationCount));
+  for (int cntModule=0; cntModule<128; cntModule++)
+  {
+    ModuleIndexedSource[cntModule] = -1;
+    IndexModuleSource(cntModule);
+  }
+  for (int cntDestination=0; cntDestination<1280; cntDestination++)
+  {
+    DestinationIndexedMixMinus[cntDestination] = -1;
+    IndexDestinationMixMinus(cntDestination);
+  }
+}
 
-          if (CurrentPos == StartPos)
-          { //Looped through all sources, no step found...
-            check_for_next_pos = 0;
-          }
-        }
-        Offset--;
-      }
-      else
+//Returns the first module on CurrentSource if any destination uses it as
+//mix-minus source, otherwise -1
+int MixMinusSourceUsed(int CurrentSource)
+{
+  if ((CurrentSource<0) || (CurrentSource>=1280))
+  {
+    return -1;
+  }
+  if (MixMinusDestinationCount[CurrentSource] == 0)
+  {
+    return -1;
+  }
+  for (int cntWord=0; cntWord<4; cntWord++)
+  {
+    if (SourceModuleMask[CurrentSource][cntWord])
+    {
+      return (cntWord<<5)+__builtin_ctz(SourceModuleMask[CurrentSource][cntWord]);
+    }
+  }
+  return -1;
+}
+
+//Returns the first module from ModuleNr on that has the input source (index)
+//selected, -1 if there is none. Walks SourceModuleMask instead of all modules.
+int NextSourceModule(int SourceNr, int ModuleNr)
+{
+  if ((SourceNr<0) || (SourceNr>=1280) || (ModuleNr<0))
+  {
+    return -1;
+  }
+  for (int cntWord=ModuleNr>>5; cntWord<4; cntWord++)
+  {
+    unsigned int Modules = SourceModuleMask[SourceNr][cntWord];
+    if (cntWord == (ModuleNr>>5))
+    {
+      Modules &= ~((1U<<(ModuleNr&0x1F))-1);
+    }
+    if (Modules)
+    {
+      return (cntWord<<5)+__builtin_ctz(Modules);
+    }
+  }
+  return -1;
+}
+
+void GetSourceLabel(int SourceNr, char *TextString, int MaxLength)
+{
+  if (SourceNr == -1)
+  {
+    strncpy(TextString, "Mute", MaxLength);
+  }
+  if (SourceNr == 0)
+  {
+    strncpy(TextString, "None", MaxLength);
+  }
+  else if ((SourceNr >= matrix_sources.src_offset.min.buss) && (SourceNr <= matrix_sources.src_offset.max.buss))
+  {
+    int BussNr = SourceNr-matrix_sources.src_offset.min.buss;
+    strncpy(TextString, AxumData.BussMasterData[BussNr].Label, MaxLength);
+  }
+  else if ((SourceNr >= matrix_sources.src_offset.min.insert_out) && (SourceNr <= matrix_sources.src_offset.max.insert_out))
+  {
+    int ModuleNr = SourceNr-matrix_sources.src_offset.min.insert_out;
+    char InsertText[32];
+
+    //eventual depending on MaxLength
+    sprintf(InsertText, "Ins. %3d", ModuleNr+1);
+
+    strncpy(TextString, InsertText, MaxLength);
+  }
+  else if ((SourceNr >= matrix_sources.src_offset.min.monitor_buss) && (SourceNr <= matrix_sources.src_offset.max.monitor_buss))
+  {
+    int BussNr = SourceNr-matrix_sources.src_offset.min.monitor_buss;
+    strncpy(TextString, AxumData.Monitor[BussNr].Label, MaxLength);
+  }
+  else if ((SourceNr >= matrix_sources.src_offset.min.mixminus) && (SourceNr <= matrix_sources.src_offset.max.mixminus))
+  {
+    int ModuleNr = SourceNr-matrix_sources.src_offset.min.mixminus;
+    char MixMinusText[32];
+
+    //eventual depending on MaxLength
+    sprintf(MixMinusText, "N-1 %3d", ModuleNr+1);
+
+    strncpy(TextString, MixMinusText, MaxLength);
+  }
+  else if ((SourceNr >= matrix_sources.src_offset.min.source) && (SourceNr <= matrix_sources.src_offset.max.source))
+  {
+    int LabelSourceNr = SourceNr-matrix_sources.src_offset.min.source;
+    strncpy(TextString, AxumData.SourceData[LabelSourceNr].SourceName, MaxLength);
+  }
+}
+
+int ComparePosIndexEntry(const void *a, const void *b)
+{
+  const pos_index_entry_struct *EntryA = (const pos_index_entry_struct *)a;
+  const pos_index_entry_struct *EntryB = (const pos_index_entry_struct *)b;
+
+  if (EntryA->key != EntryB->key)
+  {
+    return (EntryA->key<EntryB->key) ? -1 : 1;
+  }
+  return EntryA->pos-EntryB->pos;
+}
+
+void ClearPosIndex(pos_index_struct *Index, int Size)
+{
+  Index->size = Size;
+  Index->count = 0;
+  for (int cntPool=0; cntPool<POS_INDEX_POOLS; cntPool++)
+  {
+    Index->pool_count[cntPool] = 0;
+  }
+}
+
+void AddPosIndexKey(pos_index_struct *Index, int Pos, int Key)
+{
+  Index->entry[Index->count].key = Key;
+  Index->entry[Index->count].pos = Pos;
+  Index->count++;
+}
+
+//Positions must be added in list order
+void AddPosIndexSelectable(pos_index_struct *Index, int Pos, unsigned char *Pool)
+{
+  for (int cntPool=0; cntPool<POS_INDEX_POOLS; cntPool++)
+  {
+    if ((cntPool == 8) || (Pool[cntPool]))
+    {
+      Index->pool_pos[cntPool][Index->pool_count[cntPool]++] = Pos;
+    }
+  }
+}
+
+void FinishPosIndex(pos_index_struct *Index)
+{
+  int cntEntry;
+
+  qsort(Index->entry, Index->count, sizeof(pos_index_entry_struct), ComparePosIndexEntry);
+
+  Index->max_pos_below[0] = -1;
+  for (cntEntry=0; cntEntry<Index->count; cntEntry++)
+  {
+    Index->max_pos_below[cntEntry+1] = Index->max_pos_below[cntEntry];
+    if (Index->entry[cntEntry].pos > Index->max_pos_below[cntEntry+1])
+    {
+      Index->max_pos_below[cntEntry+1] = Index->entry[cntEntry].pos;
+    }
+  }
+  Index->min_pos_above[Index->count] = Index->size;
+  for (cntEntry=Index->count-1; cntEntry>=0; cntEntry--)
+  {
+    Index->min_pos_above[cntEntry] = Index->min_pos_above[cntEntry+1];
+    if (Index->entry[cntEntry].pos < Index->min_pos_above[cntEntry])
+    {
+      Index->min_pos_above[cntEntry] = Index->entry[cntEntry].pos;
+    }
+  }
+
+  for (int cntPool=0; cntPool<POS_INDEX_POOLS; cntPool++)
+  {
+    int cntSelectable = 0;
+    for (int cntPos=0; cntPos<=Index->size; cntPos++)
+    {
+      Index->pool_rank[cntPool][cntPos] = cntSelectable;
+      if ((cntSelectable<Index->pool_count[cntPool]) && (Index->pool_pos[cntPool][cntSelectable] == cntPos))
       {
-        check_for_next_pos = 1;
-        while (check_for_next_pos)
-        {
-          check_for_next_pos = 0;
+        cntSelectable++;
+      }
+    }
+  }
+}
 
-          CurrentPos--;
-          if (CurrentPos<0)
-          {
-            CurrentPos = MAX_POS_LIST_SIZE-1;
-          }
+//Returns the (last) position of Key, or if Key is not listed the last
+//position with a lower key (Offset<0) or the first with a higher key.
+//-1 if there is no position to start from.
+int FindPosIndex(pos_index_struct *Index, int Key, int Offset)
+{
+  int Low, High, Mid;
+  int First;
 
-          CurrentSource = matrix_sources.pos[CurrentPos].src;
+  if (Index->count == 0)
+  {
+    return -1;
+  }
 
-          //check if hybrid is used
-          if (CurrentSource > 0)
-          {
-            if (MixMinusSourceUsed(CurrentSource) != -1)
-            {
-              check_for_next_pos = 1;
-            }
-          }
+  Low = 0;
+  High = Index->count;
+  while (Low<High)
+  {
+    Mid = (Low+High)/2;
+    if (Index->entry[Mid].key < Key)
+    {
+      Low = Mid+1;
+    }
+    else
+    {
+      High = Mid;
+    }
+  }
+  First = Low;
+  High = Index->count;
+  while (Low<High)
+  {
+    Mid = (Low+High)/2;
+    if (Index->entry[Mid].key <= Key)
+    {
+      Low = Mid+1;
+    }
+    else
+    {
+      High = Mid;
+    }
+  }
 
-          //not active, go further.
-          if (!matrix_sources.pos[CurrentPos].active)
-          {
-            check_for_next_pos = 1;
-          }
+  if (First<Low)
+  {
+    return Index->entry[Low-1].pos;
+  }
+  if (Offset<0)
+  {
+    return Index->max_pos_below[First];
+  }
+  return Index->min_pos_above[Low];
+}
 
-          if (Pool<8)
-          {
-            if (!matrix_sources.pos[CurrentPos].pool[Pool])
-            {
-              check_for_next_pos = 1;
-            }
-          }
+//Returns the Candidate'th selectable position after (Offset>0) or before
+//(Offset<0) Pos, wrapping around the list. -1 if nothing is selectable.
+int StepPosIndex(pos_index_struct *Index, int Pos, int Offset, unsigned char Pool, int Candidate)
+{
+  int PoolNr = (Pool<8) ? Pool : 8;
+  int NumberOfPositions = Index->pool_count[PoolNr];
+  int Rank;
+  int Nr;
 
-          if (CurrentPos == StartPos)
-          { //Looped through all sources, no step found...
-            check_for_next_pos = 0;
-          }
+  if (NumberOfPositions == 0)
+  {
+    return -1;
+  }
+
+  Rank = Index->pool_rank[PoolNr][Pos];
+  if (Offset>0)
+  {
+    Nr = Rank+Candidate;
+    if ((Rank<NumberOfPositions) && (Index->pool_pos[PoolNr][Rank] == Pos))
+    {
+      Nr++;
+    }
+  }
+  else
+  {
+    Nr = Rank-1-Candidate;
+  }
+  Nr %= NumberOfPositions;
+  if (Nr<0)
+  {
+    Nr += NumberOfPositions;
+  }
+  return Index->pool_pos[PoolNr][Nr];
+}
+
+void RebuildSourcePosIndex()
+{
+  ClearPosIndex(&SourcePosIndex, MAX_POS_LIST_SIZE);
+  for (int cntPos=0; cntPos<MAX_POS_LIST_SIZE; cntPos++)
+  {
+    if (matrix_sources.pos[cntPos].src != INT_MIN)
+    {
+      AddPosIndexKey(&SourcePosIndex, cntPos, matrix_sources.pos[cntPos].src);
+    }
+    if (matrix_sources.pos[cntPos].active)
+    {
+      AddPosIndexSelectable(&SourcePosIndex, cntPos, matrix_sources.pos[cntPos].pool);
+    }
+  }
+  FinishPosIndex(&SourcePosIndex);
+}
+
+int AdjustModuleSource(int CurrentSource, int Offset, unsigned char Pool)
+{
+  int cntCandidate;
+  int NumberOfCandidates;
+  int StartPos;
+  int CurrentPos;
+  int StepPos;
+
+  //Determin the current position
+  CurrentPos = FindPosIndex(&SourcePosIndex, CurrentSource, Offset);
+
+  if (CurrentPos != -1)
+  {
+    NumberOfCandidates = SourcePosIndex.pool_count[(Pool<8) ? Pool : 8];
+    while (Offset != 0)
+    {
+      StartPos = CurrentPos;
+      for (cntCandidate=0; cntCandidate<NumberOfCandidates; cntCandidate++)
+      {
+        StepPos = StepPosIndex(&SourcePosIndex, StartPos, Offset, Pool, cntCandidate);
+        if (StepPos == StartPos)
+        { //Looped through all sources, no step found...
+          break;
+        }
+
+        //check if hybrid is used, this changes with the routing so it is not indexed
+        if ((matrix_sources.pos[StepPos].src <= 0) || (MixMinusSourceUsed(matrix_sources.pos[StepPos].src) == -1))
+        {
+          CurrentPos = StepPos;
+          break;
         }
-        Offset++;
       }
+      if (CurrentPos >= MAX_POS_LIST_SIZE)
+      { //Started behind the list and nothing selectable
+        return CurrentSource;
+      }
+      CurrentSource = matrix_sources.pos[CurrentPos].src;
+      Offset += (Offset>0) ? -1 : 1;
     }
   }
 
@@ -15296,6 +15826,10 @@ bool DoAxum_SetNewSource(int ModuleNr, int NewSource, int Forced)
 
         SetAxum_ModuleSource(ModuleNr);
         SetAxum_ModuleMixMinus(ModuleNr, OldSource);
+        if (UpdateModuleSourceActivity(ModuleNr))
+        { //the old source is released, the new one may be active directly
+          SetAxum_SourceActivityOutputs();
+        }
 
         unsigned int FunctionNrToSent = (ModuleNr<<12);
         if ((AxumData.ConsoleData[0].ControlMode == MODULE_CONTROL_MODE_SOURCE) || (AxumData.ConsoleData[0].ControlMode == MODULE_CONTROL_MODE_NONE))
@@ -15462,7 +15996,7 @@ bool DoAxum_SetNewSource(int ModuleNr, int NewSource, int Forced)
 
         for (int cntModule=0; cntModule<128; cntModule++)
         {
-          if (AxumData.ModuleData[cntModule].SelectedSource == AxumData.ModuleData[ModuleNr].SelectedSource)
+          if (ModuleHotState.SelectedSource[cntModule] == AxumData.ModuleData[ModuleNr].SelectedSource)
           {
             FunctionNrToSent = (cntModule<<12);
             CheckObjectsToSent(FunctionNrToSent+MODULE_FUNCTION_SOURCE);
@@ -15479,6 +16013,7 @@ bool DoAxum_SetNewSource(int ModuleNr, int NewSource, int Forced)
       }
     }
 
+    InvalidateModulePresetActive(ModuleNr);
     for (cntPreset=0; cntPreset<8; cntPreset++)
     {
       if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -15823,6 +16358,7 @@ void DoAxum_SetBussOnOff(int ModuleNr, int BussNr, unsigned char NewState, int L
               CheckObjectsToSent(FunctionNrToSent | (SOURCE_FUNCTION_MODULE_BUSS_1_2_ON_OFF+(BussNr*(SOURCE_FUNCTION_MODULE_BUSS_3_4_ON_OFF-SOURCE_FUNCTION_MODULE_BUSS_1_2_ON_OFF))));
             }
 
+            InvalidateModulePresetActive(cntModule);
             for (cntPreset=0; cntPreset<8; cntPreset++)
             {
               if (CurrentPresetState[cntPreset] != ModulePresetActive(cntModule, cntPreset+1))
@@ -16005,6 +16541,7 @@ void DoAxum_SetBussOnOff(int ModuleNr, int BussNr, unsigned char NewState, int L
       }
     }
 
+    InvalidateModulePresetActive(ModuleNr);
     for (cntPreset=0; cntPreset<8; cntPreset++)
     {
       if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -16052,7 +16589,6 @@ void initialize_axum_data_struct()
     {
       AxumData.SourceData[cntSource].MonitorMute[cntMonitorMute] = 0;
     }
-    AxumData.SourceData[cntSource].Active = 0;
     AxumData.SourceData[cntSource].Start = 0;
     AxumData.SourceData[cntSource].Phantom = 0;
     AxumData.SourceData[cntSource].Pad = 0;
@@ -16574,6 +17110,12 @@ void initialize_axum_data_struct()
     AxumData.ExternSource[cntMonitor].InterlockSafe[6] = 0;
     AxumData.ExternSource[cntMonitor].InterlockSafe[7] = 0;
   }
+  ClearSourceActivity();
+  RebuildSourceUsageIndex();
+  RebuildModuleHotState();
+  ResetBackplaneRouting();
+  RebuildSourcePosIndex();
+  RebuildPresetPosIndex();
 
   AxumData.PercentInitialized = 0;
 }
@@ -16862,6 +17404,7 @@ void DoAxum_LoadProcessingPreset(unsigned char ModuleNr, int NewProcessingPreset
   if (AxumData.ModuleData[ModuleNr].SelectedProcessingPreset != PresetNr)
   {
     AxumData.ModuleData[ModuleNr].SelectedProcessingPreset = PresetNr;
+    InvalidateModulePresetActive(ModuleNr);
 
     unsigned int FunctionNrToSent = ((ModuleNr<<12)&0xFFF000);
     CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_PRESET);
@@ -17185,6 +17728,7 @@ void DoAxum_LoadProcessingPreset(unsigned char ModuleNr, int NewProcessingPreset
     CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_CONTROL_LABEL);
   }
 
+  InvalidateModulePresetActive(ModuleNr);
   for (cntPreset=0; cntPreset<8; cntPreset++)
   {
     if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -17371,6 +17915,7 @@ void DoAxum_LoadRoutingPreset(unsigned char ModuleNr, int PresetNr, unsigned cha
     CheckObjectsToSent(FunctionNrToSent | MODULE_FUNCTION_CONTROL_4);
   }
 
+  InvalidateModulePresetActive(ModuleNr);
   for (cntPreset=0; cntPreset<8; cntPreset++)
   {
     if (CurrentPresetState[cntPreset] != ModulePresetActive(ModuleNr, cntPreset+1))
@@ -17647,185 +18192,87 @@ unsigned int NrOfObjectsAttachedToFunction(unsigned int FunctionNumberToCheck)
   unsigned char FunctionType = (FunctionNumberToCheck>>24)&0xFF;
   unsigned int FunctionNumber = (FunctionNumberToCheck>>12)&0xFFF;
   unsigned int Function = FunctionNumberToCheck&0xFFF;
-  AXUM_FUNCTION_INFORMATION_STRUCT *WalkAxumFunctionInformationStruct = NULL;
   int NumberOfObjects = 0;
 
-  //Clear function list
   switch (FunctionType)
   {
     case MODULE_FUNCTIONS:
     {   //Module
-      WalkAxumFunctionInformationStruct = ModuleFunctions[FunctionNumber][Function];
+      NumberOfObjects = ModuleFunctionsCount[FunctionNumber][Function];
     }
     break;
     case BUSS_FUNCTIONS:
     {   //Buss
-      WalkAxumFunctionInformationStruct = BussFunctions[FunctionNumber][Function];
+      NumberOfObjects = BussFunctionsCount[FunctionNumber][Function];
     }
     break;
     case MONITOR_BUSS_FUNCTIONS:
     {   //Monitor Buss
-      WalkAxumFunctionInformationStruct = MonitorBussFunctions[FunctionNumber][Function];
+      NumberOfObjects = MonitorBussFunctionsCount[FunctionNumber][Function];
     }
     break;
     case CONSOLE_FUNCTIONS:
     {   //Console
-      WalkAxumFunctionInformationStruct = ConsoleFunctions[FunctionNumber][Function];
+      NumberOfObjects = ConsoleFunctionsCount[FunctionNumber][Function];
     }
     break;
     case GLOBAL_FUNCTIONS:
     {   //Global
-      WalkAxumFunctionInformationStruct = GlobalFunctions[Function];
+      NumberOfObjects = GlobalFunctionsCount[Function];
     }
     break;
     case SOURCE_FUNCTIONS:
     {   //Source
-      WalkAxumFunctionInformationStruct = SourceFunctions[FunctionNumber][Function];
+      NumberOfObjects = SourceFunctionsCount[FunctionNumber][Function];
     }
     break;
     case DESTINATION_FUNCTIONS:
     {   //Destination
-      WalkAxumFunctionInformationStruct = DestinationFunctions[FunctionNumber][Function];
+      NumberOfObjects = DestinationFunctionsCount[FunctionNumber][Function];
     }
     break;
   }
-  while (WalkAxumFunctionInformationStruct != NULL)
-  {
-    NumberOfObjects++;
-    WalkAxumFunctionInformationStruct = (AXUM_FUNCTION_INFORMATION_STRUCT *)WalkAxumFunctionInformationStruct->Next;
-  }
   return NumberOfObjects;
 }
 
-int AdjustModulePreset(int CurrentPreset, int Offset, unsigned char Pool)
+void RebuildPresetPosIndex()
 {
-  char check_for_next_pos;
-
-  int cntPos;
-  int StartPos;
-  int CurrentPos;
-  int PosBefore;
-  int PosAfter;
-
-  //Determin the current position
-  CurrentPos = -1;
-  PosBefore = -1;
-  PosAfter = MAX_NR_OF_PRESETS+2;
-  for (cntPos=0; cntPos<MAX_NR_OF_PRESETS+2; cntPos++)
+  ClearPosIndex(&PresetPosIndex, MAX_NR_OF_PRESETS+2);
+  for (int cntPos=0; cntPos<MAX_NR_OF_PRESETS+2; cntPos++)
   {
     if (presets.pos[cntPos].filled)
     {
-      if (presets.pos[cntPos].number == (signed short int)CurrentPreset)
-      {
-        CurrentPos = cntPos;
-      }
-      else if (presets.pos[cntPos].number < (signed short int)CurrentPreset)
-      {
-        if (cntPos>PosBefore)
-        {
-          PosBefore = cntPos;
-        }
-      }
-      else if (presets.pos[cntPos].number > (signed short int)CurrentPreset)
-      {
-        if (cntPos<PosAfter)
-        {
-          PosAfter = cntPos;
-        }
-      }
+      AddPosIndexKey(&PresetPosIndex, cntPos, presets.pos[cntPos].number);
+      AddPosIndexSelectable(&PresetPosIndex, cntPos, presets.pos[cntPos].pool);
     }
   }
+  FinishPosIndex(&PresetPosIndex);
+}
 
-  //If current position not found...
-  if (CurrentPos == -1)
-  {
-    if (Offset<0)
-    {
-      CurrentPos = PosBefore;
-    }
-    else
-    {
-      CurrentPos = PosAfter;
-    }
-  }
+int AdjustModulePreset(int CurrentPreset, int Offset, unsigned char Pool)
+{
+  int StartPos;
+  int CurrentPos;
+
+  //Determin the current position
+  CurrentPos = FindPosIndex(&PresetPosIndex, (signed short int)CurrentPreset, Offset);
 
   if (CurrentPos != -1)
   {
     while (Offset != 0)
     {
       StartPos = CurrentPos;
-      if (Offset>0)
-      {
-        check_for_next_pos = 1;
-        while (check_for_next_pos)
-        {
-          check_for_next_pos = 0;
-
-          CurrentPos++;
-          if (CurrentPos>=MAX_NR_OF_PRESETS+2)
-          {
-            CurrentPos = 0;
-          }
-
-          CurrentPreset = presets.pos[CurrentPos].number;
-
-          //not active, go further.
-          if (!presets.pos[CurrentPos].filled)
-          {
-            check_for_next_pos = 1;
-          }
-
-          if (Pool<8)
-          {
-            if (!presets.pos[CurrentPos].pool[Pool])
-            {
-              check_for_next_pos = 1;
-            }
-          }
-
-          if (CurrentPos == StartPos)
-          { //Looped through all sources, no step found...
-            check_for_next_pos = 0;
-          }
-        }
-        Offset--;
+      CurrentPos = StepPosIndex(&PresetPosIndex, StartPos, Offset, Pool, 0);
+      if (CurrentPos == -1)
+      { //Nothing selectable, stay
+        CurrentPos = StartPos;
       }
-      else
-      {
-        check_for_next_pos = 1;
-        while (check_for_next_pos)
-        {
-          check_for_next_pos = 0;
-
-          CurrentPos--;
-          if (CurrentPos<0)
-          {
-            CurrentPos = (MAX_NR_OF_PRESETS+2)-1;
-          }
-
-          CurrentPreset = presets.pos[CurrentPos].number;
-
-          //not active, go further.
-          if (!presets.pos[CurrentPos].filled)
-          {
-            check_for_next_pos = 1;
-          }
-
-          if (Pool<8)
-          {
-            if (!presets.pos[CurrentPos].pool[Pool])
-            {
-              check_for_next_pos = 1;
-            }
-          }
-
-          if (CurrentPos == StartPos)
-          { //Looped through all sources, no step found...
-            check_for_next_pos = 0;
-          }
-        }
-        Offset++;
+      if (CurrentPos >= MAX_NR_OF_PRESETS+2)
+      { //Started behind the list and nothing selectable
+        return CurrentPreset;
       }
+      CurrentPreset = presets.pos[CurrentPos].number;
+      Offset += (Offset>0) ? -1 : 1;
     }
   }
 
@@ -18710,7 +19157,39 @@ void DoAxum_UpdateMasterControlMode(int ControlMode)
   }
 }
 
+void InvalidateModulePresetActive(int ModuleNr)
+{
+  ModulePresetActiveValid[ModuleNr] = 0;
+}
+
+void InvalidateAllModulePresetActive()
+{
+  memset(ModulePresetActiveValid, 0, sizeof(ModulePresetActiveValid));
+}
+
 unsigned char ModulePresetActive(int ModuleNr, unsigned char PresetNr)
+{
+  if ((PresetNr<1) || (PresetNr>8))
+  {
+    return 0;
+  }
+
+  if (!ModulePresetActiveValid[ModuleNr])
+  {
+    ModulePresetActiveMask[ModuleNr] = 0;
+    for (unsigned char cntPreset=0; cntPreset<8; cntPreset++)
+    {
+      if (CalculateModulePresetActive(ModuleNr, cntPreset+1))
+      {
+        ModulePresetActiveMask[ModuleNr] |= 1<<cntPreset;
+      }
+    }
+    ModulePresetActiveValid[ModuleNr] = 1;
+  }
+  return (ModulePresetActiveMask[ModuleNr]>>(PresetNr-1))&0x01;
+}
+
+unsigned char CalculateModulePresetActive(int ModuleNr, unsigned char PresetNr)
 {
   int ModulePresetSource = 0;
   int ModulePresetPreset = 0;
@@ -19124,7 +19603,6 @@ void DoAxum_SetCRMBussOnOff(int MonitorBussNr, int BussNr, unsigned char NewStat
 
 void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float NewLevel, unsigned char CurrentOn, unsigned char NewOn)
 {
-  unsigned char UpdateStartStopObjects = 0;
   unsigned char OtherFaderActive = 0;
   unsigned char OtherFaderAndOnActive = 0;
   unsigned char OtherOnActive = 0;
@@ -19133,31 +19611,35 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
   {
     int SourceNr = AxumData.ModuleData[ModuleNr].SelectedSource - matrix_sources.src_offset.min.source;
 
+    unsigned char Start = AxumData.SourceData[SourceNr].Start;
+    if (SourceStartStopPending[SourceNr])
+    {
+      Start = SourceStartStopPendingState[SourceNr];
+    }
+    unsigned char NewStart = Start;
+
     //Check the source on other modules
-    for (unsigned int cntModule=0; cntModule<128; cntModule++)
+    for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
     {
-      if (cntModule != ModuleNr)
+      if (cntModule != (int)ModuleNr)
       {
-        if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+        if (AxumData.ModuleData[cntModule].FaderLevel>-80)
         {
-          if (AxumData.ModuleData[cntModule].FaderLevel>-80)
-          {
-            OtherFaderActive = 1;
-            if (AxumData.ModuleData[cntModule].On)
-            {
-              OtherFaderAndOnActive =1;
-            }
-          }
+          OtherFaderActive = 1;
           if (AxumData.ModuleData[cntModule].On)
           {
-            OtherOnActive = 1;
+            OtherFaderAndOnActive =1;
           }
         }
+        if (AxumData.ModuleData[cntModule].On)
+        {
+          OtherOnActive = 1;
+        }
       }
     }
 
     //start
-    if (!AxumData.SourceData[SourceNr].Start)
+    if (!NewStart)
     {
       switch (AxumData.SourceData[SourceNr].StartTrigger)
       {
@@ -19165,8 +19647,7 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
         { //module fader on
           if ((CurrentLevel<=-80) && (NewLevel>-80))
           {
-            AxumData.SourceData[SourceNr].Start = 1;
-            UpdateStartStopObjects = 1;
+            NewStart = 1;
           }
         }
         break;
@@ -19174,8 +19655,7 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
         { //module on
           if ((CurrentOn != NewOn) && (NewOn == 1))
           {
-            AxumData.SourceData[SourceNr].Start = 1;
-            UpdateStartStopObjects = 1;
+            NewStart = 1;
           }
         }
         break;
@@ -19184,8 +19664,7 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
           if ((((CurrentLevel<=-80) && (NewLevel>-80)) && (NewOn == 1)) ||
               (((CurrentOn != NewOn) && (NewOn == 1)) && (NewLevel>-80)))
           {
-            AxumData.SourceData[SourceNr].Start = 1;
-            UpdateStartStopObjects = 1;
+            NewStart = 1;
           }
         }
         break;
@@ -19193,7 +19672,7 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
     }
 
     //stop
-    if (AxumData.SourceData[SourceNr].Start)
+    if (NewStart)
     {
       switch (AxumData.SourceData[SourceNr].StopTrigger)
       {
@@ -19203,8 +19682,7 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
           {
             if (!OtherFaderActive)
             {
-              AxumData.SourceData[SourceNr].Start = 0;
-              UpdateStartStopObjects = 1;
+              NewStart = 0;
             }
           }
         }
@@ -19215,8 +19693,7 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
           {
             if (!OtherOnActive)
             {
-              AxumData.SourceData[SourceNr].Start = 0;
-              UpdateStartStopObjects = 1;
+              NewStart = 0;
             }
           }
         }
@@ -19228,8 +19705,7 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
           {
             if (!OtherFaderAndOnActive)
             {
-              AxumData.SourceData[SourceNr].Start = 0;
-              UpdateStartStopObjects = 1;
+              NewStart = 0;
             }
           }
         }
@@ -19237,27 +19713,130 @@ void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float Ne
       }
     }
 
-    if (UpdateStartStopObjects)
-    { //Only if pushed or changed
-      unsigned int DisplayFunctionNr = 0x05000000 | (SourceNr<<12);
-      CheckObjectsToSent(DisplayFunctionNr | SOURCE_FUNCTION_START);
-      CheckObjectsToSent(DisplayFunctionNr | SOURCE_FUNCTION_STOP);
-      CheckObjectsToSent(DisplayFunctionNr | SOURCE_FUNCTION_START_STOP);
-
-      for (int cntModule=0; cntModule<128; cntModule++)
+    if (NewStart != Start)
+    {
+      if (((cntMillisecondTimer-SourceStartStopTime[SourceNr])*10) < StartStopDebounceTime)
+      { //cntMillisecondTimer counts 10ms ticks
+        StartStopTriggerStatistics.Debounced++;
+        if (SourceStartStopPending[SourceNr])
+        {
+          SourceStartStopPending[SourceNr] = 0;
+          StartStopPendingCount--;
+        }
+        if (NewStart != AxumData.SourceData[SourceNr].Start)
+        {
+          SourceStartStopPending[SourceNr] = 1;
+          SourceStartStopPendingState[SourceNr] = NewStart;
+          StartStopPendingCount++;
+        }
+      }
+      else
       {
-        if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+        if (SourceStartStopPending[SourceNr])
         {
-          DisplayFunctionNr = (cntModule<<12);
-          CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_START);
-          CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_STOP);
-          CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_START_STOP);
+          SourceStartStopPending[SourceNr] = 0;
+          StartStopPendingCount--;
         }
+        SendStartStopTrigger(SourceNr, NewStart);
       }
     }
   }
 }
 
+void SendStartStopTrigger(unsigned int SourceNr, unsigned char Start)
+{
+  unsigned int DisplayFunctionNr = 0x05000000 | (SourceNr<<12);
+
+  AxumData.SourceData[SourceNr].Start = Start;
+  SourceStartStopTime[SourceNr] = cntMillisecondTimer;
+
+  CheckObjectsToSent(DisplayFunctionNr | SOURCE_FUNCTION_START);
+  CheckObjectsToSent(DisplayFunctionNr | SOURCE_FUNCTION_STOP);
+  CheckObjectsToSent(DisplayFunctionNr | SOURCE_FUNCTION_START_STOP);
+
+  if (SensorReceiveTimeValid)
+  {
+    struct timeval SendTime;
+    unsigned int Bucket = 0;
+
+    gettimeofday(&SendTime, NULL);
+    unsigned long Latency = ((SendTime.tv_sec-SensorReceiveTime.tv_sec)*1000000)+(SendTime.tv_usec-SensorReceiveTime.tv_usec);
+    while ((Bucket<(START_STOP_LATENCY_BUCKETS-1)) && (Latency >= (64UL<<Bucket)))
+    {
+      Bucket++;
+    }
+    StartStopTriggerStatistics.Histogram[Start][Bucket]++;
+    if (Latency > StartStopTriggerStatistics.MaxLatency[Start])
+    {
+      StartStopTriggerStatistics.MaxLatency[Start] = Latency;
+    }
+    LOG_DEBUG("[%s] Source %d %s, %lu us after sensor receipt", __func__, SourceNr+1, Start ? "start" : "stop", Latency);
+  }
+  else
+  {
+    StartStopTriggerStatistics.Untimed++;
+  }
+
+  for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
+  {
+    DisplayFunctionNr = (cntModule<<12);
+    CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_START);
+    CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_STOP);
+    CheckObjectsToSent(DisplayFunctionNr | MODULE_FUNCTION_SOURCE_START_STOP);
+  }
+}
+
+//Called from the timer with the axum data lock held
+void SettleStartStopTriggers()
+{
+  for (int cntSource=0; (cntSource<NUMBER_OF_SOURCES) && (StartStopPendingCount>0); cntSource++)
+  {
+    if ((SourceStartStopPending[cntSource]) &&
+        (((cntMillisecondTimer-SourceStartStopTime[cntSource])*10) >= StartStopDebounceTime))
+    {
+      SourceStartStopPending[cntSource] = 0;
+      StartStopPendingCount--;
+      if (SourceStartStopPendingState[cntSource] != AxumData.SourceData[cntSource].Start)
+      {
+        StartStopTriggerStatistics.Settled++;
+        SendStartStopTrigger(cntSource, SourceStartStopPendingState[cntSource]);
+      }
+    }
+  }
+}
+
+void LogStartStopTriggerStatistics()
+{
+  const char *TriggerName[2] = {"stop", "start"};
+  char Histogram[512];
+
+  for (int cntTrigger=0; cntTrigger<2; cntTrigger++)
+  {
+    int Length = 0;
+    for (int cntBucket=0; cntBucket<START_STOP_LATENCY_BUCKETS; cntBucket++)
+    {
+      Length += snprintf(&Histogram[Length], sizeof(Histogram)-Length, " %lu", StartStopTriggerStatistics.Histogram[cntTrigger][cntBucket]);
+    }
+    log_write("[start/stop trigger] %s latency histogram (64us<<n):%s, max %lu us", TriggerName[cntTrigger], Histogram, StartStopTriggerStatistics.MaxLatency[cntTrigger]);
+  }
+  log_write("[start/stop trigger] %lu untimed, %lu debounced, %lu settled", StartStopTriggerStatistics.Untimed, StartStopTriggerStatistics.Debounced, StartStopTriggerStatistics.Settled);
+}
+
+void LogSensorChangeStatistics()
+{
+  for (int cntType=0; cntType<NUMBER_OF_FUNCTION_TYPES; cntType++)
+  {
+    SENSOR_CHANGE_HANDLER_STRUCT *SensorChangeHandler = &SensorChangeHandlers[cntType];
+    unsigned long AverageLatency = 0;
+
+    if (SensorChangeHandler->Calls)
+    {
+      AverageLatency = SensorChangeHandler->TotalLatency/SensorChangeHandler->Calls;
+    }
+    log_write("[sensor change] %s: %lu calls, total %lu us, average %lu us, max %lu us", SensorChangeHandler->Name, SensorChangeHandler->Calls, SensorChangeHandler->TotalLatency, AverageLatency, SensorChangeHandler->MaxLatency);
+  }
+}
+
 void SetSelectedModule(unsigned char SelectNr, unsigned int NewModuleNr)
 {
   if ((SelectNr<4) && (NewModuleNr<128))
@@ -19490,22 +20069,19 @@ void DoAxum_TalkbackToRelatedDestination(unsigned char ModuleNr, unsigned char T
 
 void DoAxum_SetCough(int SourceNr, unsigned char NewState)
 {
-  for (int cntModule=0; cntModule<128; cntModule++)
+  for (int cntModule=NextSourceModule(SourceNr, 0); cntModule!=-1; cntModule=NextSourceModule(SourceNr, cntModule+1))
   {
-    if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+    if (AxumData.ModuleData[cntModule].Cough != NewState)
     {
-      if (AxumData.ModuleData[cntModule].Cough != NewState)
-      {
-        AxumData.ModuleData[cntModule].Cough = NewState;
+      AxumData.ModuleData[cntModule].Cough = NewState;
 
-        SetAxum_BussLevels(cntModule);
+      SetAxum_BussLevels(cntModule);
 
-        unsigned int FunctionNrToSend = ((cntModule)<<12);
-        CheckObjectsToSent(FunctionNrToSend+MODULE_FUNCTION_COUGH_ON_OFF);
+      unsigned int FunctionNrToSend = ((cntModule)<<12);
+      CheckObjectsToSent(FunctionNrToSend+MODULE_FUNCTION_COUGH_ON_OFF);
 
-        FunctionNrToSend = 0x05000000 | (SourceNr<<12);
-        CheckObjectsToSent(FunctionNrToSend+SOURCE_FUNCTION_MODULE_COUGH_ON_OFF);
-      }
+      FunctionNrToSend = 0x05000000 | (SourceNr<<12);
+      CheckObjectsToSent(FunctionNrToSend+SOURCE_FUNCTION_MODULE_COUGH_ON_OFF);
     }
   }
 }
@@ -19524,7 +20100,7 @@ void DoAxum_SetComm(int SourceNr, unsigned char CommNr, unsigned char NewState)
         {
           if (AxumData.ModuleData[cntModule].Console == AxumData.BussMasterData[cntBuss].Console)
           {
-            if (AxumData.ModuleData[cntModule].SelectedSource == (SourceNr+matrix_sources.src_offset.min.source))
+            if (ModuleHotState.SelectedSource[cntModule] == (SourceNr+matrix_sources.src_offset.min.source))
             {
               DoAxum_SetBussOnOff(cntModule, cntBuss, NewState, 0);
             }
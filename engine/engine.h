@@ -18,10 +18,19 @@
 #define _engine_h
 
 #include <stdio.h>
+#include <sys/time.h>
 #include "engine_functions.h"
 
 #define DEFAULT_TIME_BEFORE_MOMENTARY 750
 
+#define SIGNAL_DETECT_LEVEL                 -30   //dB, relative to headroom
+#define PEAK_DETECT_LEVEL                   -3    //dB
+#define DEFAULT_SIGNAL_DETECT_HYSTERESIS    3     //dB
+#define DEFAULT_SIGNAL_DETECT_HOLD_TIME     250   //ms
+#define DEFAULT_PEAK_DETECT_HYSTERESIS      1     //dB
+#define DEFAULT_PEAK_DETECT_HOLD_TIME       500   //ms
+#define DEFAULT_START_STOP_DEBOUNCE_TIME    0     //ms
+
 #define bool unsigned char
 
 enum FilterType {OFF=0, HPF=1, LOWSHELF=2, PEAKINGEQ=3, HIGHSHELF=4, LPF=5, BPF=6, NOTCH=7};
@@ -419,6 +428,22 @@ typedef struct
   unsigned char PercentInitialized;
 } AXUM_DATA_STRUCT;
 
+//Hot module state mirrored as arrays over the modules so engine wide scans
+//touch a few cache lines instead of striding over AXUM_MODULE_DATA_STRUCT.
+//Bit n of a mask is module n.
+typedef struct
+{
+  unsigned int On[4];
+  unsigned int FaderOpen[4];      //fader level above -80dB
+  unsigned int Signal[4];
+  unsigned int Peak[4];
+  unsigned int BussRouted[4];     //assigned to and on for at least one buss
+  unsigned int BussOn[16][4];
+  int SelectedSource[128];
+  float FaderLevel[128];
+  float BussLevel[16][128];
+} AXUM_MODULE_HOT_STATE_STRUCT;
+
 //**************************************************************/
 // Struct to determine offset numbers of sources
 //**************************************************************/
@@ -463,6 +488,27 @@ typedef struct
   preset_list_struct pos[2+MAX_NR_OF_PRESETS];
 } preset_pos_struct;
 
+//Sorted lookup over a position list, used by the encoder stepping
+//pool 0-7 are the source/preset pools, pool 8 means 'no pool'
+#define POS_INDEX_POOLS 9
+typedef struct
+{
+  int key;
+  int pos;
+} pos_index_entry_struct;
+
+typedef struct
+{
+  int size;
+  int count;
+  pos_index_entry_struct entry[MAX_POS_LIST_SIZE];   //sorted on key, then pos
+  int max_pos_below[MAX_POS_LIST_SIZE+1];            //max pos of entry[0..n-1]
+  int min_pos_above[MAX_POS_LIST_SIZE+1];            //min pos of entry[n..count-1]
+  int pool_count[POS_INDEX_POOLS];
+  int pool_pos[POS_INDEX_POOLS][MAX_POS_LIST_SIZE];  //selectable positions in list order
+  int pool_rank[POS_INDEX_POOLS][MAX_POS_LIST_SIZE+1];//number of selectable positions before pos
+} pos_index_struct;
+
 //**************************************************************/
 //MambaNet Node information definitions
 //**************************************************************/
@@ -547,12 +593,47 @@ struct ONLINE_NODE_INFORMATION_STRUCT
   ONLINE_NODE_INFORMATION_STRUCT *Next;
 };
 
+//Start/stop trigger latency is counted from the receipt of the sensor change
+//that caused the trigger until the start/stop objects are sent. Bucket n
+//holds latencies below (64<<n) us, the last bucket holds the rest.
+#define START_STOP_LATENCY_BUCKETS  16
+
+typedef struct
+{
+  unsigned long Histogram[2][START_STOP_LATENCY_BUCKETS];    //[stop/start]
+  unsigned long MaxLatency[2];
+  unsigned long Untimed;      //not caused by a sensor change (preset, database)
+  unsigned long Debounced;    //triggers within the debounce time
+  unsigned long Settled;      //pending states sent after the debounce time
+} START_STOP_TRIGGER_STATISTICS_STRUCT;
+
+//Sensor changes are dispatched by function type through SensorChangeHandlers[],
+//the handler gets the operands mSensorDataChanged() decoded for the object.
+//Latencies are in us and only count the handler itself.
+typedef void (*SENSOR_CHANGE_HANDLER)(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
+
+typedef struct
+{
+  SENSOR_CHANGE_HANDLER Handler;
+  const char *Name;
+  unsigned long Calls;
+  unsigned long TotalLatency;
+  unsigned long MaxLatency;
+} SENSOR_CHANGE_HANDLER_STRUCT;
+
 float CalculateEQ(float *Coefficients, float Gain, int Frequency, float Bandwidth, float Slope, FilterType Type);
 
 //mbn-lib callbacks
 void mAddressTableChange(struct mbn_handler *mbn, struct mbn_address_node *old_info, struct mbn_address_node *new_info);
 int mSensorDataResponse(struct mbn_handler *mbn, struct mbn_message *message, short unsigned int object, unsigned char type, union mbn_data data);
 int mSensorDataChanged(struct mbn_handler *mbn, struct mbn_message *message, short unsigned int object, unsigned char type, union mbn_data data);
+void SensorChangedModule(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
+void SensorChangedBuss(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
+void SensorChangedMonitorBuss(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
+void SensorChangedConsole(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
+void SensorChangedGlobal(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
+void SensorChangedSource(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
+void SensorChangedDestination(int SensorReceiveFunctionNumber, SENSOR_RECEIVE_FUNCTION_STRUCT *SensorReceiveFunction, ONLINE_NODE_INFORMATION_STRUCT *OnlineNodeInformationElement, unsigned char type, union mbn_data data, int DataType, int DataSize, float DataMinimal, float DataMaximal);
 void mError(struct mbn_handler *m, int code, char *str);
 void mAcknowledgeTimeout(struct mbn_handler *m, struct mbn_message *msg);
 void mAcknowledgeReply(struct mbn_handler *m, struct mbn_message *request, struct mbn_message *reply, int retries);
@@ -566,6 +647,8 @@ void initialize_axum_data_struct();
 //misc utility functions
 int delay_ms(double sleep_time);
 int delay_us(double sleep_time);
+void RebuildSlotAddressIndex();
+int GetSlotChannelBase(unsigned int MambaNetAddress);
 void axum_get_mtrx_chs_from_src(int src, unsigned int *l_ch, unsigned int *r_ch);
 void debug_mambanet_data(unsigned int addr, unsigned int object, unsigned char type, union mbn_data data);
 
@@ -581,6 +664,9 @@ unsigned int NrOfObjectsAttachedToFunction(unsigned int FunctionNumberToCheck);
 
 //Backplane functions, sending MambaNet to the backplane
 void SetBackplaneRouting(unsigned int FormInputNr, unsigned int ChannelNr);
+void BeginBackplaneRouting();
+void EndBackplaneRouting();
+void ResetBackplaneRouting();
 void SetBackplaneClock();
 
 //Axum functions, only effictive internally (no MambaNet)
@@ -597,16 +683,37 @@ void SetAxum_TalkbackSource(unsigned int TalkbackNr);
 void SetAxum_BussMasterLevels();
 void SetAxum_MonitorBuss(unsigned int MonitorBussNr);
 int MixMinusSourceUsed(int CurrentSource);
+int NextSourceModule(int SourceNr, int ModuleNr);
 void GetSourceLabel(int SourceNr, char *TextString, int MaxLength);
 #define AdjustDestinationSource AdjustModuleSource
 int AdjustModuleSource(int CurrentSource, int Offset, unsigned char Pool);
 int AdjustModulePreset(int CurrentPreset, int Offset, unsigned char Pool);
+void RebuildSourcePosIndex();
+void RebuildPresetPosIndex();
 void GetPresetLabel(int PresetNr, char *TextString, int MaxLength);
 void GetConsolePresetLabel(unsigned int ConsolePresetNr, char *TextString, int MaxLength);
 int GetControlModeFromConsoleFunctionNr(unsigned int CheckFunctionNr);
 unsigned int GetConsoleFunctionNrFromControlMode(unsigned int ConsoleNr);
-int SourceActive(unsigned int InputSourceNr);
+int SourceActive(int InputSourceNr);
+unsigned char ModuleSourceActive(int ModuleNr);
+int UpdateModuleSourceActivity(int ModuleNr);
+void SetAxum_SourceActivityOutputs();
+void ClearSourceActivity();
+void RebuildSourceActivity();
+void SetModuleBit(unsigned int *Mask, int ModuleNr, unsigned char State);
+unsigned char ModuleBit(const unsigned int *Mask, int ModuleNr);
+void UpdateModuleHotState(int ModuleNr);
+void RebuildModuleHotState();
+void ModuleMeterObjectsMask(unsigned int *Mask);
+void DetectModuleSignalAndPeak(float *Level);
+int SourceIndex(int SourceNr);
+void IndexModuleSource(unsigned int ModuleNr);
+void IndexDestinationMixMinus(unsigned int DestinationNr);
+void RebuildSourceUsageIndex();
+unsigned char CalculateModulePresetActive(int ModuleNr, unsigned char PresetNr);
 unsigned char ModulePresetActive(int ModuleNr, unsigned char PresetNr);
+void InvalidateModulePresetActive(int ModuleNr);
+void InvalidateAllModulePresetActive();
 unsigned char GetPresetNrFromFunctionNr(unsigned int FunctionNr);
 unsigned int GetModuleFunctionNrFromPresetNr(unsigned char PresetNr);
 
@@ -635,6 +742,11 @@ void DoAxum_UpdateModuleControlModeLabel(unsigned char ModuleNr, int ControlMode
 void DoAxum_UpdateModuleControlMode(unsigned char ModuleNr, int ControlMode);
 void DoAxum_UpdateMasterControlMode(int ControlMode);
 void DoAxum_StartStopTrigger(unsigned int ModuleNr, float CurrentLevel, float NewLevel, unsigned char CurrentOn, unsigned char NewOn);
+void SendStartStopTrigger(unsigned int SourceNr, unsigned char Start);
+void SettleStartStopTriggers();
+void LogStartStopTriggerStatistics();
+void LogSensorChangeStatistics();
+void RequestStatistics(int Signal);
 void DoAxum_TalkbackToRelatedDestination(unsigned char ModuleNr, unsigned char TalkbackNr, unsigned char NewState, unsigned char Dimming);
 void DoAxum_SetCough(int SourceNr, unsigned char NewState);
 void DoAxum_SetComm(int SourceNr, unsigned char CommNr, unsigned char NewState);
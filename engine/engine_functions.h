@@ -5,6 +5,7 @@
 #define GLOBAL_FUNCTIONS                    4
 #define SOURCE_FUNCTIONS                    5
 #define DESTINATION_FUNCTIONS               6
+#define NUMBER_OF_FUNCTION_TYPES            7
 
 #define SOURCE_FUNCTION_MODULE_ON                             0
 #define SOURCE_FUNCTION_MODULE_OFF                            1
@@ -17,6 +17,7 @@
 #define MBN_VARARG
 #include "common.h"
 #include "if_scan.h"
+#include "stats.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -47,6 +48,15 @@
 
 #define nodestr(n) (n == unx) ? "unx" : ((n == eth) ? "eth" : ((n == can) ? "can" : ((n == tcp) ? "tcp" : "udp")))
 
+/* Interfaces in the order in which they are preferred as destination
+ * for unicast messages, used as bit index in the route cache */
+#define IF_CAN 0
+#define IF_ETH 1
+#define IF_TCP 2
+#define IF_UDP 3
+#define IF_UNX 4
+#define IF_COUNT 5
+
 #define OBJ_IPADDR   0
 #define OBJ_IPNET    1
 #define OBJ_IPGW     2
@@ -56,12 +66,30 @@
 #define OBJ_UDPNODES 6
 #define OBJ_UNXNODES 7
 #define OBJ_EXTCLOCK 8
-
-#define NR_OF_OBJECTS 9
+/* per interface statistics, OBJ_IFSTATS + IF_* * OBJ_IFSTATS_COUNT + OBJ_IF_* */
+#define OBJ_IFSTATS  9
+#define OBJ_IF_RXMSG   0
+#define OBJ_IF_TXMSG   1
+#define OBJ_IF_RXBYTES 2
+#define OBJ_IF_TXBYTES 3
+#define OBJ_IF_DROPS   4
+#define OBJ_IF_QUEUE   5
+#define OBJ_IFSTATS_COUNT 6
+#define OBJ_CANRXFRAMES (OBJ_IFSTATS+IF_COUNT*OBJ_IFSTATS_COUNT)
+#define OBJ_CANTXFRAMES (OBJ_CANRXFRAMES+1)
+#define OBJ_ADDRMSGRATE (OBJ_CANRXFRAMES+2)
+#define OBJ_OBJMSGRATE  (OBJ_CANRXFRAMES+3)
+#define OBJ_OTHERMSGRATE (OBJ_CANRXFRAMES+4)
+#define OBJ_LATENCYP50  (OBJ_CANRXFRAMES+5)
+#define OBJ_LATENCYP99  (OBJ_CANRXFRAMES+6)
+#define OBJ_LATENCYMAX  (OBJ_CANRXFRAMES+7)
+
+#define NR_OF_OBJECTS (OBJ_LATENCYMAX+1)
 //Major version 3 = 6 objects
 //Major version 4 = 7 objects, added UDP
 //Major version 5 = 8 objects, added unix sockets
 //Major version 6 = 9 object, added optional extern clock object
+//Major version 7 = 47 objects, added statistics, extern clock object always present
 
 struct mbn_node_info this_node = {
   0x00000000, 0x00, /* MambaNet Addr + Services */
@@ -69,23 +97,98 @@ struct mbn_node_info this_node = {
   "Axum MambaNet Gateway",
   0x0001, 0x000D, 0x0001,   /* UniqueMediaAccessId */
   0, 0,             /* Hardware revision */
-  6, 0,             /* Firmware revision */
+  7, 0,             /* Firmware revision */
   0, 0,             /* FPGAFirmware revision */
-  NR_OF_OBJECTS-1,  /* NumberOfObjects, default without enable word clock */
+  NR_OF_OBJECTS,    /* NumberOfObjects */
   0,                /* DefaultEngineAddr */
   {0,0,0},          /* Hardwareparent */
   0                 /* Service request */
 };
 
+/* Route cache: MambaNet address -> bitmask of the interfaces on which the
+ * address is online. Maintained by AddressTableChange() so ReceiveMessage()
+ * doesn't have to ask every interface for each unicast message. Entries are
+ * never removed, only their mask is cleared, addresses are reused anyway. */
+#define ROUTE_CACHE_SIZE 4096 /* power of two, assume < 2000 nodes */
+
+struct route_entry {
+  unsigned long addr;
+  unsigned char mask;
+};
+
+struct route_entry route_cache[ROUTE_CACHE_SIZE];
+pthread_rwlock_t route_lock = PTHREAD_RWLOCK_INITIALIZER;
+
 struct mbn_handler *unx, *eth, *can, *tcp, *udp;
-int verbose;
-char ieth[50], data_path[1000];
+int verbose, extclock;
+char ieth[50], data_path[1000], stats_path[UNIX_PATH_MAX];
 unsigned int net_ip, net_mask, net_gw;
 
+const char *if_names[IF_COUNT] = { "CAN", "Ethernet", "TCP", "UDP", "Unix" };
+
+struct mbn_handler *if_handler(int);
+
+
+/* Updates a sensor object on all interfaces */
+void sensor_all(int obj, unsigned long val) {
+  union mbn_data dat;
+  dat.UInt = val;
+  obj += 1024;
+  if(can != NULL) mbnUpdateSensorData(can, obj, dat);
+  if(unx != NULL) mbnUpdateSensorData(unx, obj, dat);
+  if(eth != NULL) mbnUpdateSensorData(eth, obj, dat);
+  if(tcp != NULL) mbnUpdateSensorData(tcp, obj, dat);
+  if(udp != NULL) mbnUpdateSensorData(udp, obj, dat);
+}
+
+
+/* Publishes the traffic statistics, called once a second */
+void stats_update() {
+  static unsigned long prev_msgtype[STATS_MSGTYPES];
+  struct stats_percentiles lat;
+  struct can_data *cdat;
+  unsigned long cur;
+  int i, obj;
+
+  if(can != NULL) {
+    cdat = (struct can_data *)can->itf->data;
+    stats_if[IF_CAN].rx_frames = cdat->rxframes;
+    stats_if[IF_CAN].tx_frames = cdat->txframes;
+    stats_if[IF_CAN].queue = cdat->txcount;
+    sensor_all(OBJ_CANRXFRAMES, cdat->rxframes);
+    sensor_all(OBJ_CANTXFRAMES, cdat->txframes);
+  }
+
+  for(i=0; i<IF_COUNT; i++) {
+    if(if_handler(i) == NULL)
+      continue;
+    obj = OBJ_IFSTATS + i*OBJ_IFSTATS_COUNT;
+    sensor_all(obj+OBJ_IF_RXMSG,   stats_if[i].rx_msg);
+    sensor_all(obj+OBJ_IF_TXMSG,   stats_if[i].tx_msg);
+    sensor_all(obj+OBJ_IF_RXBYTES, stats_if[i].rx_bytes);
+    sensor_all(obj+OBJ_IF_TXBYTES, stats_if[i].tx_bytes);
+    sensor_all(obj+OBJ_IF_DROPS,   stats_if[i].drops);
+    sensor_all(obj+OBJ_IF_QUEUE,   stats_if[i].queue);
+  }
+
+  for(i=0; i<STATS_MSGTYPES; i++) {
+    cur = stats_msgtype[i];
+    sensor_all(OBJ_ADDRMSGRATE+i, cur-prev_msgtype[i]);
+    prev_msgtype[i] = cur;
+  }
+
+  stats_latency_interval(&lat);
+  sensor_all(OBJ_LATENCYP50, lat.p50);
+  sensor_all(OBJ_LATENCYP99, lat.p99);
+  sensor_all(OBJ_LATENCYMAX, lat.max);
+}
+
+
 void *timer_thread_loop(void *arg) {
   struct timeval timeout;
   int CurrentLinkStatus = 0;
   int LinkStatus = 0;
+  int StatsTicks = 0;
   timeout.tv_sec = 0;
   timeout.tv_usec = 10000;
   char err[MBN_ERRSIZE];
@@ -95,7 +198,7 @@ void *timer_thread_loop(void *arg) {
     if ((ReturnValue == 0) || ((ReturnValue<0) && (errno == EINTR))) {
       //upon SIGALARM this happens :(
     } else if (ReturnValue<0) { //error
-      log_write("select() failed: %s\n", strerror(errno));
+      log_write_level(LOG_LEVEL_ERROR, "select() failed: %s\n", strerror(errno));
     }
     if ((timeout.tv_sec == 0) && (timeout.tv_usec == 0)) {
       if (eth != NULL) {
@@ -105,6 +208,10 @@ void *timer_thread_loop(void *arg) {
           CurrentLinkStatus = LinkStatus;
         }
       }
+      if(++StatsTicks >= 100) {
+        StatsTicks = 0;
+        stats_update();
+      }
       timeout.tv_sec = 0;
       timeout.tv_usec = 10000;
     }
@@ -186,7 +293,7 @@ void SynchroniseDateTime(struct mbn_handler *mbn, time_t time) {
 
 int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_data dat) {
   object -= 1024;
-  if(object > OBJ_EXTCLOCK)
+  if(object > OBJ_EXTCLOCK || (object == OBJ_EXTCLOCK && !extclock))
     return 1;
 
   if (object < OBJ_EXTCLOCK) {
@@ -265,7 +372,85 @@ void OnlineStatus(struct mbn_handler *mbn, unsigned long addr, char valid) {
 }
 
 
+struct mbn_handler *if_handler(int i) {
+  switch(i) {
+    case IF_CAN: return can;
+    case IF_ETH: return eth;
+    case IF_TCP: return tcp;
+    case IF_UDP: return udp;
+    case IF_UNX: return unx;
+  }
+  return NULL;
+}
+
+
+int if_index(struct mbn_handler *mbn) {
+  return (mbn == can) ? IF_CAN : ((mbn == eth) ? IF_ETH : ((mbn == tcp) ? IF_TCP : ((mbn == udp) ? IF_UDP : IF_UNX)));
+}
+
+
+/* returns the slot of addr in the route cache, or the empty slot where
+ * it should be inserted, or -1 if the cache is full. Requires route_lock. */
+int route_slot(unsigned long addr) {
+  unsigned int i, n;
+  i = (addr * 2654435761UL) & (ROUTE_CACHE_SIZE-1);
+  for(n=0; n<ROUTE_CACHE_SIZE; n++, i = (i+1) & (ROUTE_CACHE_SIZE-1))
+    if(route_cache[i].addr == 0 || route_cache[i].addr == addr)
+      return i;
+  return -1;
+}
+
+
+void route_update(struct mbn_handler *mbn, unsigned long addr, char online) {
+  int i;
+
+  if(addr == 0)
+    return;
+  pthread_rwlock_wrlock(&route_lock);
+  if((i = route_slot(addr)) < 0) {
+    pthread_rwlock_unlock(&route_lock);
+    log_write_limit(LOG_LEVEL_WARNING, 10, "Route cache full, can't add address %08lX", addr);
+    return;
+  }
+  route_cache[i].addr = addr;
+  if(online)
+    route_cache[i].mask |= 1<<if_index(mbn);
+  else
+    route_cache[i].mask &= ~(1<<if_index(mbn));
+  pthread_rwlock_unlock(&route_lock);
+}
+
+
+/* returns the preferred interface on which addr is online, or NULL */
+struct mbn_handler *route_lookup(unsigned long addr) {
+  unsigned char mask = 0;
+  int i;
+
+  pthread_rwlock_rdlock(&route_lock);
+  if((i = route_slot(addr)) >= 0 && route_cache[i].addr == addr)
+    mask = route_cache[i].mask;
+  pthread_rwlock_unlock(&route_lock);
+
+  for(i=0; i<IF_COUNT; i++)
+    if(mask & (1<<i))
+      return if_handler(i);
+  return NULL;
+}
+
+
+/* Forwards the message as it was received. MBN_SEND_NOCREATE makes libmbn
+ * send the received raw buffer instead of re-encoding it for each interface,
+ * and libmbn looks up the interface address of the destination and calls
+ * the transmit callback under its own lock. */
+void forward(struct mbn_handler *dest, struct mbn_message *msg) {
+  mbnSendMessage(dest, msg, MBN_SEND_IGNOREVALID | MBN_SEND_FORCEADDR | MBN_SEND_NOCREATE | MBN_SEND_FORCEID);
+  stats_tx(if_index(dest), msg->rawlength);
+}
+
+
+/* transmit errors are reported here, count them as dropped */
 void Error(struct mbn_handler *mbn, int code, char *msg) {
+  stats_drop(if_index(mbn));
   if(verbose)
     printf("Error(%s, %d, \"%s\")\n", nodestr(mbn), code, msg);
 }
@@ -278,24 +463,19 @@ void WriteLogMessage(struct mbn_handler *mbn, char *msg) {
 
 int ReceiveMessage(struct mbn_handler *mbn, struct mbn_message *msg) {
   struct mbn_handler *dest = NULL;
+  struct timeval start, end;
   int i;
 
+  gettimeofday(&start, NULL);
+  stats_rx(if_index(mbn), msg->MessageType, msg->rawlength);
+
   /* don't forward anything that's targeted to us */
   if(msg->AddressTo == this_node.MambaNetAddr)
     return 0;
 
   /* figure out to which interface we need to send */
   if(msg->AddressTo != MBN_BROADCAST_ADDRESS) {
-    if(can != NULL && mbnNodeStatus(can, msg->AddressTo) != NULL)
-      dest = can;
-    else if(eth != NULL && mbnNodeStatus(eth, msg->AddressTo) != NULL)
-      dest = eth;
-    else if(tcp != NULL && mbnNodeStatus(tcp, msg->AddressTo) != NULL)
-      dest = tcp;
-    else if(udp != NULL && mbnNodeStatus(udp, msg->AddressTo) != NULL)
-      dest = udp;
-    else if(unx != NULL && mbnNodeStatus(unx, msg->AddressTo) != NULL)
-      dest = unx;
+    dest = route_lookup(msg->AddressTo);
 
     /* don't forward if the destination is on the same network, except for unx (unix sockets and tcp?) */
     if((dest == mbn) && ((dest != unx) && (dest != udp)))
@@ -312,7 +492,7 @@ int ReceiveMessage(struct mbn_handler *mbn, struct mbn_message *msg) {
   }
 
   /* forward message */
-#define fwd(m) mbnSendMessage(m, msg, MBN_SEND_IGNOREVALID | MBN_SEND_FORCEADDR | MBN_SEND_NOCREATE | MBN_SEND_FORCEID)
+#define fwd(m) forward(m, msg)
   if(dest != NULL)
     fwd(dest);
   else {
@@ -327,6 +507,9 @@ int ReceiveMessage(struct mbn_handler *mbn, struct mbn_message *msg) {
     if(unx != NULL && mbn != unx) fwd(unx);
   }
 #undef fwd
+
+  gettimeofday(&end, NULL);
+  stats_latency((end.tv_sec-start.tv_sec)*1000000 + end.tv_usec-start.tv_usec);
   return 0;
 }
 
@@ -337,8 +520,17 @@ void AddressTableChange(struct mbn_handler *mbn, struct mbn_address_node *old, s
   int obj;
   count.UInt = 0;
 
-  if(old && new)
+  if(old && new) {
+    if(old->MambaNetAddr != new->MambaNetAddr) {
+      route_update(mbn, old->MambaNetAddr, 0);
+      route_update(mbn, new->MambaNetAddr, 1);
+    }
     return;
+  }
+  if(old)
+    route_update(mbn, old->MambaNetAddr, 0);
+  if(new)
+    route_update(mbn, new->MambaNetAddr, 1);
 
   while((n = mbnNextNode(mbn, n)) != NULL)
     count.UInt++;
@@ -389,6 +581,43 @@ void process_unix(char *path) {
 }
 
 
+/* Local statistics socket, each client gets a text dump of the counters */
+void *stats_thread_loop(void *arg) {
+  struct sockaddr_un p;
+  const char *names[IF_COUNT];
+  int sock, client, i;
+  FILE *f;
+
+  p.sun_family = AF_UNIX;
+  strcpy(p.sun_path, stats_path);
+  unlink(stats_path);
+
+  if((sock = socket(PF_UNIX, SOCK_STREAM, 0)) < 0) {
+    log_write_level(LOG_LEVEL_ERROR, "Opening statistics socket: %s", strerror(errno));
+    return NULL;
+  }
+  if(bind(sock, (struct sockaddr *)&p, sizeof(struct sockaddr_un)) < 0 || listen(sock, 5) < 0) {
+    log_write_level(LOG_LEVEL_ERROR, "Binding statistics socket: %s", strerror(errno));
+    close(sock);
+    return NULL;
+  }
+
+  while((client = accept(sock, NULL, NULL)) >= 0) {
+    for(i=0; i<IF_COUNT; i++)
+      names[i] = if_handler(i) != NULL ? if_names[i] : NULL;
+    if((f = fdopen(client, "w")) == NULL) {
+      close(client);
+      continue;
+    }
+    stats_print(f, names);
+    fclose(f);
+  }
+  log_write_level(LOG_LEVEL_ERROR, "Accepting connections on statistics socket: %s", strerror(errno));
+  return NULL;
+  arg = NULL;
+}
+
+
 void setcallbacks(struct mbn_handler *mbn) {
   mbnSetErrorCallback(mbn, Error);
   mbnSetOnlineStatusCallback(mbn, OnlineStatus);
@@ -404,6 +633,8 @@ void init(int argc, char **argv, char *upath) {
   struct mbn_interface *itf = NULL;
   struct mbn_object obj[NR_OF_OBJECTS];
   char err[MBN_ERRSIZE], ican[50], tport[10], uport[10], iunix[UNIX_PATH_MAX];
+  char objname[32];
+  int i, j;
   char u_remotehost[50], u_remoteport[10];
   char t_remotehost[50], t_remoteport[10];
   int c, itfcount = 0;
@@ -418,9 +649,10 @@ void init(int argc, char **argv, char *upath) {
   strcpy(log_file, DEFAULT_LOG_FILE);
   ican[0] = ieth[0] = tport[0] = uport[0] = u_remotehost[0] = u_remoteport[0] = t_remotehost[0] = t_remoteport[0] = 0;
   unx = can = eth = tcp = udp = NULL;
-  verbose = 0;
+  verbose = extclock = 0;
+  stats_path[0] = 0;
 
-  while((c = getopt(argc, argv, "c:e:u:m:t:s:h:r:d:i:p:l:vw")) != -1) {
+  while((c = getopt(argc, argv, "c:e:u:m:t:s:h:r:d:i:p:l:L:S:vw")) != -1) {
     switch(c) {
       /* can interface */
       case 'c':
@@ -537,17 +769,31 @@ void init(int argc, char **argv, char *upath) {
       case 'l':
         strcpy(log_file, optarg);
         break;
+      case 'L':
+        if((log_level = log_level_parse(optarg)) < 0) {
+          fprintf(stderr, "Invalid log level\n");
+          exit(1);
+        }
+        break;
+      /* statistics socket */
+      case 'S':
+        if(strlen(optarg) >= UNIX_PATH_MAX) {
+          fprintf(stderr, "Too long path to statistics socket!\n");
+          exit(1);
+        }
+        strcpy(stats_path, optarg);
+        break;
       /* verbose */
       case 'v':
         verbose++;
         break;
       /* add word clock object */
       case 'w':
-        this_node.NumberOfObjects++;
+        extclock = 1;
         break;
       /* wrong option */
       default:
-        fprintf(stderr, "Usage: %s [-v] [-c dev] [-e dev] [-t port] [-s port] [-h hostname:port] [-r hostname:port] [-m path] [-u path] [-d path] [-i id] [-p id]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-v] [-c dev] [-e dev] [-t port] [-s port] [-h hostname:port] [-r hostname:port] [-m path] [-u path] [-d path] [-i id] [-p id] [-l path] [-L level] [-S path]\n", argv[0]);
         fprintf(stderr, "  -v                Print verbose output to stdout\n");
         fprintf(stderr, "  -c dev            CAN device or TTY device\n");
         fprintf(stderr, "  -e dev            Ethernet device\n");
@@ -561,7 +807,9 @@ void init(int argc, char **argv, char *upath) {
         fprintf(stderr, "  -p id             Hardware Parent (not specified = from CAN, 'self' = own ID)\n");
         fprintf(stderr, "  -i id             UniqueIDPerProduct for the MambaNet node\n");
         fprintf(stderr, "  -l path           Path to log file.\n");
-        fprintf(stderr, "  -w                Add word clock object\n");
+        fprintf(stderr, "  -L level          Log level: error, warning, info or debug (default info)\n");
+        fprintf(stderr, "  -w                Enable word clock object\n");
+        fprintf(stderr, "  -S path           Path to local statistics UNIX socket\n");
         exit(1);
     }
   }
@@ -597,6 +845,29 @@ void init(int argc, char **argv, char *upath) {
   obj[OBJ_UDPNODES] = MBN_OBJ("UDP Online Nodes", MBN_DATATYPE_UINT, 0, 2, 0, 1000, 0, MBN_DATATYPE_NODATA);
   obj[OBJ_UNXNODES] = MBN_OBJ("Unix Online Nodes", MBN_DATATYPE_UINT, 0, 2, 0, 1000, 0, MBN_DATATYPE_NODATA);
   obj[OBJ_EXTCLOCK] = MBN_OBJ("Enable word clock", MBN_DATATYPE_NODATA, MBN_DATATYPE_STATE, 1, 0, 1, 0, 0);
+  for(i=0; i<IF_COUNT; i++) {
+    j = OBJ_IFSTATS + i*OBJ_IFSTATS_COUNT;
+    sprintf(objname, "%s RX Messages", if_names[i]);
+    obj[j+OBJ_IF_RXMSG]   = MBN_OBJ(objname, MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+    sprintf(objname, "%s TX Messages", if_names[i]);
+    obj[j+OBJ_IF_TXMSG]   = MBN_OBJ(objname, MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+    sprintf(objname, "%s RX Bytes", if_names[i]);
+    obj[j+OBJ_IF_RXBYTES] = MBN_OBJ(objname, MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+    sprintf(objname, "%s TX Bytes", if_names[i]);
+    obj[j+OBJ_IF_TXBYTES] = MBN_OBJ(objname, MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+    sprintf(objname, "%s Dropped Messages", if_names[i]);
+    obj[j+OBJ_IF_DROPS]   = MBN_OBJ(objname, MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+    sprintf(objname, "%s TX Queue Depth", if_names[i]);
+    obj[j+OBJ_IF_QUEUE]   = MBN_OBJ(objname, MBN_DATATYPE_UINT, 0, 2, 0, 10000, 0, MBN_DATATYPE_NODATA);
+  }
+  obj[OBJ_CANRXFRAMES]  = MBN_OBJ("CAN RX Frames", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+  obj[OBJ_CANTXFRAMES]  = MBN_OBJ("CAN TX Frames", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+  obj[OBJ_ADDRMSGRATE]  = MBN_OBJ("Address Messages/s", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+  obj[OBJ_OBJMSGRATE]   = MBN_OBJ("Object Messages/s", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+  obj[OBJ_OTHERMSGRATE] = MBN_OBJ("Other Messages/s", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+  obj[OBJ_LATENCYP50]   = MBN_OBJ("Forward Latency P50 (us)", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+  obj[OBJ_LATENCYP99]   = MBN_OBJ("Forward Latency P99 (us)", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
+  obj[OBJ_LATENCYMAX]   = MBN_OBJ("Forward Latency Max (us)", MBN_DATATYPE_UINT, 0, 4, 0, ~0, 0, MBN_DATATYPE_NODATA);
 
   if(!verbose)
     daemonize();
@@ -823,6 +1094,12 @@ int main(int argc, char **argv) {
   pthread_t timer_thread;
   pthread_create(&timer_thread, NULL, timer_thread_loop, NULL);
 
+  if(stats_path[0]) {
+    log_write("Start statistics socket on %s", stats_path);
+    pthread_t stats_thread;
+    pthread_create(&stats_thread, NULL, stats_thread_loop, NULL);
+  }
+
   process_unix(upath);
 
   log_write("Closing gateway");
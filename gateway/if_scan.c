@@ -6,6 +6,7 @@
 #include <unistd.h>
 #include <pthread.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <sys/select.h>
@@ -15,6 +16,7 @@
 #include <linux/can.h>
 
 #include <termios.h>
+#include <linux/serial.h>
 
 #include "mbn.h"
 #include "if_scan.h"
@@ -32,6 +34,8 @@
 #define CAN_TXDELAY   1024 /* delay between each CAN frame transmit in us (with bursts for MambaNet messages) */
 #define TTY_TXDELAY   1024 /* delay between each CAN frame transmit in us (with bursts for MambaNet messages) */
 #define HWPARTIMEOUT  10   /* timeout for receiving the hardware parent, in seconds */
+#define TTYTXFRAMES   64   /* maximum number of CAN frames combined in one TTY write */
+#define TTYPOLLTIMEOUT 100 /* ms */
 //#define CIRBUFLENGTH  4096 /* Length of serial decoding buffer */
 
 struct can_ifaddr;
@@ -62,7 +66,10 @@ int scan_parse(struct can_frame *frame, struct mbn_interface *itf);
 
 void *scan_receive(void *);
 int scan_read(struct can_frame *frame, struct mbn_interface *itf);
+int scan_read_tty(struct can_data *dat);
 void scan_write(struct can_frame *frame, struct mbn_interface *itf);
+void scan_encode_tty(struct can_frame *frame, unsigned char *buf, unsigned char flags);
+void scan_write_tty(struct can_data *dat, unsigned char *buf, int len);
 void scan_write_parent(struct can_frame *frame, struct mbn_interface *itf);
 
 struct mbn_interface * MBN_EXPORT mbnCANOpen(char *ifname, unsigned short *parent, char *err) {
@@ -147,8 +154,10 @@ int scan_open_sock(char *ifname, struct can_data *dat, char *err) {
 int scan_open_tty(char *ifname, struct can_data *dat, char *err) {
   struct termios tio;
 
+  struct serial_struct ser;
+
   /* open serial device */
-  dat->fd = open(ifname, O_RDWR | O_NOCTTY);
+  dat->fd = open(ifname, O_RDWR | O_NOCTTY | O_NONBLOCK);
   if (dat->fd<0) {
     sprintf(err, "Couldn't open port: %s", strerror(errno));
     return 1;
@@ -173,8 +182,9 @@ int scan_open_tty(char *ifname, struct can_data *dat, char *err) {
   tio.c_cflag |= (CLOCAL | CREAD);
   tio.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
   tio.c_oflag &= ~OPOST;
-  tio.c_cc[VMIN] = 0;
-  tio.c_cc[VTIME] = 10;
+  /* reads are non-blocking after poll(), return whatever is available */
+  tio.c_cc[VMIN] = 1;
+  tio.c_cc[VTIME] = 0;
 
   /* make raw */
   tio.c_iflag &= ~(IGNBRK|BRKINT|PARMRK|ISTRIP|INLCR|IGNCR|ICRNL|IXON);
@@ -185,6 +195,13 @@ int scan_open_tty(char *ifname, struct can_data *dat, char *err) {
     close(dat->fd);
     return 1;
   }
+
+  /* don't let the UART driver hold back received bytes, not all drivers
+   * support this, so ignore errors */
+  if(ioctl(dat->fd, TIOCGSERIAL, &ser) == 0) {
+    ser.flags |= ASYNC_LOW_LATENCY;
+    ioctl(dat->fd, TIOCSSERIAL, &ser);
+  }
   dat->txdly = TTY_TXDELAY;
   return 0;
 }
@@ -229,7 +246,11 @@ int scan_hwparent(struct mbn_interface *itf, unsigned short *par, char *err) {
   while(1) {
     FD_ZERO(&rd);
     FD_SET(desc, &rd);
-    n = select(desc+1, &rd, NULL, NULL, &tv);
+    /* frames of a previous TTY read may still be waiting */
+    if(dat->tty_mode && dat->rxqb != dat->rxqt)
+      n = 1;
+    else
+      n = select(desc+1, &rd, NULL, NULL, &tv);
     /* handle errors */
     if(n < 0) {
       sprintf(err, "Checking read state: %s", strerror(errno));
@@ -360,7 +381,8 @@ void *scan_send(void *ptr) {
   struct can_queue *q;
   struct timeval tv;
   time_t lastparent = 0, now;
-  int i;
+  unsigned char ttybuf[TTYTXFRAMES*TTYRECLEN];
+  int i, frames, ttylen;
 
   tv.tv_sec = 0;
   tv.tv_usec = 10000;
@@ -380,10 +402,13 @@ void *scan_send(void *ptr) {
       scan_write_parent(&frame, itf);
       lastparent = now;
     }
-    /* send messages from the queue */
+    /* send messages from the queue, on a TTY all frames of as many messages
+     * as fit in ttybuf are combined in a single write() */
     pthread_mutex_lock(dat->txmutex);
-    q = dat->tx[dat->txstart];
-    if(q != NULL) {
+    frames = ttylen = 0;
+    while((q = dat->tx[dat->txstart]) != NULL) {
+      if(dat->tty_mode && frames > 0 && frames+q->length/8+1 > TTYTXFRAMES)
+        break;
       frame.can_id = q->canid | CAN_EFF_FLAG;
       frame.can_dlc = 8;
       for(i=0; i<=q->length/8; i++) {
@@ -391,15 +416,29 @@ void *scan_send(void *ptr) {
         frame.can_id |= i;
         memset((void *)frame.data, 0, 8);
         memcpy((void *)frame.data, &(q->buf[i*8]), i*8+8 > q->length ? q->length-i*8 : 8);
-        scan_write(&frame, itf);
+        if(dat->tty_mode) {
+          scan_encode_tty(&frame, &(ttybuf[ttylen]), 0);
+          ttylen += TTYRECLEN;
+        } else
+          scan_write(&frame, itf);
+        dat->txframes++;
       }
+      frames += i;
       dat->tx[dat->txstart] = NULL;
+      dat->txcount--;
       if(++dat->txstart >= TXBUFLEN)
         dat->txstart = 0;
       free(q->buf);
       free(q);
+      /* CAN sockets are paced per message */
+      if(!dat->tty_mode)
+        break;
+    }
+    if(ttylen > 0)
+      scan_write_tty(dat, ttybuf, ttylen);
+    if(frames > 0) {
       tv.tv_sec = 0;
-      tv.tv_usec = dat->txdly*i;
+      tv.tv_usec = dat->txdly*frames;
     } else {
       tv.tv_sec = 0;
       tv.tv_usec = 10000;
@@ -434,6 +473,7 @@ int scan_transmit(struct mbn_interface *itf, unsigned char *buffer, int length,
   memcpy(dat->tx[i]->buf, buffer, length);
   dat->tx[i]->canid = ifaddr ? (0x00000010 | (((struct can_ifaddr *)ifaddr)->addr << 16)) : 0x10000010;
   dat->tx[i]->length = length;
+  dat->txcount++;
   pthread_mutex_unlock(dat->txmutex);
   return 0;
 }
@@ -447,6 +487,7 @@ void *scan_receive(void *ptr) {
   {
     if (scan_read(&frame, itf) == sizeof(struct can_frame))
     {
+      ((struct can_data *)itf->data)->rxframes++;
       scan_parse(&frame, itf);
     }
   }
@@ -455,56 +496,105 @@ void *scan_receive(void *ptr) {
 }
 
 
+/* TTY record parser. A record is 0xE0, 11 bytes (ID + data), 0xE1. Each
+ * received byte is classified, and the class and the number of bytes
+ * collected so far select the next state from tty_next[]. State 0 is
+ * hunting for a start byte, 1-12 the number of bytes collected. */
+#define TTY_DATA  0
+#define TTY_START 1
+#define TTY_END   2
+#define TTY_EMIT  0x80 /* flag in tty_next[]: record complete */
+
+static unsigned char tty_class[256];
+static unsigned char tty_next[TTYRECLEN][3];
+static pthread_once_t tty_table_once = PTHREAD_ONCE_INIT;
+
+static void scan_tty_table() {
+  int st;
+
+  memset(tty_class, TTY_DATA, sizeof(tty_class));
+  tty_class[0xE0] = TTY_START;
+  tty_class[0xE1] = TTY_END;
+  for(st=0; st<TTYRECLEN; st++) {
+    tty_next[st][TTY_START] = 1; /* always (re)start a record */
+    if(st == 0) {
+      tty_next[st][TTY_DATA] = tty_next[st][TTY_END] = 0;
+    } else if(st < TTYRECLEN-1) {
+      tty_next[st][TTY_DATA] = tty_next[st][TTY_END] = st+1;
+    } else {
+      /* 13th byte must be the end byte */
+      tty_next[st][TTY_DATA] = 0;
+      tty_next[st][TTY_END] = 0 | TTY_EMIT;
+    }
+  }
+}
+
+
+/* bulk read from the TTY and decode all complete records into the
+ * rx queue, returns the number of frames decoded, 0 on timeout or -1 on error */
+int scan_read_tty(struct can_data *dat) {
+  unsigned char rcvbuf[TTYRDLEN];
+  unsigned char st = dat->msgstate, nx, c;
+  struct can_frame *frame;
+  struct pollfd p;
+  int n, i, frames = 0, space;
+
+  pthread_once(&tty_table_once, scan_tty_table);
+
+  p.fd = dat->fd;
+  p.events = POLLIN;
+  if((n = poll(&p, 1, TTYPOLLTIMEOUT)) <= 0)
+    return n < 0 && errno != EINTR ? -1 : 0;
+
+  /* don't read more than the queue can hold */
+  space = (dat->rxqb - dat->rxqt - 1 + TTYRXQLEN) % TTYRXQLEN;
+  if(space == 0)
+    return 0;
+  n = read(dat->fd, rcvbuf, space*TTYRECLEN < TTYRDLEN ? space*TTYRECLEN : TTYRDLEN);
+  if(n < 0)
+    return errno == EAGAIN || errno == EINTR ? 0 : -1;
+
+  for(i=0; i<n; i++) {
+    c = rcvbuf[i];
+    nx = tty_next[st][tty_class[c]];
+    if(tty_class[c] == TTY_START)
+      dat->msgbuf[0] = c;
+    else if(st > 0)
+      dat->msgbuf[st] = c;
+    if(st == TTYRECLEN-1 && tty_class[c] == TTY_DATA)
+      fprintf(stderr, "Error in format of TTY message\n");
+    if(nx & TTY_EMIT) {
+      frame = &(dat->rxq[dat->rxqt]);
+      //check for can control msg
+      if(dat->msgbuf[1]&0x40)
+        frame->can_id = 0x0FFFFFF1;
+      else
+        frame->can_id = 0x10000 | ((dat->msgbuf[1]&0x1F)<<11) | ((dat->msgbuf[2]&0x7F)<<4) | (dat->msgbuf[3]&0x0F);
+      frame->can_dlc = 8;
+      memcpy(frame->data, &(dat->msgbuf[4]), 8);
+      if(++dat->rxqt >= TTYRXQLEN)
+        dat->rxqt = 0;
+      frames++;
+    }
+    st = nx & ~TTY_EMIT;
+  }
+  dat->msgstate = st;
+  return frames;
+}
+
+
 /* CAN/TTY send/receive wrapper functions */
 int scan_read(struct can_frame *frame, struct mbn_interface *itf) {
   struct can_data *dat = (struct can_data *)itf->data;
-  unsigned char rcvbuf[128];
-  unsigned char rcvbyte;
-  int n, i, i2;
+  int n;
 
   if(dat->tty_mode) {
-    if (dat->cirbuft == dat->cirbufb) {
-      n = read(dat->fd, &rcvbuf, 128);
-      for(i=0; i<n; i++) {
-        dat->cirbuf[dat->cirbuft++]=rcvbuf[i];
-        if (dat->cirbuft>(CIRBUFLENGTH-1))
-          dat->cirbuft=0;
-      }
-    }
-
-    n = 0;
-    while ((n==0) && (dat->cirbufb != dat->cirbuft))
-    {
-      rcvbyte = dat->cirbuf[dat->cirbufb++];
-      if (dat->cirbufb>(CIRBUFLENGTH-1))
-        dat->cirbufb=0;
-
-      if(rcvbyte == 0xE0)
-        dat->msgbufi=0;
-      if(dat->msgbufi<13)
-        dat->msgbuf[dat->msgbufi++] = rcvbyte;
-      else {
-          fprintf(stderr, "Error in format of TTY message\n");
-          dat->msgbufi=14;
-        }
-      if((rcvbyte == 0xE1) && (dat->msgbufi==13)) {
-        //check for can control msg
-        if(dat->msgbuf[1]&0x40) {
-          frame->can_id = 0x0FFFFFF1;
-        }
-        else {
-          frame->can_id = dat->msgbuf[1]&0x1F;
-          frame->can_id <<= 7;
-          frame->can_id |= dat->msgbuf[2]&0x7F;
-          frame->can_id <<= 4;
-          frame->can_id |= dat->msgbuf[3]&0x0F;
-          frame->can_id |= 0x10000;
-        }
-        for (i2=0; i2<8; i2++)
-          frame->data[i2] = dat->msgbuf[4+i2];
-        n = sizeof(struct can_frame);
-      }
-    }
+    if(dat->rxqb == dat->rxqt && (n = scan_read_tty(dat)) <= 0)
+      return n;
+    memcpy(frame, &(dat->rxq[dat->rxqb]), sizeof(struct can_frame));
+    if(++dat->rxqb >= TTYRXQLEN)
+      dat->rxqb = 0;
+    n = sizeof(struct can_frame);
   }
   else {
     if (((n = read(dat->sock, frame, sizeof(struct can_frame))) < 0) && (n != (int)sizeof(struct can_frame))) {
@@ -515,22 +605,45 @@ int scan_read(struct can_frame *frame, struct mbn_interface *itf) {
 }
 
 
+void scan_encode_tty(struct can_frame *frame, unsigned char *buf, unsigned char flags) {
+  buf[0] = 0xE0;
+  buf[1] = flags | ((frame->can_id>>23)&0x1F);
+  buf[2] = (frame->can_id>>16)&0x7F;
+  buf[3] = frame->can_id&0x0F;
+  memcpy(&(buf[4]), frame->data, 8);
+  buf[12] = 0xE1;
+}
+
+
+/* writes all of buf to the (non-blocking) TTY */
+void scan_write_tty(struct can_data *dat, unsigned char *buf, int len) {
+  struct pollfd p;
+  int n;
+
+  p.fd = dat->fd;
+  p.events = POLLOUT;
+  while(len > 0) {
+    if((n = write(dat->fd, buf, len)) < 0) {
+      if(errno != EAGAIN && errno != EINTR) {
+        fprintf(stderr, "TTY send: %s", strerror(errno));
+        return;
+      }
+      poll(&p, 1, TTYPOLLTIMEOUT);
+      continue;
+    }
+    buf += n;
+    len -= n;
+  }
+}
+
+
 void scan_write(struct can_frame *frame, struct mbn_interface *itf) {
   struct can_data *dat = (struct can_data *)itf->data;
-  unsigned char xmtbuf[13];
-  unsigned char i;
+  unsigned char xmtbuf[TTYRECLEN];
 
   if(dat->tty_mode) {
-    xmtbuf[0] = 0xE0;
-    xmtbuf[1] = (frame->can_id>>23)&0x1F;
-    xmtbuf[2] = (frame->can_id>>16)&0x7F;
-    xmtbuf[3] = frame->can_id&0x0F;
-    for (i=0; i<8; i++)
-      xmtbuf[4+i] = frame->data[i];
-    xmtbuf[12] = 0xE1;
-
-    if (write(dat->fd, xmtbuf, 13) < 13)
-      fprintf(stderr, "TTY send: %s", strerror(errno));
+    scan_encode_tty(frame, xmtbuf, 0);
+    scan_write_tty(dat, xmtbuf, TTYRECLEN);
   }
   else {
     if(write(dat->sock, (void *)frame, sizeof(struct can_frame)) < (int)sizeof(struct can_frame))
@@ -540,24 +653,14 @@ void scan_write(struct can_frame *frame, struct mbn_interface *itf) {
 
 void scan_write_parent(struct can_frame *frame, struct mbn_interface *itf) {
   struct can_data *dat = (struct can_data *)itf->data;
-  unsigned char xmtbuf[13];
-  unsigned char i;
+  unsigned char xmtbuf[TTYRECLEN];
 
   if(dat->tty_mode) {
-    xmtbuf[0] = 0xE0;
-    xmtbuf[1] = 0x40 | ((frame->can_id>>23)&0x1F);
-    xmtbuf[2] = (frame->can_id>>16)&0x7F;
-    xmtbuf[3] = frame->can_id&0x0F;
-    for (i=0; i<8; i++)
-      xmtbuf[4+i] = frame->data[i];
-    xmtbuf[12] = 0xE1;
-
-    if (write(dat->fd, xmtbuf, 13) < 13)
-      fprintf(stderr, "TTY send parent: %s", strerror(errno));
+    scan_encode_tty(frame, xmtbuf, 0x40);
+    scan_write_tty(dat, xmtbuf, TTYRECLEN);
   }
   else {
     if(write(dat->sock, (void *)frame, sizeof(struct can_frame)) < (int)sizeof(struct can_frame))
       fprintf(stderr, "CAN send parent: %s", strerror(errno));
   }
 }
-
@@ -5,10 +5,13 @@ struct mbn_interface * MBN_EXPORT mbnCANOpen(char *, unsigned short *, char *);
 
 //Required here to determine tty mode for setting RTS = extern clock on/off
 #include <pthread.h>
+#include <linux/can.h>
 
 #define ADDLSTSIZE    1000 /* assume we don't have more than 1000 nodes on one CAN bus */
 #define TXBUFLEN      8000 /* maxumum number of mambanet messages in the send buffer */
-#define CIRBUFLENGTH  8192 /* Length of serial decoding buffer */
+#define TTYRDLEN      4096 /* maximum number of bytes read from the TTY at once */
+#define TTYRXQLEN     512  /* decoded frames waiting to be parsed, must hold TTYRDLEN/13 */
+#define TTYRECLEN     13   /* length of one framed CAN record on the TTY */
 
 struct can_data {
   unsigned char tty_mode;
@@ -21,11 +24,14 @@ struct can_data {
   int txstart;
   struct can_ifaddr *addrs[ADDLSTSIZE];
   struct can_queue *tx[TXBUFLEN];
-  unsigned char msgbuf[13];
-  unsigned char msgbufi;
-  unsigned char cirbuf[CIRBUFLENGTH];
-  unsigned int cirbufb, cirbuft;
+  unsigned char msgbuf[TTYRECLEN];
+  unsigned char msgstate; /* TTY record parser state */
+  struct can_frame rxq[TTYRXQLEN];
+  unsigned int rxqb, rxqt;
   unsigned short *parent;
+  /* statistics, only read by the gateway */
+  unsigned long rxframes, txframes;
+  int txcount; /* number of messages in the tx queue */
 };
 
 #endif
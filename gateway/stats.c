@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2009 D&R Electronica Weesp B.V. All rights reserved.
+**
+** This file is part of the Axum/MambaNet digital mixing system.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "stats.h"
+#include <string.h>
+
+struct stats_interface stats_if[STATS_INTERFACES];
+unsigned long stats_msgtype[STATS_MSGTYPES];
+struct stats_latency stats_fwd;
+struct stats_latency stats_fwd_prev;
+struct stats_percentiles stats_fwd_last;
+
+#define atomic_add(v, n) __sync_fetch_and_add(&(v), (n))
+#define atomic_get(v) __sync_fetch_and_add(&(v), 0)
+
+void stats_rx(int itf, int msgtype, int bytes) {
+  atomic_add(stats_if[itf].rx_msg, 1);
+  atomic_add(stats_if[itf].rx_bytes, bytes);
+  atomic_add(stats_msgtype[msgtype < STATS_MSGTYPES-1 ? msgtype : STATS_MSGTYPES-1], 1);
+}
+
+
+void stats_tx(int itf, int bytes) {
+  atomic_add(stats_if[itf].tx_msg, 1);
+  atomic_add(stats_if[itf].tx_bytes, bytes);
+}
+
+
+void stats_drop(int itf) {
+  atomic_add(stats_if[itf].drops, 1);
+}
+
+
+void stats_latency(unsigned long usec) {
+  unsigned long max;
+  int b = 0;
+
+  while(b < STATS_BUCKETS-1 && (usec >> b) > 0)
+    b++;
+  atomic_add(stats_fwd.bucket[b], 1);
+
+  /* lock-free maximum */
+  while((max = stats_fwd.max) < usec)
+    if(__sync_bool_compare_and_swap(&stats_fwd.max, max, usec))
+      break;
+}
+
+
+/* upper bound of the bucket that contains the requested sample */
+unsigned long stats_bucket_value(unsigned long *delta, unsigned long samples, int percent) {
+  unsigned long want = (samples*percent + 99) / 100, sum = 0;
+  int b;
+
+  for(b=0; b<STATS_BUCKETS; b++) {
+    sum += delta[b];
+    if(sum >= want)
+      return b == 0 ? 0 : 1UL << b;
+  }
+  return 1UL << STATS_BUCKETS;
+}
+
+
+void stats_latency_interval(struct stats_percentiles *p) {
+  unsigned long delta[STATS_BUCKETS], cur;
+  int b;
+
+  p->samples = 0;
+  for(b=0; b<STATS_BUCKETS; b++) {
+    cur = atomic_get(stats_fwd.bucket[b]);
+    delta[b] = cur - stats_fwd_prev.bucket[b];
+    stats_fwd_prev.bucket[b] = cur;
+    p->samples += delta[b];
+  }
+  /* reset the maximum for the next interval */
+  p->max = __sync_lock_test_and_set(&stats_fwd.max, 0);
+
+  if(p->samples == 0) {
+    p->p50 = p->p90 = p->p99 = 0;
+  } else {
+    p->p50 = stats_bucket_value(delta, p->samples, 50);
+    p->p90 = stats_bucket_value(delta, p->samples, 90);
+    p->p99 = stats_bucket_value(delta, p->samples, 99);
+  }
+  memcpy(&stats_fwd_last, p, sizeof(struct stats_percentiles));
+}
+
+
+void stats_print(FILE *f, const char **names) {
+  int i;
+
+  fprintf(f, "interface    rx_msg    tx_msg   rx_bytes   tx_bytes rx_frames tx_frames  drops  queue\n");
+  for(i=0; i<STATS_INTERFACES; i++) {
+    if(names[i] == NULL)
+      continue;
+    fprintf(f, "%-9s %9lu %9lu %10lu %10lu %9lu %9lu %6lu %6lu\n", names[i],
+      atomic_get(stats_if[i].rx_msg), atomic_get(stats_if[i].tx_msg),
+      atomic_get(stats_if[i].rx_bytes), atomic_get(stats_if[i].tx_bytes),
+      atomic_get(stats_if[i].rx_frames), atomic_get(stats_if[i].tx_frames),
+      atomic_get(stats_if[i].drops), stats_if[i].queue);
+  }
+  fprintf(f, "\nmessages: address %lu, object %lu, other %lu\n",
+    atomic_get(stats_msgtype[0]), atomic_get(stats_msgtype[1]), atomic_get(stats_msgtype[2]));
+  fprintf(f, "forward latency (last interval, us): p50 <%lu, p90 <%lu, p99 <%lu, max %lu, %lu samples\n",
+    stats_fwd_last.p50, stats_fwd_last.p90, stats_fwd_last.p99, stats_fwd_last.max, stats_fwd_last.samples);
+}
@@ -0,0 +1,64 @@
+/****************************************************************************
+**
+** Copyright (C) 2009 D&R Electronica Weesp B.V. All rights reserved.
+**
+** This file is part of the Axum/MambaNet digital mixing system.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef _stats_h
+#define _stats_h
+
+#include <stdio.h>
+
+/* Traffic statistics of the gateway. All counters are only ever increased
+ * with atomic adds, so they can be updated from the receive threads of all
+ * interfaces without locking, and read at any time by the timer thread. */
+
+#define STATS_INTERFACES 5  /* same order as the IF_* defines in gateway.c */
+#define STATS_MSGTYPES   3  /* address, object, other */
+#define STATS_BUCKETS    24 /* latency histogram, bucket n = [2^(n-1), 2^n) us */
+
+struct stats_interface {
+  unsigned long rx_msg, tx_msg;
+  unsigned long rx_bytes, tx_bytes;
+  unsigned long rx_frames, tx_frames;
+  unsigned long drops;
+  unsigned long queue; /* not a counter, last known tx queue depth */
+};
+
+struct stats_latency {
+  unsigned long bucket[STATS_BUCKETS];
+  unsigned long max;
+};
+
+extern struct stats_interface stats_if[STATS_INTERFACES];
+extern unsigned long stats_msgtype[STATS_MSGTYPES];
+extern struct stats_latency stats_fwd;
+
+void stats_rx(int itf, int msgtype, int bytes);
+void stats_tx(int itf, int bytes);
+void stats_drop(int itf);
+/* forwarding latency in microseconds */
+void stats_latency(unsigned long usec);
+
+/* Takes a snapshot of the histogram, and returns the requested percentile
+ * (0-100) in microseconds of all samples since the previous snapshot.
+ * Only to be called from a single thread. */
+struct stats_percentiles {
+  unsigned long p50, p90, p99, max, samples;
+};
+void stats_latency_interval(struct stats_percentiles *);
+
+/* Writes a human readable dump of all counters */
+void stats_print(FILE *, const char **names);
+
+#endif
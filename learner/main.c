@@ -7,12 +7,19 @@
 #include <unistd.h>
 
 #include <sys/select.h>
+#include <sys/time.h>
 
 #include <mbn.h>
 #include <libpq-fe.h>
 #include <pthread.h>
 
-#define GET_NUM 5 /* maxumum number of concurrent requests */
+#define GET_NUM 5 /* initial number of concurrent requests */
+#define GET_NUM_MAX 32 /* maximum number of concurrent requests */
+#define GET_LATENCY 250 /* ms, grow the window while responses are faster than this */
+#define GET_HASH_SIZE 256 /* power of two */
+#define NODE_HASH_MIN 128 /* power of two */
+#define TEMPLATE_BATCH 64 /* maximum number of template rows per INSERT */
+#define TEMPLATE_COLUMNS 15
 #define DEBUG 0
 
 #define DEFAULT_UNIX_MAMBANET_PATH "/tmp/axum-gateway.socket"
@@ -36,24 +43,44 @@ struct mbn_node_info this_node = {
 };
 struct mbn_handler *mbn;
 
+/* Requests wait in a FIFO (get_queue) until there is room in the window,
+ * and are then moved to the get_active hash table until the response,
+ * error or acknowledge timeout arrives. */
 struct get_action {
   char act; /* 0=get sensor data, 1=get object information */
   unsigned long addr;
   unsigned short object;
-  char active;
+  struct timeval sent;
   struct get_action *next;
 };
-struct get_action *get_queue = NULL;
+struct get_action *get_queue = NULL, *get_queue_last = NULL;
+struct get_action *get_active[GET_HASH_SIZE];
+int get_active_count = 0;
+/* number of concurrent requests, adapted to the response time */
+double get_window = GET_NUM;
 /* deadlock warning: don't use sql_lock() within this mutex */
 pthread_mutex_t get_queue_mutex;
 
+/* one row for the templates table, NULL columns have null[i] set */
+struct template_row {
+  char str[TEMPLATE_COLUMNS][34];
+  char null[TEMPLATE_COLUMNS];
+};
+
 /* simple node info list, temporary place for getting the number
- * ob objects and firmware major revision */
+ * ob objects and firmware major revision, and for collecting the
+ * template rows of a node until all of its object information arrived */
 struct node_info {
   unsigned long addr;
   int objects, fwmajor;
+  int infos; /* outstanding object information requests */
+  struct template_row *rows;
+  int rowsl, rowsn;
 } *nodes = NULL;
 int nodesl = 0;
+/* addr -> index+1 in nodes, open addressing, size is a power of two >= 2*nodesl */
+int *nodes_hash = NULL;
+int nodes_hashl = 0;
 
 
 char *data2str(unsigned char type, union mbn_data dat) {
@@ -88,102 +115,268 @@ void minmax(char *res, unsigned char type, union mbn_data dat) {
 }
 
 
+#define get_hash(addr, obj) ((((addr)*31) ^ (obj)) & (GET_HASH_SIZE-1))
+
+int node_hash_slot(unsigned long addr) {
+  int i = (addr * 2654435761UL) & (nodes_hashl-1);
+  while(nodes_hash[i] != 0 && nodes[nodes_hash[i]-1].addr != addr)
+    i = (i+1) & (nodes_hashl-1);
+  return i;
+}
+
+
+void node_hash_rebuild() {
+  int i;
+  free(nodes_hash);
+  for(nodes_hashl=NODE_HASH_MIN; nodes_hashl<nodesl*2; nodes_hashl*=2)
+    ;
+  nodes_hash = calloc(nodes_hashl, sizeof(int));
+  for(i=0; i<nodesl; i++)
+    if(nodes[i].addr != 0)
+      nodes_hash[node_hash_slot(nodes[i].addr)] = i+1;
+}
+
+
+/* returns the index in nodes, or -1 if the address isn't known */
+int find_node(unsigned long addr) {
+  int i;
+  pthread_mutex_lock(&get_queue_mutex);
+  i = nodes_hash[node_hash_slot(addr)]-1;
+  pthread_mutex_unlock(&get_queue_mutex);
+  return i;
+}
+
+
 void add_queue(char act, unsigned long addr, unsigned short obj) {
-  struct get_action **last;
+  struct get_action *a;
+  int n;
+
+  a = calloc(1, sizeof(struct get_action));
+  a->act = act;
+  a->addr = addr;
+  a->object = obj;
   pthread_mutex_lock(&get_queue_mutex);
-  last = &get_queue;
-  while(*last != NULL)
-    last = &((*last)->next);
-  *last = calloc(1, sizeof(struct get_action));
-  (*last)->act = act;
-  (*last)->addr = addr;
-  (*last)->object = obj;
+  if(get_queue_last == NULL)
+    get_queue = a;
+  else
+    get_queue_last->next = a;
+  get_queue_last = a;
+  if(act == 1 && (n = find_node(addr)) >= 0)
+    nodes[n].infos++;
   pthread_mutex_unlock(&get_queue_mutex);
 }
 
 
 void process_queue() {
   struct get_action *a;
-  int i, active=0, sent=0;
+  int sent=0, h;
 
   pthread_mutex_lock(&get_queue_mutex);
-  for(a=get_queue,i=0; a!=NULL&&i<GET_NUM; a=a->next,i++) {
-    if(a->active != 0) {
-      active++;
-      continue;
-    }
-    if (this_node.Services&0x80) {
-      sent++;
-      if(a->act == 0)
-        mbnGetSensorData(mbn, a->addr, a->object, 1);
-      else
-        mbnGetObjectInformation(mbn, a->addr, a->object, 1);
-      if(DEBUG)
-        log_write("GET: %08lX[%5d] %s", a->addr, a->object, a->act ? "object information" : "sensor data");
-      a->active = 1;
-    }
+  while(get_queue != NULL && get_active_count < (int)get_window && (this_node.Services&0x80)) {
+    a = get_queue;
+    if((get_queue = a->next) == NULL)
+      get_queue_last = NULL;
+
+    h = get_hash(a->addr, a->object);
+    a->next = get_active[h];
+    get_active[h] = a;
+    get_active_count++;
+    gettimeofday(&(a->sent), NULL);
+
+    sent++;
+    if(a->act == 0)
+      mbnGetSensorData(mbn, a->addr, a->object, 1);
+    else
+      mbnGetObjectInformation(mbn, a->addr, a->object, 1);
+    if(DEBUG)
+      log_write("GET: %08lX[%5d] %s", a->addr, a->object, a->act ? "object information" : "sensor data");
   }
   pthread_mutex_unlock(&get_queue_mutex);
   if(DEBUG) {
-    if (active != 0) {
-      log_write("active = %d, sent = %d", active, sent);
+    if (sent != 0) {
+      log_write("active = %d, sent = %d, window = %.1f", get_active_count, sent, get_window);
     }
   }
 }
 
 
-int remove_queue(unsigned long addr, unsigned short obj) {
-  struct get_action *n, *last;
+/* Removes an active request, adapting the window to the response time
+ * (timeout = 1 means the request wasn't answered). Returns 0 if no such
+ * request is active. */
+int remove_queue(unsigned long addr, unsigned short obj, char timeout) {
+  struct get_action **a, *n;
+  struct timeval now;
+  long ms;
   int i;
 
   pthread_mutex_lock(&get_queue_mutex);
-  for(n=last=get_queue,i=0; n!=NULL&&i<GET_NUM; n=n->next,i++) {
-    if(n->active == 1 && n->addr == addr && n->object == obj)
+  for(a=&(get_active[get_hash(addr, obj)]); *a!=NULL; a=&((*a)->next))
+    if((*a)->addr == addr && (*a)->object == obj)
       break;
-    last = n;
-  }
-  if(n == NULL || i == GET_NUM) {
+  if(*a == NULL) {
     pthread_mutex_unlock(&get_queue_mutex);
     return 0;
   }
-
-  if(get_queue == n)
-    get_queue = n->next;
+  n = *a;
+  *a = n->next;
+  get_active_count--;
+
+  /* slow start while responses are fast, back off when the node or
+   * network can't keep up */
+  gettimeofday(&now, NULL);
+  ms = (now.tv_sec-n->sent.tv_sec)*1000 + (now.tv_usec-n->sent.tv_usec)/1000;
+  if(timeout)
+    get_window /= 2;
+  else if(ms < GET_LATENCY)
+    get_window += 1;
   else
-    last->next = n->next;
+    get_window -= 1;
+  if(get_window < 1)
+    get_window = 1;
+  if(get_window > GET_NUM_MAX)
+    get_window = GET_NUM_MAX;
+
+  if(n->act == 1 && (i = find_node(addr)) >= 0)
+    nodes[i].infos--;
+  free(n);
   pthread_mutex_unlock(&get_queue_mutex);
 
   return 1;
 }
 
 
+/* removes all waiting and active requests for a node */
+void remove_node_queue(unsigned long addr) {
+  struct get_action **a, *n;
+  int h, i;
+
+  pthread_mutex_lock(&get_queue_mutex);
+  get_queue_last = NULL;
+  for(a=&get_queue; *a!=NULL; ) {
+    if((*a)->addr == addr) {
+      n = *a;
+      *a = n->next;
+      free(n);
+    } else {
+      get_queue_last = *a;
+      a = &((*a)->next);
+    }
+  }
+  for(h=0; h<GET_HASH_SIZE; h++)
+    for(a=&(get_active[h]); *a!=NULL; ) {
+      if((*a)->addr == addr) {
+        n = *a;
+        *a = n->next;
+        free(n);
+        get_active_count--;
+      } else
+        a = &((*a)->next);
+    }
+  if((i = find_node(addr)) >= 0)
+    nodes[i].infos = 0;
+  pthread_mutex_unlock(&get_queue_mutex);
+}
+
+
+/* Inserts n template rows with a single INSERT inside a savepoint, so a
+ * failing row only rolls back this statement and not the transaction.
+ * Must be called within sql_lock(). Returns 0 on success. */
+int insert_templates(struct template_row *rows, int n) {
+  const char *params[TEMPLATE_BATCH*TEMPLATE_COLUMNS];
+  char query[TEMPLATE_BATCH*100+300], *q;
+  int j, k;
+  PGresult *res;
+
+  q = query + sprintf(query, "INSERT INTO templates (man_id, prod_id, firm_major, number, description, services, sensor_type, sensor_size,\
+    sensor_min, sensor_max, actuator_type, actuator_size, actuator_min, actuator_max, actuator_def) VALUES");
+  for(j=0; j<n; j++) {
+    for(k=0; k<TEMPLATE_COLUMNS; k++) {
+      params[j*TEMPLATE_COLUMNS+k] = rows[j].null[k] ? NULL : (const char *)rows[j].str[k];
+      q += sprintf(q, "%s$%d", k ? ", " : (j ? ", (" : " ("), j*TEMPLATE_COLUMNS+k+1);
+    }
+    q += sprintf(q, ")");
+  }
+
+  if((res = sql_exec("SAVEPOINT templates", 0, 0, NULL)) != NULL)
+    PQclear(res);
+  if((res = sql_exec(query, 0, n*TEMPLATE_COLUMNS, params)) == NULL) {
+    if((res = sql_exec("ROLLBACK TO SAVEPOINT templates", 0, 0, NULL)) != NULL)
+      PQclear(res);
+    return -1;
+  }
+  PQclear(res);
+  if((res = sql_exec("RELEASE SAVEPOINT templates", 0, 0, NULL)) != NULL)
+    PQclear(res);
+  return 0;
+}
+
+
+/* Writes the collected template rows of a node with multi-row INSERTs.
+ * When a batch fails its rows are inserted one by one, so a single bad
+ * row doesn't lose the others. Only writes when all object information
+ * has been received, unless force is set. Must not be called with
+ * get_queue_mutex locked. */
+void flush_templates(unsigned long addr, char force) {
+  struct template_row *rows;
+  int i, j, n, rowsn, failed = 0;
+
+  pthread_mutex_lock(&get_queue_mutex);
+  if((n = find_node(addr)) < 0 || nodes[n].rowsn == 0 || (!force && nodes[n].infos > 0 && nodes[n].rowsn < TEMPLATE_BATCH)) {
+    pthread_mutex_unlock(&get_queue_mutex);
+    return;
+  }
+  rows = nodes[n].rows;
+  rowsn = nodes[n].rowsn;
+  nodes[n].rows = NULL;
+  nodes[n].rowsn = nodes[n].rowsl = 0;
+  pthread_mutex_unlock(&get_queue_mutex);
+
+  sql_lock(1);
+  for(i=0; i<rowsn; i+=TEMPLATE_BATCH) {
+    n = rowsn-i < TEMPLATE_BATCH ? rowsn-i : TEMPLATE_BATCH;
+    if(insert_templates(rows+i, n) == 0)
+      continue;
+    for(j=0; j<n; j++)
+      if(insert_templates(rows+i+j, 1) != 0)
+        failed++;
+  }
+  sql_lock(0);
+  if(failed)
+    log_write_level(LOG_LEVEL_WARNING, "Stored %d template objects of %08lX, %d failed", rowsn-failed, addr, failed);
+  else
+    log_write("Stored %d template objects of %08lX", rowsn, addr);
+  free(rows);
+}
+
+
 int add_node(unsigned long addr) {
   int i;
 
   pthread_mutex_lock(&get_queue_mutex);
   /* first, check if it's already in the list */
-  for(i=0; i<nodesl; i++)
-    if(nodes[i].addr == addr)
-      break;
+  i = find_node(addr);
   /* otherwise, get a free slot */
-  if(i == nodesl)
+  if(i < 0)
     for(i=0; i<nodesl; i++)
       if(nodes[i].addr == 0)
         break;
   /* no free slot? reserve more memory */
   if(i == nodesl) {
     nodes = realloc(nodes, sizeof(struct node_info)*nodesl*2);
-    memset((void *)nodes+nodesl, 0, sizeof(struct node_info)*nodesl);
+    memset((void *)(nodes+nodesl), 0, sizeof(struct node_info)*nodesl);
     nodesl *= 2;
+    node_hash_rebuild();
   }
   /* set address and reset fwmajor and objects */
   nodes[i].addr = addr;
   nodes[i].fwmajor = nodes[i].objects = -1;
+  nodes_hash[node_hash_slot(addr)] = i+1;
 
   /* and now get the major firmware version and number of objects */
   add_queue(0, addr, MBN_NODEOBJ_FWMAJOR);
   add_queue(0, addr, MBN_NODEOBJ_NUMBEROFOBJECTS);
   pthread_mutex_unlock(&get_queue_mutex);
+  process_queue();
   return i;
 }
 
@@ -202,22 +395,14 @@ void mOnlineStatus(struct mbn_handler *m, unsigned long addr, char valid) {
 }
 
 void mAddressTableChange(struct mbn_handler *m, struct mbn_address_node *old, struct mbn_address_node *new) {
-  struct get_action *n, *a;
-
   /* online */
   if(old == NULL && new != NULL)
     add_node(new->MambaNetAddr);
 
-  /* offline */
+  /* offline, store what we have and forget the rest */
   if(old != NULL && new == NULL) {
-    /* remove all queued get operations (this method isn't the most efficient) */
-    pthread_mutex_lock(&get_queue_mutex);
-    for(n=get_queue; n!=NULL; n=a) {
-      a = n->next;
-      if(n->addr == old->MambaNetAddr)
-        remove_queue(n->addr, n->object);
-    }
-    pthread_mutex_unlock(&get_queue_mutex);
+    remove_node_queue(old->MambaNetAddr);
+    flush_templates(old->MambaNetAddr, 1);
   }
   return;
   m++;
@@ -233,17 +418,15 @@ int mSensorDataResponse(struct mbn_handler *m, struct mbn_message *msg, unsigned
 
   log_write("SensorDataResponse: %08lX[%5d] = (%2d) %s", msg->AddressFrom, obj, type, data2str(type, dat));
 
-  if(!remove_queue(msg->AddressFrom, obj))
+  if(!remove_queue(msg->AddressFrom, obj, 0))
     return 1;
+  process_queue();
   if((node = mbnNodeStatus(mbn, msg->AddressFrom)) == NULL)
     return 1;
 
   /* we should receive both firmware and number of objects, wait
    * for the other to arrive if we only have one of the values */
-  for(n=0; n<nodesl; n++)
-    if(nodes[n].addr == msg->AddressFrom)
-      break;
-  if(n == nodesl)
+  if((n = find_node(msg->AddressFrom)) < 0)
     return 1;
 
   if(obj == MBN_NODEOBJ_FWMAJOR)
@@ -285,6 +468,7 @@ int mSensorDataResponse(struct mbn_handler *m, struct mbn_message *msg, unsigned
     add_queue(1, msg->AddressFrom, n);
   }
   PQclear(res);
+  process_queue();
 
   /* delete any objects outside the range, which might have been inserted
    * by someone else or because of a change in the node */
@@ -300,29 +484,25 @@ int mSensorDataResponse(struct mbn_handler *m, struct mbn_message *msg, unsigned
 
 int mObjectInformationResponse(struct mbn_handler *m, struct mbn_message *msg, unsigned short obj, struct mbn_object *nfo) {
   struct mbn_address_node *node;
-  char str[15][34];
-  const char *params[15];
-  int i, fwmajor = -1;
+  struct template_row row;
+  char (*str)[34] = row.str;
+  int n, fwmajor = -1;
 
   /* the lacking -e is intentional, to make the log aligned with the other messages */
   log_write("InformationRespons: %08lX[%5d]", msg->AddressFrom, obj);
-  if(!remove_queue(msg->AddressFrom, obj))
+  if(!remove_queue(msg->AddressFrom, obj, 0))
     return 1;
+  process_queue();
 
   /* get firmware major revision and node information */
-  for(i=0; i<nodesl; i++)
-    if(nodes[i].addr == msg->AddressFrom) {
-      fwmajor = nodes[i].fwmajor;
-      break;
-    }
-  if(i == nodesl)
+  if((n = find_node(msg->AddressFrom)) < 0)
     return 1;
+  fwmajor = nodes[n].fwmajor;
   if((node = mbnNodeStatus(mbn, msg->AddressFrom)) == NULL)
     return 1;
 
-  /* create params list */
-  for(i=0; i<15; i++)
-    params[i] = (const char *)str[i];
+  /* create row */
+  memset(row.null, 0, TEMPLATE_COLUMNS);
   sprintf(str[0], "%hd", node->ManufacturerID);
   sprintf(str[1], "%hd", node->ProductID);
   sprintf(str[2], "%hd", (short)fwmajor);
@@ -331,7 +511,7 @@ int mObjectInformationResponse(struct mbn_handler *m, struct mbn_message *msg, u
   sprintf(str[5], "%hd", nfo->Services);
   sprintf(str[6], "%hd", nfo->SensorType);
   if(nfo->SensorType == MBN_DATATYPE_NODATA)
-    params[7] = params[8] = params[9] = NULL;
+    row.null[7] = row.null[8] = row.null[9] = 1;
   else {
     sprintf(str[7], "%d", nfo->SensorSize);
     minmax(str[8], nfo->SensorType, nfo->SensorMin);
@@ -339,7 +519,7 @@ int mObjectInformationResponse(struct mbn_handler *m, struct mbn_message *msg, u
   }
   sprintf(str[10], "%hd", nfo->ActuatorType);
   if(nfo->ActuatorType == MBN_DATATYPE_NODATA)
-    params[11] = params[12] = params[13] = params[14] = NULL;
+    row.null[11] = row.null[12] = row.null[13] = row.null[14] = 1;
   else {
     sprintf(str[11], "%d", nfo->ActuatorSize);
     minmax(str[12], nfo->ActuatorType, nfo->ActuatorMin);
@@ -347,11 +527,15 @@ int mObjectInformationResponse(struct mbn_handler *m, struct mbn_message *msg, u
     minmax(str[14], nfo->ActuatorType, nfo->ActuatorDefault);
   }
 
-  sql_lock(1);
-  sql_exec("INSERT INTO templates (man_id, prod_id, firm_major, number, description, services, sensor_type, sensor_size,\
-    sensor_min, sensor_max, actuator_type, actuator_size, actuator_min, actuator_max, actuator_def)\
-    VALUES($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, $12, $13, $14, $15)", 0, 15, params);
-  sql_lock(0);
+  /* collect the row, the rows of a node are written at once */
+  pthread_mutex_lock(&get_queue_mutex);
+  if(nodes[n].rowsn == nodes[n].rowsl) {
+    nodes[n].rowsl = nodes[n].rowsl ? nodes[n].rowsl*2 : 32;
+    nodes[n].rows = realloc(nodes[n].rows, sizeof(struct template_row)*nodes[n].rowsl);
+  }
+  memcpy(&(nodes[n].rows[nodes[n].rowsn++]), &row, sizeof(struct template_row));
+  pthread_mutex_unlock(&get_queue_mutex);
+  flush_templates(msg->AddressFrom, 0);
 
   return 0;
   m++;
@@ -359,17 +543,21 @@ int mObjectInformationResponse(struct mbn_handler *m, struct mbn_message *msg, u
 
 
 void mAcknowledgeTimeout(struct mbn_handler *m, struct mbn_message *msg) {
-  log_write("AcknowledgeTimeout: %08lX[%5d] get %s", msg->AddressTo, msg->Message.Object.Number,
+  log_write_level(LOG_LEVEL_WARNING, "AcknowledgeTimeout: %08lX[%5d] get %s", msg->AddressTo, msg->Message.Object.Number,
     msg->Message.Object.Action == MBN_OBJ_ACTION_GET_INFO ? "object information" : "sensor data");
-  remove_queue(msg->AddressTo, msg->Message.Object.Number);
+  remove_queue(msg->AddressTo, msg->Message.Object.Number, 1);
+  process_queue();
+  flush_templates(msg->AddressTo, 0);
   return;
   m++;
 }
 
 
 void mObjectError(struct mbn_handler *m, struct mbn_message *msg, unsigned short obj, char *err) {
-  log_write("ObjectError       : %08lX[%5d] = %s", msg->AddressFrom, obj, err);
-  remove_queue(msg->AddressFrom, obj);
+  log_write_level(LOG_LEVEL_WARNING, "ObjectError       : %08lX[%5d] = %s", msg->AddressFrom, obj, err);
+  remove_queue(msg->AddressFrom, obj, 0);
+  process_queue();
+  flush_templates(msg->AddressFrom, 0);
   return;
   m++;
 }
@@ -420,7 +608,7 @@ void init(int argc, char *argv[]) {
   strcpy(hwparent_path, DEFAULT_UNIX_HWPARENT_PATH);
   strcpy(socket_path, DEFAULT_UNIX_MAMBANET_PATH);
 
-  while((c = getopt(argc, argv, "e:d:l:g:i:")) != -1) {
+  while((c = getopt(argc, argv, "e:d:l:L:g:i:")) != -1) {
     switch(c) {
       case 'e':
         if(strlen(optarg) > 50) {
@@ -443,6 +631,12 @@ void init(int argc, char *argv[]) {
       case 'l':
         strcpy(log_file, optarg);
         break;
+      case 'L':
+        if((log_level = log_level_parse(optarg)) < 0) {
+          fprintf(stderr, "Invalid log level\n");
+          exit(1);
+        }
+        break;
       case 'i':
         if(sscanf(optarg, "%hd", &(this_node.UniqueIDPerProduct)) != 1) {
           fprintf(stderr, "Invalid UniqueIDPerProduct");
@@ -450,10 +644,11 @@ void init(int argc, char *argv[]) {
         }
         break;
       default:
-        fprintf(stderr, "Usage: %s [-e dev] [-g path] [-l path] [-d str] [-i id]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-e dev] [-g path] [-l path] [-L level] [-d str] [-i id]\n", argv[0]);
         fprintf(stderr, "  -e dev   Ethernet device for MambaNet communication.\n");
         fprintf(stderr, "  -g path  Hardware parent or path to gateway socket.\n");
         fprintf(stderr, "  -l path  Path to log file.\n");
+        fprintf(stderr, "  -L level Log level: error, warning, info or debug (default info).\n");
         fprintf(stderr, "  -d str   PostgreSQL database connection options.\n");
         fprintf(stderr, "  -i id    UniqueIDPerProduct for the MambaNet node\n");
         exit(1);
@@ -528,6 +723,7 @@ int main(int argc, char *argv[]) {
   /* init nodes list */
   nodesl = 50;
   nodes = calloc(nodesl, sizeof(struct node_info));
+  node_hash_rebuild();
 
   init(argc, argv);
 
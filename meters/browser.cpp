@@ -31,8 +31,6 @@
 #include "chasewidget.h"
 #include "common.h"
 
-extern QMutex qt_mutex;
-
 Browser::Browser(QWidget *parent)
     : QWidget(parent)
 {
@@ -74,6 +72,90 @@ Browser::Browser(QWidget *parent)
 
 	cntSecond = 0;
 
+  PPMMeters[0] = NewDNRPPMMeter;
+  PPMMeters[1] = NewDNRPPMMeter_2;
+  PPMMeters[2] = NewDNRPPMMeter_3;
+  PPMMeters[3] = NewDNRPPMMeter_4;
+  PPMMeters[4] = NewDNRPPMMeter_5;
+  PPMMeters[5] = NewDNRPPMMeter_6;
+  PPMMeters[6] = NewDNRPPMMeter_7;
+  PPMMeters[7] = NewDNRPPMMeter_8;
+  PPMMeters[8] = NewDNRPPMMeter_9;
+  PPMMeters[9] = NewDNRPPMMeter_10;
+  PPMMeters[10] = NewSmallDNRPPMMeter_1;
+  PPMMeters[11] = NewSmallDNRPPMMeter_2;
+  PPMMeters[12] = NewSmallDNRPPMMeter_3;
+  PPMMeters[13] = NewSmallDNRPPMMeter_4;
+  PPMMeters[14] = NewSmallDNRPPMMeter_5;
+  PPMMeters[15] = NewSmallDNRPPMMeter_6;
+  PPMMeters[16] = NewSmallDNRPPMMeter_7;
+  PPMMeters[17] = NewSmallDNRPPMMeter_8;
+  PPMMeters[18] = NewSmallDNRPPMMeter_9;
+  PPMMeters[19] = NewSmallDNRPPMMeter_10;
+  PPMMeters[20] = NewSmallDNRPPMMeter_11;
+  PPMMeters[21] = NewSmallDNRPPMMeter_12;
+  PPMMeters[22] = NewSmallDNRPPMMeter_13;
+  PPMMeters[23] = NewSmallDNRPPMMeter_14;
+  PPMMeters[24] = NewSmallDNRPPMMeter_15;
+  PPMMeters[25] = NewSmallDNRPPMMeter_16;
+  PPMMeters[26] = NewSmallDNRPPMMeter_17;
+  PPMMeters[27] = NewSmallDNRPPMMeter_18;
+  PPMMeters[28] = NewSmallDNRPPMMeter_19;
+  PPMMeters[29] = NewSmallDNRPPMMeter_20;
+  PPMMeters[30] = NewSmallDNRPPMMeter_21;
+  PPMMeters[31] = NewSmallDNRPPMMeter_22;
+  PPMMeters[32] = NewSmallDNRPPMMeter_23;
+  PPMMeters[33] = NewSmallDNRPPMMeter_24;
+  PPMMeters[34] = NewSmallDNRPPMMeter_25;
+  PPMMeters[35] = NewSmallDNRPPMMeter_26;
+  PPMMeters[36] = NewSmallDNRPPMMeter_27;
+  PPMMeters[37] = NewSmallDNRPPMMeter_28;
+  PPMMeters[38] = NewSmallDNRPPMMeter_29;
+  PPMMeters[39] = NewSmallDNRPPMMeter_30;
+  PPMMeters[40] = NewSmallDNRPPMMeter_31;
+  PPMMeters[41] = NewSmallDNRPPMMeter_32;
+  PPMMeters[42] = NewSmallDNRPPMMeter_33;
+  PPMMeters[43] = NewSmallDNRPPMMeter_34;
+  PPMMeters[44] = NewSmallDNRPPMMeter_35;
+  PPMMeters[45] = NewSmallDNRPPMMeter_36;
+  PPMMeters[46] = NewSmallDNRPPMMeter_37;
+  PPMMeters[47] = NewSmallDNRPPMMeter_38;
+  PPMMeters[48] = NewSmallDNRPPMMeter_39;
+  PPMMeters[49] = NewSmallDNRPPMMeter_40;
+  PPMMeters[50] = NewSmallDNRPPMMeter_41;
+  PPMMeters[51] = NewSmallDNRPPMMeter_42;
+  PPMMeters[52] = NewSmallDNRPPMMeter_43;
+  PPMMeters[53] = NewSmallDNRPPMMeter_44;
+  PPMMeters[54] = NewSmallDNRPPMMeter_45;
+  PPMMeters[55] = NewSmallDNRPPMMeter_46;
+  PPMMeters[56] = NewSmallDNRPPMMeter_47;
+  PPMMeters[57] = NewSmallDNRPPMMeter_48;
+  PPMMeters[58] = NewSmallDNRPPMMeter_49;
+  PPMMeters[59] = NewSmallDNRPPMMeter_50;
+  PPMMeters[60] = NewSmallDNRPPMMeter_51;
+  PPMMeters[61] = NewSmallDNRPPMMeter_52;
+  PPMMeters[62] = NewSmallDNRPPMMeter_53;
+  PPMMeters[63] = NewSmallDNRPPMMeter_54;
+  PPMMeters[64] = NewSmallDNRPPMMeter_55;
+  PPMMeters[65] = NewSmallDNRPPMMeter_56;
+  PPMMeters[66] = NewSmallDNRPPMMeter_57;
+  PPMMeters[67] = NewSmallDNRPPMMeter_58;
+  PPMMeters[68] = NewSmallDNRPPMMeter_59;
+  PPMMeters[69] = NewSmallDNRPPMMeter_60;
+  PPMMeters[70] = NewSmallDNRPPMMeter_61;
+  PPMMeters[71] = NewSmallDNRPPMMeter_62;
+  PPMMeters[72] = NewSmallDNRPPMMeter_63;
+  PPMMeters[73] = NewSmallDNRPPMMeter_64;
+
+  //Ballistics run on elapsed time, the mode, release per second and peak hold
+  //time are taken from the meters on every update so property changes apply
+  //directly
+  Ballistics = new DNRBallistics(74, -50);
+  PreviousReleaseTime = DNRBallistics::MonotonicTime();
+
+  //Skins may show a range of the channels in a meter bridge
+  MeterBridges = findChildren<DNRMeterBridge *>();
+
   frame->setVisible(true);
 
 	startTimer(30);
@@ -82,6 +164,8 @@ Browser::Browser(QWidget *parent)
   {
     MeterData[cnt] = -50;
   }
+  PhaseMeterData[0] = 0;
+  PhaseMeterData[1] = 0;
 
   sprintf(Label[0],"Meter 1 ");
   sprintf(Label[1],"  ----  ");
@@ -184,9 +268,12 @@ Browser::Browser(QWidget *parent)
 
 Browser::~Browser()
 {
+  delete Ballistics;
 }
 
 extern char CheckLinkStatus();
+extern void ProcessActuatorQueue();
+extern void ReadMeterSnapshot(double *MeterData, double *PhaseMeterData);
 
 void IntToTimerString(char *timer_str, int elapsed_time)
 {
@@ -220,7 +307,7 @@ void Browser::timerEvent(QTimerEvent *Event)
 
 	cntSecond++;
 
-  qt_mutex.lock();
+  ProcessActuatorQueue();
 
   if (CurrentInitProgress != InitProgress)
   {
@@ -334,35 +421,19 @@ void Browser::timerEvent(QTimerEvent *Event)
       }
     }
   }
-  qt_mutex.unlock();
 
   return;
   Event = NULL;
 }
 
-#define RELEASE_STEP 0.45
-void CalculatePPMRelease(DNRPPMMeter *PPMMeter, double *CurrentMeterData)
+void CalculatePPMRelease(DNRPPMMeter *PPMMeter, float Level, float PeakLevel)
 {
-  float Difference;
-
-  if ((PPMMeter->FdBPosition>-50) || (*CurrentMeterData>-50))
+  if ((PPMMeter->FdBPosition != Level) || (PPMMeter->FPeakdBPosition != PeakLevel))
   {
-    Difference = *CurrentMeterData-PPMMeter->FdBPosition;
-
-    if (Difference < -RELEASE_STEP)
-    {
-      Difference = -RELEASE_STEP;
-		}
-
-    if (Difference != 0)
-    {
-      PPMMeter->FdBPosition += Difference;
-      if (PPMMeter->CalculateMeter())
-      {
-        PPMMeter->update();
-      }
-    }
-	}
+    PPMMeter->FdBPosition = Level;
+    PPMMeter->FPeakdBPosition = PeakLevel;
+    PPMMeter->CalculateMeter();
+  }
 }
 
 void Browser::MeterRelease()
@@ -387,97 +458,59 @@ void Browser::MeterRelease()
 //	printf("time:%g - delta: %g\n", newNumberOfSeconds, elapsedTime);
 */
 //  #define RELEASE_STEP 0.15
-  #define PHASE_STEPSIZE 0.0075*4
+  #define PHASE_PER_SECOND 1.0
+  double Now = DNRBallistics::MonotonicTime();
+  double ElapsedTime = Now-PreviousReleaseTime;
+  PreviousReleaseTime = Now;
+  if (ElapsedTime > BALLISTICS_MAX_STEP)
+  {
+    ElapsedTime = BALLISTICS_MAX_STEP;
+  }
+  double PhaseStepSize = PHASE_PER_SECOND*ElapsedTime;
 
-  if (PhaseMeterData[0] > (NewDNRPhaseMeter->FPosition+PHASE_STEPSIZE))
-    NewDNRPhaseMeter->setPosition(NewDNRPhaseMeter->FPosition+PHASE_STEPSIZE);
-  else if (PhaseMeterData[0] < (NewDNRPhaseMeter->FPosition-PHASE_STEPSIZE))
-    NewDNRPhaseMeter->setPosition(NewDNRPhaseMeter->FPosition-PHASE_STEPSIZE);
+  //without engine the levels stay at the minimum set in timerEvent
+  if (CurrentEngineStatus)
+  {
+    ReadMeterSnapshot(MeterData, PhaseMeterData);
+  }
+
+  if (PhaseMeterData[0] > (NewDNRPhaseMeter->FPosition+PhaseStepSize))
+    NewDNRPhaseMeter->setPosition(NewDNRPhaseMeter->FPosition+PhaseStepSize);
+  else if (PhaseMeterData[0] < (NewDNRPhaseMeter->FPosition-PhaseStepSize))
+    NewDNRPhaseMeter->setPosition(NewDNRPhaseMeter->FPosition-PhaseStepSize);
   else
     NewDNRPhaseMeter->setPosition(PhaseMeterData[0]);
 
-  if (PhaseMeterData[1] > (NewDNRPhaseMeter_2->FPosition+PHASE_STEPSIZE))
-    NewDNRPhaseMeter_2->setPosition(NewDNRPhaseMeter_2->FPosition+PHASE_STEPSIZE);
-  else if (PhaseMeterData[1] < (NewDNRPhaseMeter_2->FPosition-PHASE_STEPSIZE))
-    NewDNRPhaseMeter_2->setPosition(NewDNRPhaseMeter_2->FPosition-PHASE_STEPSIZE);
+  if (PhaseMeterData[1] > (NewDNRPhaseMeter_2->FPosition+PhaseStepSize))
+    NewDNRPhaseMeter_2->setPosition(NewDNRPhaseMeter_2->FPosition+PhaseStepSize);
+  else if (PhaseMeterData[1] < (NewDNRPhaseMeter_2->FPosition-PhaseStepSize))
+    NewDNRPhaseMeter_2->setPosition(NewDNRPhaseMeter_2->FPosition-PhaseStepSize);
   else
     NewDNRPhaseMeter_2->setPosition(PhaseMeterData[1]);
 
-  CalculatePPMRelease(NewDNRPPMMeter, &MeterData[0]);
-  CalculatePPMRelease(NewDNRPPMMeter_2, &MeterData[1]);
-  CalculatePPMRelease(NewDNRPPMMeter_3, &MeterData[2]);
-  CalculatePPMRelease(NewDNRPPMMeter_4, &MeterData[3]);
-  CalculatePPMRelease(NewDNRPPMMeter_5, &MeterData[4]);
-  CalculatePPMRelease(NewDNRPPMMeter_6, &MeterData[5]);
-  CalculatePPMRelease(NewDNRPPMMeter_7, &MeterData[6]);
-  CalculatePPMRelease(NewDNRPPMMeter_8, &MeterData[7]);
-  CalculatePPMRelease(NewDNRPPMMeter_9, &MeterData[8]);
-  CalculatePPMRelease(NewDNRPPMMeter_10, &MeterData[9]);
-
-  CalculatePPMRelease(NewSmallDNRPPMMeter_1, &MeterData[10]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_2, &MeterData[11]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_3, &MeterData[12]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_4, &MeterData[13]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_5, &MeterData[14]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_6, &MeterData[15]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_7, &MeterData[16]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_8, &MeterData[17]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_9, &MeterData[18]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_10, &MeterData[19]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_11, &MeterData[20]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_12, &MeterData[21]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_13, &MeterData[22]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_14, &MeterData[23]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_15, &MeterData[24]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_16, &MeterData[25]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_17, &MeterData[26]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_18, &MeterData[27]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_19, &MeterData[28]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_20, &MeterData[29]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_21, &MeterData[30]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_22, &MeterData[31]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_23, &MeterData[32]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_24, &MeterData[33]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_25, &MeterData[34]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_26, &MeterData[35]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_27, &MeterData[36]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_28, &MeterData[37]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_29, &MeterData[38]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_30, &MeterData[39]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_31, &MeterData[40]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_32, &MeterData[41]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_33, &MeterData[42]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_34, &MeterData[43]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_35, &MeterData[44]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_36, &MeterData[45]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_37, &MeterData[46]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_38, &MeterData[47]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_39, &MeterData[48]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_40, &MeterData[49]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_41, &MeterData[50]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_42, &MeterData[51]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_43, &MeterData[52]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_44, &MeterData[53]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_45, &MeterData[54]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_46, &MeterData[55]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_47, &MeterData[56]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_48, &MeterData[57]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_49, &MeterData[58]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_50, &MeterData[59]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_51, &MeterData[60]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_52, &MeterData[61]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_53, &MeterData[62]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_54, &MeterData[63]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_55, &MeterData[64]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_56, &MeterData[65]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_57, &MeterData[66]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_58, &MeterData[67]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_59, &MeterData[68]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_60, &MeterData[69]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_61, &MeterData[70]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_62, &MeterData[71]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_63, &MeterData[72]);
-  CalculatePPMRelease(NewSmallDNRPPMMeter_64, &MeterData[73]);
+  for (cnt=0; cnt<74; cnt++)
+  {
+    if (Ballistics->getMode(cnt) != PPMMeters[cnt]->getBallisticsMode())
+    {
+      Ballistics->setMode(cnt, PPMMeters[cnt]->getBallisticsMode());
+    }
+    Ballistics->setReleasePerSecond(cnt, PPMMeters[cnt]->getReleasePerSecond());
+    Ballistics->setPeakHoldTime(cnt, PPMMeters[cnt]->getPeakHoldTime());
+  }
+  Ballistics->Process(MeterData, Now);
+  for (cnt=0; cnt<74; cnt++)
+  {
+    CalculatePPMRelease(PPMMeters[cnt], Ballistics->Level[cnt], Ballistics->PeakLevel[cnt]);
+  }
+  for (cnt=0; cnt<MeterBridges.count(); cnt++)
+  {
+    DNRMeterBridge *MeterBridge = MeterBridges.at(cnt);
+    int FirstChannel = MeterBridge->getFirstChannel();
+    if ((FirstChannel>=0) && (FirstChannel<74))
+    {
+      MeterBridge->setLevels(&Ballistics->Level[FirstChannel], &Ballistics->PeakLevel[FirstChannel], 74-FirstChannel);
+    }
+  }
 
   if (strcmp(Label[0], CurrentLabel[0]) != 0)
   {
@@ -26,6 +26,8 @@
 
 #include <QWidget>
 #include "ui_browserwidget.h"
+#include "DNRBallistics.h"
+#include "DNRMeterBridge.h"
 
 #include <QtGui>
 
@@ -47,6 +49,10 @@ public:
 	 int cntSecond;
 
 	 double MeterData[74];
+   DNRPPMMeter *PPMMeters[74];
+   DNRBallistics *Ballistics;
+   QList<DNRMeterBridge *> MeterBridges;
+   double PreviousReleaseTime;
    double PhaseMeterData[2];
    char Label[7][33];
    char CurrentLabel[7][33];
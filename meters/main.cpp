@@ -60,7 +60,29 @@
 #endif
 
 Browser *browser = NULL;
-QMutex qt_mutex(QMutex::Recursive);
+
+//Meter levels are published with a sequence counter, the MambaNet thread
+//is the only writer and the GUI thread retries its copy when it overlapped
+//a write.
+struct
+{
+  volatile unsigned int Sequence;
+  float MeterData[74];
+  float PhaseMeterData[2];
+} meter_snapshot;
+
+//All other objects are passed in a single producer/single consumer ring
+//which the GUI thread drains once per frame.
+#define ACTUATOR_QUEUE_SIZE 512
+struct actuator_change
+{
+  unsigned short object;
+  union mbn_data data;
+  char Octets[33];
+};
+struct actuator_change actuator_queue[ACTUATOR_QUEUE_SIZE];
+volatile unsigned int actuator_queue_head = 0;
+volatile unsigned int actuator_queue_tail = 0;
 
 struct mbn_interface *itf;
 struct mbn_handler *mbn;
@@ -120,9 +142,7 @@ void AddressTableChange(struct mbn_handler *m, struct mbn_address_node *old_addr
 
   if (EngineStatus != -1)
   {
-    qt_mutex.lock();
     browser->EngineStatus = EngineStatus;
-    qt_mutex.unlock();
   }
 }
 
@@ -137,13 +157,20 @@ void init(int argc, char *argv[])
   int cntBand;
   char cmdline[1024];
   char socket_path[UNIX_PATH_MAX];
+  int ballistics_mode = -1;
+  double peak_hold_time = -1;
 
   strcpy(ethdev, DEFAULT_ETH_DEV);
   strcpy(log_file, DEFAULT_LOG_FILE);
   strcpy(hwparent_path, DEFAULT_UNIX_HWPARENT_PATH);
   strcpy(socket_path, DEFAULT_UNIX_MAMBANET_PATH);
 
-  while((c =getopt(argc, argv, "e:g:l:i:")) != -1)
+  for (cntObject=0; cntObject<74; cntObject++)
+  {
+    meter_snapshot.MeterData[cntObject] = -50;
+  }
+
+  while((c =getopt(argc, argv, "e:g:l:L:i:b:p:")) != -1)
   {
     switch(c)
     {
@@ -168,6 +195,15 @@ void init(int argc, char *argv[])
         strcpy(log_file, optarg);
       }
       break;
+      case 'L':
+      {
+        if((log_level = log_level_parse(optarg)) < 0)
+        {
+          fprintf(stderr, "Invalid log level\n");
+          exit(1);
+        }
+      }
+      break;
       case 'i':
       {
         if(sscanf(optarg, "%hd", &(this_node.UniqueIDPerProduct)) != 1)
@@ -177,19 +213,55 @@ void init(int argc, char *argv[])
         }
       }
       break;
+      case 'b':
+      {
+        if(strcmp(optarg, "ppm1") == 0)
+          ballistics_mode = BALLISTICS_PPM_TYPE_I;
+        else if(strcmp(optarg, "ppm2") == 0)
+          ballistics_mode = BALLISTICS_PPM_TYPE_II;
+        else if(strcmp(optarg, "vu") == 0)
+          ballistics_mode = BALLISTICS_VU;
+        else
+        {
+          fprintf(stderr, "Invalid ballistics mode\n");
+          exit(1);
+        }
+      }
+      break;
+      case 'p':
+      {
+        if((sscanf(optarg, "%lf", &peak_hold_time) != 1) || (peak_hold_time < 0))
+        {
+          fprintf(stderr, "Invalid peak hold time\n");
+          exit(1);
+        }
+      }
+      break;
       default:
       {
-        fprintf(stderr, "Usage: %s [-e dev] [-g path] [-l path] [-i id]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-e dev] [-g path] [-l path] [-L level] [-i id] [-b mode] [-p sec]\n", argv[0]);
         fprintf(stderr, "  -e dev   Ethernet device for MambaNet communication.\n");
         fprintf(stderr, "  -g path  Hardware parent or path to gateway socket.\n");
         fprintf(stderr, "  -l path  Path to log file.\n");
+        fprintf(stderr, "  -L level Log level: error, warning, info or debug (default info).\n");
         fprintf(stderr, "  -i id    UniqueIDPerProduct for the MambaNet node\n");
+        fprintf(stderr, "  -b mode  Meter ballistics: ppm1, ppm2 or vu (default from skin).\n");
+        fprintf(stderr, "  -p sec   Peak hold time in seconds, 0 disables (default from skin).\n");
         exit(1);
       }
       break;
     }
   }
 
+  //overrides the skin properties of all meters, applied on the next update
+  for (cntObject=0; cntObject<74; cntObject++)
+  {
+    if (ballistics_mode >= 0)
+      browser->PPMMeters[cntObject]->setBallisticsMode(ballistics_mode);
+    if (peak_hold_time >= 0)
+      browser->PPMMeters[cntObject]->setPeakHoldTime(peak_hold_time);
+  }
+
   cntObject = 0;
   objects[cntObject++] = MBN_OBJ( (char *)"Meter 1 Left dB",
                                   MBN_DATATYPE_NODATA,
@@ -630,36 +702,11 @@ void init(int argc, char *argv[])
   log_write("Starting QApplication");
 }
 
-int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_data in)
+//Called from the GUI thread for every change taken from the actuator queue
+void ApplyActuatorData(unsigned short object, union mbn_data in)
 {
-  qt_mutex.lock();
-  if (((object<1024) || (object>=(1024+this_node.NumberOfObjects))) || (browser == NULL))
-  {
-    qt_mutex.unlock();
-    return 1;
-  }
-
   switch (object)
   {
-    case 1024:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[0] = dB;
-    }
-    break;
-    case 1025:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[1] = dB;
-    }
-    break;
-    case 1026:
-    {
-      browser->PhaseMeterData[0] = in.Float;
-    }
-    break;
     case 1027:
     {
       strncpy(browser->Label[0], (char *)in.Octets, 8);
@@ -672,25 +719,6 @@ int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_da
       browser->Label[1][8] = 0;
     }
 		break;
-    case 1029:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[2] = dB;
-    }
-    break;
-    case 1030:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[3] = dB;
-    }
-    break;
-    case 1031:
-    {
-      browser->PhaseMeterData[1] = in.Float;
-    }
-    break;
 		case 1032:
 		{
       strncpy(browser->Label[2], (char *)in.Octets, 8);
@@ -702,20 +730,6 @@ int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_da
       strncpy(browser->Label[3], (char *)in.Octets, 8);
       browser->Label[3][8] = 0;
 		}
-    break;
-    case 1034:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[4] = dB;
-    }
-    break;
-    case 1035:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[5] = dB;
-    }
     break;
 		case 1036:
 		{
@@ -723,20 +737,6 @@ int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_da
       browser->Label[4][8] = 0;
 		}
 		break;
-    case 1037:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[6] = dB;
-    }
-    break;
-    case 1038:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[7] = dB;
-    }
-    break;
 		case 1039:
 		{
       strncpy(browser->Label[5], (char *)in.Octets, 8);
@@ -809,20 +809,6 @@ int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_da
       browser->ModuleConsole = in.UInt;
     }
     break;
-    case 1058:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[8] = dB;
-    }
-    break;
-    case 1059:
-    {
-      float dB = in.Float;
-
-      browser->MeterData[9] = dB;
-    }
-    break;
     case 1060:
     {
       strncpy(browser->DSPGain, (char *)in.Octets, 8);
@@ -933,16 +919,139 @@ int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_da
     }
     break;
   }
+}
+
+//Index in MeterData of a meter level object, -1 for other objects
+int MeterIndex(unsigned short object)
+{
+  switch (object)
+  {
+    case 1024: return 0;
+    case 1025: return 1;
+    case 1029: return 2;
+    case 1030: return 3;
+    case 1034: return 4;
+    case 1035: return 5;
+    case 1037: return 6;
+    case 1038: return 7;
+    case 1058: return 8;
+    case 1059: return 9;
+  }
   if ((object >= 1096) && (object<1160))
   {
-    float dB = in.Float;
-    browser->MeterData[(object-1096)+10] = dB;
+    return (object-1096)+10;
+  }
+  return -1;
+}
+
+//Label objects carry a pointer into the receive buffer, the queue keeps a copy
+int IsOctetsObject(unsigned short object)
+{
+  switch (object)
+  {
+    case 1027: case 1028: case 1032: case 1033: case 1036: case 1039: case 1040:
+    case 1055: case 1056: case 1060: case 1064: case 1065: case 1066:
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+//MambaNet thread: store the value, never waits for the GUI thread
+int SetActuatorData(struct mbn_handler *mbn, unsigned short object, union mbn_data in)
+{
+  int MeterNr;
+
+  if ((object<1024) || (object>=(1024+this_node.NumberOfObjects)))
+  {
+    return 1;
   }
-  qt_mutex.unlock();
+
+  if ((MeterNr = MeterIndex(object)) != -1)
+  {
+    meter_snapshot.Sequence++;
+    __sync_synchronize();
+    meter_snapshot.MeterData[MeterNr] = in.Float;
+    __sync_synchronize();
+    meter_snapshot.Sequence++;
+  }
+  else if ((object == 1026) || (object == 1031))
+  {
+    meter_snapshot.Sequence++;
+    __sync_synchronize();
+    meter_snapshot.PhaseMeterData[(object == 1026) ? 0 : 1] = in.Float;
+    __sync_synchronize();
+    meter_snapshot.Sequence++;
+  }
+  else
+  {
+    unsigned int head = actuator_queue_head;
+    if ((head-actuator_queue_tail) >= ACTUATOR_QUEUE_SIZE)
+    {
+      log_write_limit(LOG_LEVEL_WARNING, 10, "Actuator queue full, object %d dropped", object);
+    }
+    else
+    {
+      struct actuator_change *change = &actuator_queue[head%ACTUATOR_QUEUE_SIZE];
+      change->object = object;
+      change->data = in;
+      if (IsOctetsObject(object))
+      {
+        strncpy(change->Octets, (char *)in.Octets, 32);
+        change->Octets[32] = 0;
+        change->data.Octets = (unsigned char *)change->Octets;
+      }
+      __sync_synchronize();
+      actuator_queue_head = head+1;
+    }
+  }
+
   mbnUpdateActuatorData(mbn, object, in);
   return 0;
 }
 
+//GUI thread: copy the meter levels, retried when the MambaNet thread wrote meanwhile
+void ReadMeterSnapshot(double *MeterData, double *PhaseMeterData)
+{
+  unsigned int Sequence;
+  int cnt;
+
+  do
+  {
+    while ((Sequence = meter_snapshot.Sequence) & 1)
+    {
+    }
+    __sync_synchronize();
+    for (cnt=0; cnt<74; cnt++)
+    {
+      MeterData[cnt] = meter_snapshot.MeterData[cnt];
+    }
+    PhaseMeterData[0] = meter_snapshot.PhaseMeterData[0];
+    PhaseMeterData[1] = meter_snapshot.PhaseMeterData[1];
+    __sync_synchronize();
+  }
+  while (Sequence != meter_snapshot.Sequence);
+}
+
+//GUI thread: apply all queued label and state changes
+void ProcessActuatorQueue()
+{
+  unsigned int tail = actuator_queue_tail;
+
+  while (tail != actuator_queue_head)
+  {
+    __sync_synchronize();
+    struct actuator_change *change = &actuator_queue[tail%ACTUATOR_QUEUE_SIZE];
+    ApplyActuatorData(change->object, change->data);
+    tail++;
+    __sync_synchronize();
+    actuator_queue_tail = tail;
+  }
+}
+
+
+
 int delay_us(double sleep_time)
 {
    struct timespec tv;
@@ -69,6 +69,7 @@ DNRAnalogClock::DNRAnalogClock(QWidget *parent)
     FMinuteHandBorder = 4;
     FMinuteHandLength = 8;
     FMinuteHandWidth = 8;
+    BackgroundValid = false;
 
     setWindowTitle(tr("Analog Clock"));
     resize(200, 200);
@@ -78,29 +79,88 @@ DNRAnalogClock::DNRAnalogClock(QWidget *parent)
     timer->start(100);
 }
 
-void DNRAnalogClock::paintEvent(QPaintEvent *)
+QTransform DNRAnalogClock::ClockTransform()
 {
-  int XOffset = (int)(((float)FDotSize/2)+0.5);
   int side = qMin(width(), height());
+  QTransform Transform;
+
+  Transform.translate(width() / 2, height() / 2);
+  Transform.scale(side / 200.0, side / 200.0);
+  return Transform;
+}
 
+void DNRAnalogClock::HandPolygons(QPoint *hourHand, QPoint *minuteHand)
+{
   int hourYOffset = (int)((((float)FHourHandWidth)/2)+0.5);
   int minuteYOffset = (int)((((float)FMinuteHandWidth)/2)+0.5);
 
-  QPoint hourHand[3] = {
-    QPoint(hourYOffset, -(100-FHourHandBorder)+FHourHandLength),
-    QPoint(-hourYOffset, -(100-FHourHandBorder)+FHourHandLength),
-    QPoint(0, -(100-FHourHandBorder))
-  };
-  QPoint minuteHand[3] = {
-    QPoint(minuteYOffset, -(100-FMinuteHandBorder)+FMinuteHandLength),
-    QPoint(-minuteYOffset, -(100-FMinuteHandBorder)+FMinuteHandLength),
-    QPoint(0, -(100-FMinuteHandBorder))
-  };
+  hourHand[0] = QPoint(hourYOffset, -(100-FHourHandBorder)+FHourHandLength);
+  hourHand[1] = QPoint(-hourYOffset, -(100-FHourHandBorder)+FHourHandLength);
+  hourHand[2] = QPoint(0, -(100-FHourHandBorder));
 
-  QPainter painter(this);
+  minuteHand[0] = QPoint(minuteYOffset, -(100-FMinuteHandBorder)+FMinuteHandLength);
+  minuteHand[1] = QPoint(-minuteYOffset, -(100-FMinuteHandBorder)+FMinuteHandLength);
+  minuteHand[2] = QPoint(0, -(100-FMinuteHandBorder));
+}
+
+//Widget area covered by a hand at the given angle, with a margin for antialiasing
+QRect DNRAnalogClock::HandRect(QPoint *Hand, double Angle)
+{
+  QTransform Transform = ClockTransform();
+  QPolygon Polygon;
+
+  Transform.rotate(Angle);
+  Polygon << Hand[0] << Hand[1] << Hand[2];
+  return Transform.map(Polygon).boundingRect().adjusted(-2,-2,2,2);
+}
+
+QRect DNRAnalogClock::DotRect(int Second)
+{
+  int XOffset = (int)(((float)FDotSize/2)+0.5);
+  QTransform Transform = ClockTransform();
+  Transform.rotate(6.0*Second);
+
+  return Transform.mapRect(QRect(-XOffset, -(100-FDotSize), FDotSize, FDotSize)).adjusted(-2,-2,2,2);
+}
+
+int DNRAnalogClock::TimeToEnd()
+{
+  int TimeInSeconds = FMinute*60+FSecond;
+  int EndTimeInSeconds = FEndTimeMinute*60 + FEndTimeSecond;
+  if (FEndTimeHour<24)
+  { //fixed our.
+    TimeInSeconds += FHour*3600;
+    EndTimeInSeconds += FEndTimeHour*3600;
+  }
+
+  int TimeToEnd = EndTimeInSeconds-TimeInSeconds;
+
+  //Check zero crossings...
+  if (FEndTimeHour>=24)
+  { //Hourly
+    if (TimeToEnd<=(15-3600))
+    {
+      TimeToEnd += 3600;
+    }
+  }
+  else
+  { //Fixed our
+    if (TimeToEnd<=(15-86400))
+    {
+      TimeToEnd += 86400;
+    }
+  }
+  return TimeToEnd;
+}
+
+void DNRAnalogClock::RenderBackground()
+{
+  BackgroundPixmap = QPixmap(size());
+  BackgroundPixmap.fill(Qt::transparent);
+
+  QPainter painter(&BackgroundPixmap);
   painter.setRenderHint(QPainter::Antialiasing);
-  painter.translate(width() / 2, height() / 2);
-  painter.scale(side / 200.0, side / 200.0);
+  painter.setTransform(ClockTransform());
 
   for (int j = 0; j < 60; ++j)
   {
@@ -122,37 +182,45 @@ void DNRAnalogClock::paintEvent(QPaintEvent *)
     }
     painter.rotate(6.0);
   }
+  BackgroundValid = true;
+}
 
-  if (FEndTime)
+void DNRAnalogClock::InvalidateBackground()
+{
+  BackgroundValid = false;
+  update();
+}
+
+void DNRAnalogClock::resizeEvent(QResizeEvent *)
+{
+  BackgroundValid = false;
+}
+
+void DNRAnalogClock::paintEvent(QPaintEvent *event)
+{
+  int XOffset = (int)(((float)FDotSize/2)+0.5);
+  QPoint hourHand[3];
+  QPoint minuteHand[3];
+
+  HandPolygons(hourHand, minuteHand);
+
+  if (!BackgroundValid)
   {
-    int TimeInSeconds = FMinute*60+FSecond;
-    int EndTimeInSeconds = FEndTimeMinute*60 + FEndTimeSecond;
-    if (FEndTimeHour<24)
-    { //fixed our.
-      TimeInSeconds += FHour*3600;
-      EndTimeInSeconds += FEndTimeHour*3600;
-    }
+    RenderBackground();
+  }
 
-    int TimeToEnd = EndTimeInSeconds-TimeInSeconds;
+  QPainter painter(this);
+  painter.drawPixmap(event->rect(), BackgroundPixmap, event->rect());
 
-    //Check zero crossings...
-    if (FEndTimeHour>=24)
-    { //Hourly
-      if (TimeToEnd<=(15-3600))
-      {
-        TimeToEnd += 3600;
-      }
-    }
-    else
-    { //Fixed our
-      if (TimeToEnd<=(15-86400))
-      {
-        TimeToEnd += 86400;
-      }
-    }
+  painter.setRenderHint(QPainter::Antialiasing);
+  painter.setTransform(ClockTransform());
+
+  if (FEndTime)
+  {
+    int Remaining = TimeToEnd();
 
     //If not endtime passed or hourly do paint...
-    if (!((FEndTimeHour<24) && (TimeToEnd<0)))
+    if (!((FEndTimeHour<24) && (Remaining<0)))
     {
       painter.save();
       painter.rotate(6.0 * (FEndTimeMinute + FEndTimeSecond / 60.0));
@@ -160,9 +228,9 @@ void DNRAnalogClock::paintEvent(QPaintEvent *)
 
       painter.drawLine(0, -100+FEndTimeWidth/2, 0, -100+FEndTimeLength);
 
-      if ((TimeToEnd>0) && (TimeToEnd<=15))
+      if ((Remaining>0) && (Remaining<=15))
       {
-        painter.drawArc(-100+FEndTimeWidth/2,-100+FEndTimeWidth/2, 200-FEndTimeWidth*2, 200-FEndTimeWidth*2, 90*16, (90*16*TimeToEnd)/15);
+        painter.drawArc(-100+FEndTimeWidth/2,-100+FEndTimeWidth/2, 200-FEndTimeWidth*2, 200-FEndTimeWidth*2, 90*16, (90*16*Remaining)/15);
       }
       painter.restore();
     }
@@ -192,31 +260,22 @@ void DNRAnalogClock::paintEvent(QPaintEvent *)
     painter.restore();
   }
 
-  for (int j = 0; j < 60; ++j)
+  if (FSecondDots)
   {
-    if (FSecondDots)
+    painter.setPen(FDotColor);
+    painter.setBrush(FDotColor);
+
+    for (int j = 0; j < 60; ++j)
     {
-      painter.setPen(FDotColor);
-      painter.setBrush(FDotColor);
+      bool Visible = FSecondDotsCountDown ? (j>=FSecond) : (j<=FSecond);
 
-      if (FSecondDotsCountDown)
-      {
-        if (j>=FSecond)
-        {
-          painter.drawEllipse(-XOffset, -(100-FDotSize), FDotSize, FDotSize);
-        }
-      }
-      else
+      if ((Visible) && (event->region().intersects(DotRect(j))))
       {
-        if (j<=FSecond)
-        {
-          painter.drawEllipse(-XOffset, -(100-FDotSize), FDotSize, FDotSize);
-        }
+        painter.drawEllipse(-XOffset, -(100-FDotSize), FDotSize, FDotSize);
       }
+      painter.rotate(6.0);
     }
-    painter.rotate(6.0);
   }
-
 }
 
 void DNRAnalogClock::setHourLines(bool NewHourLines)
@@ -224,7 +283,7 @@ void DNRAnalogClock::setHourLines(bool NewHourLines)
    if (FHourLines != NewHourLines)
    {
       FHourLines = NewHourLines;
-      update();
+      InvalidateBackground();
    }
 }
 
@@ -238,7 +297,7 @@ void DNRAnalogClock::setHourLinesLength(int NewHourLinesLength)
   if (FHourLinesLength != NewHourLinesLength)
   {
     FHourLinesLength = NewHourLinesLength;
-    update();
+    InvalidateBackground();
   }
 }
 
@@ -252,7 +311,7 @@ void DNRAnalogClock::setHourLinesWidth(int NewHourLinesWidth)
   if (FHourLinesWidth != NewHourLinesWidth)
   {
     FHourLinesWidth = NewHourLinesWidth;
-    update();
+    InvalidateBackground();
   }
 }
 
@@ -266,7 +325,7 @@ void DNRAnalogClock::setHourLinesColor(QColor NewHourLinesColor)
   if (FHourLinesColor != NewHourLinesColor)
   {
     FHourLinesColor = NewHourLinesColor;
-    update();
+    InvalidateBackground();
   }
 }
 
@@ -280,7 +339,7 @@ void DNRAnalogClock::setMinuteLines(bool NewMinuteLines)
    if (FMinuteLines != NewMinuteLines)
    {
       FMinuteLines = NewMinuteLines;
-      update();
+      InvalidateBackground();
    }
 }
 
@@ -294,7 +353,7 @@ void DNRAnalogClock::setMinuteLinesLength(int NewMinuteLinesLength)
   if (FMinuteLinesLength != NewMinuteLinesLength)
   {
     FMinuteLinesLength = NewMinuteLinesLength;
-    update();
+    InvalidateBackground();
   }
 }
 
@@ -308,7 +367,7 @@ void DNRAnalogClock::setMinuteLinesWidth(int NewMinuteLinesWidth)
   if (FMinuteLinesWidth != NewMinuteLinesWidth)
   {
     FMinuteLinesWidth = NewMinuteLinesWidth;
-    update();
+    InvalidateBackground();
   }
 }
 
@@ -322,7 +381,7 @@ void DNRAnalogClock::setMinuteLinesColor(QColor NewMinuteLinesColor)
   if (FMinuteLinesColor != NewMinuteLinesColor)
   {
     FMinuteLinesColor = NewMinuteLinesColor;
-    update();
+    InvalidateBackground();
   }
 }
 
@@ -670,7 +729,6 @@ QColor DNRAnalogClock::getCountDownColor()
 
 void DNRAnalogClock::checkTime()
 {
-  bool TimeChanged = false;
   QTime time = QTime::currentTime();
   int NewHour = time.hour();
   int NewMinute = time.minute();
@@ -678,6 +736,15 @@ void DNRAnalogClock::checkTime()
 
   if (FSecond != NewSecond)
   {
+    QPoint hourHand[3];
+    QPoint minuteHand[3];
+    QRegion Dirty;
+    int OldHour = FHour;
+    int OldMinute = FMinute;
+    int OldSecond = FSecond;
+
+    HandPolygons(hourHand, minuteHand);
+
     FSecond = NewSecond;
     if (FMinute != NewMinute)
     {
@@ -687,11 +754,38 @@ void DNRAnalogClock::checkTime()
         FHour = NewHour;
       }
     }
-    TimeChanged = true;
-  }
 
-  if (TimeChanged)
-  {
-    update();
+    //Only repaint where something moved, the whole clock when the
+    //dots restart or the end time arc runs
+    if ((FEndTime) && (TimeToEnd()>=-1) && (TimeToEnd()<=16))
+    {
+      update();
+      return;
+    }
+    if ((FSecondDots) && (NewSecond != OldSecond+1))
+    {
+      update();
+      return;
+    }
+
+    if (FSecondDots)
+    {
+      Dirty += DotRect(OldSecond);
+      Dirty += DotRect(NewSecond);
+    }
+    if (FHands)
+    {
+      Dirty += HandRect(minuteHand, 6.0 * (OldMinute + OldSecond / 60.0));
+      Dirty += HandRect(minuteHand, 6.0 * (FMinute + FSecond / 60.0));
+      if ((OldHour != FHour) || (OldMinute != FMinute))
+      {
+        Dirty += HandRect(hourHand, 30.0 * ((OldHour + OldMinute / 60.0)));
+        Dirty += HandRect(hourHand, 30.0 * ((FHour + FMinute / 60.0)));
+      }
+    }
+    if (!Dirty.isEmpty())
+    {
+      update(Dirty);
+    }
   }
 }
@@ -25,6 +25,7 @@
 #define DNRANALOGCLOCK_H
 
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QDESIGNER_WIDGET_EXPORT DNRAnalogClock : public QWidget
@@ -207,6 +208,20 @@ protected:
     QColor FCountDownColor;
 
     void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
+
+    //Hour and minute lines are static and rendered once, only the
+    //hands, dots and end time/count down arcs are painted each second
+    QPixmap BackgroundPixmap;
+    bool BackgroundValid;
+    void RenderBackground();
+    void InvalidateBackground();
+
+    QTransform ClockTransform();
+    void HandPolygons(QPoint *hourHand, QPoint *minuteHand);
+    QRect HandRect(QPoint *Hand, double Angle);
+    QRect DotRect(int Second);
+    int TimeToEnd();
 
 public slots:
     void checkTime();
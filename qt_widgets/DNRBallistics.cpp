@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "DNRBallistics.h"
+
+#ifdef Q_OS_WIN32
+#include <windows.h> // for QueryPerformanceCounter
+#endif
+
+DNRBallistics::DNRBallistics(int NewNumberOfChannels, double NewMindB)
+{
+   int cnt;
+
+   NumberOfChannels = NewNumberOfChannels;
+   MindB = NewMindB;
+
+   Level = new float[NumberOfChannels];
+   PeakLevel = new float[NumberOfChannels];
+   Mode = new unsigned char[NumberOfChannels];
+   IntegrationTime = new float[NumberOfChannels];
+   ReleasePerSecond = new float[NumberOfChannels];
+   PeakHoldTime = new float[NumberOfChannels];
+   PeakAge = new float[NumberOfChannels];
+   Coefficient = new float[NumberOfChannels];
+   Voltage = new float[NumberOfChannels];
+   Linear = new unsigned char[NumberOfChannels];
+
+   for (cnt=0; cnt<NumberOfChannels; cnt++)
+   {
+      Linear[cnt] = 0;
+      setMode(cnt, BALLISTICS_PPM_TYPE_I);
+      PeakHoldTime[cnt] = 0;
+   }
+   Reset();
+}
+
+DNRBallistics::~DNRBallistics()
+{
+   delete[] Level;
+   delete[] PeakLevel;
+   delete[] Mode;
+   delete[] IntegrationTime;
+   delete[] ReleasePerSecond;
+   delete[] PeakHoldTime;
+   delete[] PeakAge;
+   delete[] Coefficient;
+   delete[] Voltage;
+   delete[] Linear;
+}
+
+void DNRBallistics::setMode(int Channel, int NewMode)
+{
+   if ((Channel<0) || (Channel>=NumberOfChannels))
+   {
+      return;
+   }
+
+   switch (NewMode)
+   {
+      case BALLISTICS_PPM_TYPE_I:
+      {
+         IntegrationTime[Channel] = 0.005;
+         ReleasePerSecond[Channel] = 20.0/1.5;
+         Linear[Channel] = 0;
+      }
+      break;
+      case BALLISTICS_PPM_TYPE_II:
+      {
+         IntegrationTime[Channel] = 0.010;
+         ReleasePerSecond[Channel] = 24.0/2.8;
+         Linear[Channel] = 0;
+      }
+      break;
+      case BALLISTICS_VU:
+      {
+         //first order approximation: 99% after 300ms is a time constant of 300ms/ln(100)
+         IntegrationTime[Channel] = 0.300/4.605;
+         ReleasePerSecond[Channel] = 0;
+         if (!Linear[Channel])
+         {
+            //continue from the current level
+            Voltage[Channel] = powf(10, Level[Channel]/20);
+         }
+         Linear[Channel] = 1;
+      }
+      break;
+      default:
+      {
+         return;
+      }
+   }
+   Mode[Channel] = NewMode;
+}
+
+int DNRBallistics::getMode(int Channel)
+{
+   if ((Channel>=0) && (Channel<NumberOfChannels))
+   {
+      return Mode[Channel];
+   }
+   return -1;
+}
+
+void DNRBallistics::setIntegrationTime(int Channel, double Seconds)
+{
+   if ((Channel>=0) && (Channel<NumberOfChannels))
+   {
+      IntegrationTime[Channel] = Seconds;
+   }
+}
+
+void DNRBallistics::setReleasePerSecond(int Channel, double dBPerSecond)
+{
+   if ((Channel>=0) && (Channel<NumberOfChannels))
+   {
+      ReleasePerSecond[Channel] = dBPerSecond;
+   }
+}
+
+void DNRBallistics::setPeakHoldTime(int Channel, double Seconds)
+{
+   if ((Channel>=0) && (Channel<NumberOfChannels))
+   {
+      PeakHoldTime[Channel] = (Seconds>0) ? Seconds : 0;
+   }
+}
+
+void DNRBallistics::Reset()
+{
+   int cnt;
+
+   for (cnt=0; cnt<NumberOfChannels; cnt++)
+   {
+      Level[cnt] = MindB;
+      PeakLevel[cnt] = MindB;
+      PeakAge[cnt] = 0;
+      Voltage[cnt] = powf(10, MindB/20);
+   }
+   PreviousTime = MonotonicTime();
+}
+
+void DNRBallistics::Process(const double *Input, double Now)
+{
+   int cnt;
+   float ElapsedTime = Now-PreviousTime;
+   float Floor = MindB;
+
+   if (ElapsedTime<=0)
+   {
+      return;
+   }
+   if (ElapsedTime>BALLISTICS_MAX_STEP)
+   {
+      ElapsedTime = BALLISTICS_MAX_STEP;
+   }
+   PreviousTime = Now;
+
+   //Attack coefficient of the first order integration, exact for any time
+   //step. Channels mostly share one mode, so expf() only runs when the
+   //integration time differs from the previous channel.
+   for (cnt=0; cnt<NumberOfChannels; cnt++)
+   {
+      if ((cnt>0) && (IntegrationTime[cnt] == IntegrationTime[cnt-1]))
+      {
+         Coefficient[cnt] = Coefficient[cnt-1];
+      }
+      else
+      {
+         Coefficient[cnt] = 1-expf(-ElapsedTime/(IntegrationTime[cnt]+1e-6f));
+      }
+   }
+
+   //PPM ballistics for all channels. The body has no calls and no
+   //branches, attack or release is picked by weighting with the comparison
+   //result, so -ftree-vectorize runs it over several channels at once.
+   for (cnt=0; cnt<NumberOfChannels; cnt++)
+   {
+      float In = Input[cnt];
+      float Out = Level[cnt];
+      In = (In<Floor) ? Floor : In;
+
+      float Attack = Out+((In-Out)*Coefficient[cnt]);
+
+      //Release: fixed dB per second, never below the input
+      float Release = Out-(ReleasePerSecond[cnt]*ElapsedTime);
+      Release = (Release<In) ? In : Release;
+
+      float Rising = (In>Out);
+      Out = Release+((Attack-Release)*Rising);
+      Level[cnt] = (Out<Floor) ? Floor : Out;
+   }
+
+   //VU integrates on the voltage scale in both directions, its state is
+   //kept as voltage so only the input and the result need a conversion
+   for (cnt=0; cnt<NumberOfChannels; cnt++)
+   {
+      if (Linear[cnt])
+      {
+         float In = Input[cnt];
+         In = (In<Floor) ? Floor : In;
+
+         Voltage[cnt] += (powf(10, In/20)-Voltage[cnt])*Coefficient[cnt];
+         Level[cnt] = 20*log10f(Voltage[cnt]);
+      }
+   }
+
+   //Peak hold: a new maximum restarts the hold, once the hold time has
+   //passed the peak follows the level. Only selects, so this loop
+   //vectorizes as well.
+   for (cnt=0; cnt<NumberOfChannels; cnt++)
+   {
+      float Out = Level[cnt];
+      float Peak = PeakLevel[cnt];
+      float Age = PeakAge[cnt]+ElapsedTime;
+
+      float Held = (Age<PeakHoldTime[cnt]) ? Peak : Out;
+      PeakLevel[cnt] = (Out>Held) ? Out : Held;
+      PeakAge[cnt] = (Out>Peak) ? 0 : Age;
+   }
+}
+
+double DNRBallistics::MonotonicTime()
+{
+#ifdef Q_OS_WIN32
+   LARGE_INTEGER freq, newTime;
+   QueryPerformanceFrequency(&freq);
+   QueryPerformanceCounter(&newTime);
+   return (double)newTime.QuadPart/freq.QuadPart;
+#else
+   timespec newTime;
+   clock_gettime(CLOCK_MONOTONIC, &newTime);
+   return newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
+#endif
+}
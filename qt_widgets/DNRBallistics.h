@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef DNRBALLISTICS_H
+#define DNRBALLISTICS_H
+
+#include <QtDesigner/QDesignerExportWidget>
+
+//Values for Mode
+#define BALLISTICS_PPM_TYPE_I    0  //IEC 60268-10 type I (DIN), 5ms integration, 20dB in 1.5s
+#define BALLISTICS_PPM_TYPE_II   1  //IEC 60268-10 type II (EBU/BBC), 10ms integration, 24dB in 2.8s
+#define BALLISTICS_VU            2  //IEC 60268-17, 300ms to 99% on rise and fall
+
+//Longest time step taken at once, larger gaps (suspend, stalled GUI)
+//are treated as if the meter settled
+#define BALLISTICS_MAX_STEP      1.0
+
+//Meter ballistics for a group of channels, driven by monotonic time
+//instead of timer ticks. Input and output levels are in dB.
+class QDESIGNER_WIDGET_EXPORT DNRBallistics
+{
+public:
+    DNRBallistics(int NewNumberOfChannels, double NewMindB = -50);
+    ~DNRBallistics();
+
+    int NumberOfChannels;
+    double MindB;
+
+    //Result of the last Process(), indexed by channel
+    float *Level;
+    //Highest Level within the hold time, equal to Level when hold is off
+    float *PeakLevel;
+
+    void setMode(int Channel, int Mode);
+    int getMode(int Channel);
+    void setIntegrationTime(int Channel, double Seconds);
+    void setReleasePerSecond(int Channel, double dBPerSecond);
+    //0 disables peak hold for the channel
+    void setPeakHoldTime(int Channel, double Seconds);
+    void Reset();
+
+    //Advances all channels to time Now (in seconds, see MonotonicTime())
+    void Process(const double *Input, double Now);
+
+    static double MonotonicTime();
+
+private:
+    double PreviousTime;
+
+    //Per channel parameters and state, kept as separate arrays so
+    //Process() runs straight loops over all channels
+    unsigned char *Mode;
+    float *IntegrationTime;
+    float *ReleasePerSecond;
+    float *PeakHoldTime;
+    float *PeakAge;
+    float *Coefficient;
+    float *Voltage;
+    unsigned char *Linear;
+};
+
+#endif
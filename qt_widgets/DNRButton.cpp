@@ -24,6 +24,7 @@
 #include <QtGui>
 #include "DNRDefines.h"
 #include "DNRButton.h"
+#include "DNRSkinAtlas.h"
 
 DNRButton::DNRButton(QWidget *parent)
     : QWidget(parent)
@@ -40,12 +41,6 @@ DNRButton::DNRButton(QWidget *parent)
     FDownOffColor = QColor(255,255,255);
     FDownOnColor = QColor(192,224,255);
 
-    QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-    UpOffImage = new QImage(AxumSkinPath + "/" + FUpOffImageFileName);
-    UpOnImage = new QImage(AxumSkinPath + "/" + FUpOnImageFileName);
-    DownOffImage = new QImage(AxumSkinPath + "/" + FDownOffImageFileName);
-    DownOnImage = new QImage(AxumSkinPath + "/" + FDownOnImageFileName);
-
     setWindowTitle(tr("Button"));
     resize(64, 16);
 }
@@ -61,7 +56,7 @@ void DNRButton::paintEvent(QPaintEvent *)
     {	//FPosition=Up
     	if (FState)
     	{ //FState=On
-		    if (UpOnImage->isNull())
+		    if (UpOnPixmap.isNull())
     		{
 				painter.setPen(FBorderColor);
 				painter.setBrush(FUpOnColor);
@@ -70,12 +65,12 @@ void DNRButton::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *UpOnImage);
+			    painter.drawPixmap(0, 0, UpOnPixmap);
 		    }
 		}
 		else
 		{ //FState=Off
-		    if (UpOffImage->isNull())
+		    if (UpOffPixmap.isNull())
     		{
 				painter.setPen(FBorderColor);
 				painter.setBrush(FUpOffColor);
@@ -83,7 +78,7 @@ void DNRButton::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *UpOffImage);
+			    painter.drawPixmap(0, 0, UpOffPixmap);
 		    }
 		}
 	}
@@ -91,7 +86,7 @@ void DNRButton::paintEvent(QPaintEvent *)
 	{	//FPosition=Down
     	if (FState)
     	{ //FState=On
-		    if (DownOnImage->isNull())
+		    if (DownOnPixmap.isNull())
     		{
 				painter.setPen(FBorderColor);
 				painter.setBrush(FDownOnColor);
@@ -99,12 +94,12 @@ void DNRButton::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *DownOnImage);
+			    painter.drawPixmap(0, 0, DownOnPixmap);
 		    }
 		}
 		else
 		{ //FState=Off
-		    if (DownOffImage->isNull())
+		    if (DownOffPixmap.isNull())
     		{
 				painter.setPen(FBorderColor);
 				painter.setBrush(FDownOffColor);
@@ -112,7 +107,7 @@ void DNRButton::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *DownOffImage);
+			    painter.drawPixmap(0, 0, DownOffPixmap);
 		    }
 		}
 	}
@@ -202,32 +197,11 @@ void DNRButton::setSkinEnvironmentVariable(const QString &NewSkinEnvironmentVari
    {
       FSkinEnvironmentVariable = NewSkinEnvironmentVariable;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-
-      if (!UpOffImage->load(AxumSkinPath + "/" + FUpOffImageFileName))
-      {
-		  delete UpOffImage;
-		  UpOffImage = new QImage();
-
-	  }
-      if (!UpOnImage->load(AxumSkinPath + "/" + FUpOnImageFileName))
-      {
-		  delete UpOnImage;
-		  UpOnImage = new QImage();
-
-	  }
-      if (!DownOffImage->load(AxumSkinPath + "/" + FDownOffImageFileName))
-      {
-		  delete DownOffImage;
-		  DownOffImage = new QImage();
-
-	  }
-      if (!DownOnImage->load(AxumSkinPath + "/" + FDownOnImageFileName))
-      {
-		  delete DownOnImage;
-		  DownOnImage = new QImage();
 
-	  }
+      UpOffPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FUpOffImageFileName);
+      UpOnPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FUpOnImageFileName);
+      DownOffPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FDownOffImageFileName);
+      DownOnPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FDownOnImageFileName);
 
       update();
    }
@@ -244,13 +218,7 @@ void DNRButton::setUpOffImageFileName(const QString &NewUpOffImageFileName)
    {
       FUpOffImageFileName = NewUpOffImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!UpOffImage->load(AxumSkinPath + "/" + FUpOffImageFileName))
-      {
-		  delete UpOffImage;
-		  UpOffImage = new QImage();
-
-	  }
+      UpOffPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FUpOffImageFileName);
       update();
    }
 }
@@ -266,13 +234,7 @@ void DNRButton::setUpOnImageFileName(const QString &NewUpOnImageFileName)
    {
       FUpOnImageFileName = NewUpOnImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!UpOnImage->load(AxumSkinPath + "/" + FUpOnImageFileName))
-      {
-		  delete UpOnImage;
-		  UpOnImage = new QImage();
-
-	  }
+      UpOnPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FUpOnImageFileName);
       update();
    }
 }
@@ -288,13 +250,7 @@ void DNRButton::setDownOffImageFileName(const QString &NewDownOffImageFileName)
    {
       FDownOffImageFileName = NewDownOffImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!DownOffImage->load(AxumSkinPath + "/" + FDownOffImageFileName))
-      {
-		  delete DownOffImage;
-		  DownOffImage = new QImage();
-
-	  }
+      DownOffPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FDownOffImageFileName);
       update();
    }
 }
@@ -310,13 +266,7 @@ void DNRButton::setDownOnImageFileName(const QString &NewDownOnImageFileName)
    {
       FDownOnImageFileName = NewDownOnImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!DownOnImage->load(AxumSkinPath + "/" + FDownOnImageFileName))
-      {
-		  delete DownOnImage;
-		  DownOnImage = new QImage();
-
-	  }
+      DownOnPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FDownOnImageFileName);
       update();
    }
 }
@@ -26,6 +26,7 @@
 
 #include "DNRDefines.h"
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QDESIGNER_WIDGET_EXPORT DNRButton : public QWidget
@@ -49,10 +50,10 @@ class QDESIGNER_WIDGET_EXPORT DNRButton : public QWidget
 public:
     DNRButton(QWidget *parent = 0);
 
-    QImage *UpOffImage;
-    QImage *UpOnImage;
-    QImage *DownOffImage;
-    QImage *DownOnImage;
+    QPixmap UpOffPixmap;
+    QPixmap UpOnPixmap;
+    QPixmap DownOffPixmap;
+    QPixmap DownOnPixmap;
 
     int FNumber;
     void setNumber(int NewNumber);
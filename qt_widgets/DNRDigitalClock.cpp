@@ -156,15 +156,13 @@ QColor DNRDigitalClock::getDateDisplayFontColor()
 
 void DNRDigitalClock::checkTime()
 {
-  bool TimeChanged = false;
   QTime time = QTime::currentTime();
-  QDate Date = QDate::currentDate();
   int NewHour = time.hour();
   int NewMinute = time.minute();
   int NewSecond = time.second();
-  TimeString = time.toString("hh:mm:ss");
-  DateString = Date.toString();
 
+  //The strings are only formatted when the second changes, the date row
+  //is only repainted when the date text changed
   if (FSecond != NewSecond)
   {
     FSecond = NewSecond;
@@ -176,11 +174,18 @@ void DNRDigitalClock::checkTime()
         FHour = NewHour;
       }
     }
-    TimeChanged = true;
-  }
+    TimeString = time.toString("hh:mm:ss");
 
-  if (TimeChanged)
-  {
-    update();
+    QString NewDateString = QDate::currentDate().toString();
+    if (DateString != NewDateString)
+    {
+      DateString = NewDateString;
+      update();
+    }
+    else if (FTimeDisplay)
+    {
+      int TimeHeight = qMax(height()/2, QFontMetrics(FTimeDisplayFont).height());
+      update(0, 0, width(), TimeHeight);
+    }
   }
 }
@@ -33,8 +33,6 @@
 DNREQPanel::DNREQPanel(QWidget *parent)
     : QWidget(parent)
 {
-  float Coefficients[6];
-
   FBackgroundColor = QColor(22,51,105);
   FAxisColor = QColor(135, 168, 228);
   FGridColor = QColor(35, 80, 163);
@@ -105,30 +103,9 @@ DNREQPanel::DNREQPanel(QWidget *parent)
   FFrequencyLowCut = 80;
   FLCOn = false;
 
-  GainFactorLowCut = CalculateEQ(Coefficients, 0, FFrequencyLowCut, 1.0, 1.0, 1, true);
-  CalculateZeroPosition(ZerosXLowCut, ZerosYLowCut, Coefficients);
-  CalculatePolePosition(PolesXLowCut, PolesYLowCut, Coefficients);
-  CalculateLCCurve();
-
-  GainFactorBand1 = CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1, FSlopeBand1, FTypeBand1, FOnBand1);
-  GainFactorBand2 = CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2, FSlopeBand2, FTypeBand2, FOnBand2);
-  GainFactorBand3 = CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3, FSlopeBand3, FTypeBand3, FOnBand3);
-  GainFactorBand4 = CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4, FSlopeBand4, FTypeBand4, FOnBand4);
-  GainFactorBand5 = CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5, FSlopeBand5, FTypeBand5, FOnBand5);
-  GainFactorBand6 = CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6, FSlopeBand6, FTypeBand6, FOnBand6);
-  CalculateZeroPosition(ZerosXBand1, ZerosYBand1, Coefficients);
-  CalculatePolePosition(PolesXBand1, PolesYBand1, Coefficients);
-  CalculateZeroPosition(ZerosXBand2, ZerosYBand2, Coefficients);
-  CalculatePolePosition(PolesXBand2, PolesYBand2, Coefficients);
-  CalculateZeroPosition(ZerosXBand3, ZerosYBand3, Coefficients);
-  CalculatePolePosition(PolesXBand3, PolesYBand3, Coefficients);
-  CalculateZeroPosition(ZerosXBand4, ZerosYBand4, Coefficients);
-  CalculatePolePosition(PolesXBand4, PolesYBand4, Coefficients);
-  CalculateZeroPosition(ZerosXBand5, ZerosYBand5, Coefficients);
-  CalculatePolePosition(PolesXBand5, PolesYBand5, Coefficients);
-  CalculateZeroPosition(ZerosXBand6, ZerosYBand6, Coefficients);
-  CalculatePolePosition(PolesXBand6, PolesYBand6, Coefficients);
+  CalculateAllBands();
   CalculateEQCurve();
+  CalculateLCCurve();
 }
 
 void DNREQPanel::paintEvent(QPaintEvent *)
@@ -460,9 +437,8 @@ void DNREQPanel::setFrequencyLowCut(int NewFrequencyLowCut)
   if (FFrequencyLowCut != NewFrequencyLowCut)
   {
     FFrequencyLowCut = NewFrequencyLowCut;
-    GainFactorLowCut = CalculateEQ(Coefficients, 0, FFrequencyLowCut, 1, 1, 1, true);
-    CalculateZeroPosition(ZerosXLowCut, ZerosYLowCut, Coefficients);
-    CalculatePolePosition(PolesXLowCut, PolesYLowCut, Coefficients);
+    CalculateEQ(Coefficients, 0, FFrequencyLowCut, 1, 1, 1, true);
+    CalculateBandResponse(LOWCUT_BAND, Coefficients);
     CalculateLCCurve();
     update();
   }
@@ -495,9 +471,8 @@ void DNREQPanel::setGainBand1(double NewGainBand1)
   if (FGainBand1 != NewGainBand1)
   {
     FGainBand1 = NewGainBand1;
-    GainFactorBand1 = CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
-    CalculateZeroPosition(ZerosXBand1, ZerosYBand1, Coefficients);
-    CalculatePolePosition(PolesXBand1, PolesYBand1, Coefficients);
+    CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
+    CalculateBandResponse(0, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -515,9 +490,8 @@ void DNREQPanel::setGainBand2(double NewGainBand2)
   if (FGainBand2 != NewGainBand2)
   {
     FGainBand2 = NewGainBand2;
-    GainFactorBand2 = CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
-    CalculateZeroPosition(ZerosXBand2, ZerosYBand2, Coefficients);
-    CalculatePolePosition(PolesXBand2, PolesYBand2, Coefficients);
+    CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
+    CalculateBandResponse(1, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -535,9 +509,8 @@ void DNREQPanel::setGainBand3(double NewGainBand3)
   if (FGainBand3 != NewGainBand3)
   {
     FGainBand3 = NewGainBand3;
-    GainFactorBand3 = CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
-    CalculateZeroPosition(ZerosXBand3, ZerosYBand3, Coefficients);
-    CalculatePolePosition(PolesXBand3, PolesYBand3, Coefficients);
+    CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
+    CalculateBandResponse(2, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -555,9 +528,8 @@ void DNREQPanel::setGainBand4(double NewGainBand4)
   if (FGainBand4 != NewGainBand4)
   {
     FGainBand4 = NewGainBand4;
-    GainFactorBand4 = CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
-    CalculateZeroPosition(ZerosXBand4, ZerosYBand4, Coefficients);
-    CalculatePolePosition(PolesXBand4, PolesYBand4, Coefficients);
+    CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
+    CalculateBandResponse(3, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -575,9 +547,8 @@ void DNREQPanel::setGainBand5(double NewGainBand5)
   if (FGainBand5 != NewGainBand5)
   {
     FGainBand5 = NewGainBand5;
-    GainFactorBand5 = CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
-    CalculateZeroPosition(ZerosXBand5, ZerosYBand5, Coefficients);
-    CalculatePolePosition(PolesXBand5, PolesYBand5, Coefficients);
+    CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
+    CalculateBandResponse(4, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -595,9 +566,8 @@ void DNREQPanel::setGainBand6(double NewGainBand6)
   if (FGainBand6 != NewGainBand6)
   {
     FGainBand6 = NewGainBand6;
-    GainFactorBand6 = CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
-    CalculateZeroPosition(ZerosXBand6, ZerosYBand6, Coefficients);
-    CalculatePolePosition(PolesXBand6, PolesYBand6, Coefficients);
+    CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
+    CalculateBandResponse(5, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -615,9 +585,8 @@ void DNREQPanel::setFrequencyBand1(int NewFrequencyBand1)
   if (FFrequencyBand1 != NewFrequencyBand1)
   {
     FFrequencyBand1 = NewFrequencyBand1;
-    GainFactorBand1 = CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
-    CalculateZeroPosition(ZerosXBand1, ZerosYBand1, Coefficients);
-    CalculatePolePosition(PolesXBand1, PolesYBand1, Coefficients);
+    CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
+    CalculateBandResponse(0, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -635,9 +604,8 @@ void DNREQPanel::setFrequencyBand2(int NewFrequencyBand2)
   if (FFrequencyBand2 != NewFrequencyBand2)
   {
     FFrequencyBand2 = NewFrequencyBand2;
-    GainFactorBand2 = CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
-    CalculateZeroPosition(ZerosXBand2, ZerosYBand2, Coefficients);
-    CalculatePolePosition(PolesXBand2, PolesYBand2, Coefficients);
+    CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
+    CalculateBandResponse(1, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -655,9 +623,8 @@ void DNREQPanel::setFrequencyBand3(int NewFrequencyBand3)
   if (FFrequencyBand3 != NewFrequencyBand3)
   {
     FFrequencyBand3 = NewFrequencyBand3;
-    GainFactorBand3 = CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
-    CalculateZeroPosition(ZerosXBand3, ZerosYBand3, Coefficients);
-    CalculatePolePosition(PolesXBand3, PolesYBand3, Coefficients);
+    CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
+    CalculateBandResponse(2, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -675,9 +642,8 @@ void DNREQPanel::setFrequencyBand4(int NewFrequencyBand4)
   if (FFrequencyBand4 != NewFrequencyBand4)
   {
     FFrequencyBand4 = NewFrequencyBand4;
-    GainFactorBand4 = CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
-    CalculateZeroPosition(ZerosXBand4, ZerosYBand4, Coefficients);
-    CalculatePolePosition(PolesXBand4, PolesYBand4, Coefficients);
+    CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
+    CalculateBandResponse(3, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -695,9 +661,8 @@ void DNREQPanel::setFrequencyBand5(int NewFrequencyBand5)
   if (FFrequencyBand5 != NewFrequencyBand5)
   {
     FFrequencyBand5 = NewFrequencyBand5;
-    GainFactorBand5 = CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
-    CalculateZeroPosition(ZerosXBand5, ZerosYBand5, Coefficients);
-    CalculatePolePosition(PolesXBand5, PolesYBand5, Coefficients);
+    CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
+    CalculateBandResponse(4, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -715,9 +680,8 @@ void DNREQPanel::setFrequencyBand6(int NewFrequencyBand6)
   if (FFrequencyBand6 != NewFrequencyBand6)
   {
     FFrequencyBand6 = NewFrequencyBand6;
-    GainFactorBand6 = CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
-    CalculateZeroPosition(ZerosXBand6, ZerosYBand6, Coefficients);
-    CalculatePolePosition(PolesXBand6, PolesYBand6, Coefficients);
+    CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
+    CalculateBandResponse(5, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -736,9 +700,8 @@ void DNREQPanel::setBandwidthBand1(double NewBandwidthBand1)
   if (FBandwidthBand1 != NewBandwidthBand1)
   {
     FBandwidthBand1 = NewBandwidthBand1;
-    GainFactorBand1 = CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
-    CalculateZeroPosition(ZerosXBand1, ZerosYBand1, Coefficients);
-    CalculatePolePosition(PolesXBand1, PolesYBand1, Coefficients);
+    CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
+    CalculateBandResponse(0, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -756,9 +719,8 @@ void DNREQPanel::setBandwidthBand2(double NewBandwidthBand2)
   if (FBandwidthBand2 != NewBandwidthBand2)
   {
     FBandwidthBand2 = NewBandwidthBand2;
-    GainFactorBand2 = CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
-    CalculateZeroPosition(ZerosXBand2, ZerosYBand2, Coefficients);
-    CalculatePolePosition(PolesXBand2, PolesYBand2, Coefficients);
+    CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
+    CalculateBandResponse(1, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -776,9 +738,8 @@ void DNREQPanel::setBandwidthBand3(double NewBandwidthBand3)
   if (FBandwidthBand3 != NewBandwidthBand3)
   {
     FBandwidthBand3 = NewBandwidthBand3;
-    GainFactorBand3 = CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
-    CalculateZeroPosition(ZerosXBand3, ZerosYBand3, Coefficients);
-    CalculatePolePosition(PolesXBand3, PolesYBand3, Coefficients);
+    CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
+    CalculateBandResponse(2, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -796,9 +757,8 @@ void DNREQPanel::setBandwidthBand4(double NewBandwidthBand4)
   if (FBandwidthBand4 != NewBandwidthBand4)
   {
     FBandwidthBand4 = NewBandwidthBand4;
-    GainFactorBand4 = CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
-    CalculateZeroPosition(ZerosXBand4, ZerosYBand4, Coefficients);
-    CalculatePolePosition(PolesXBand4, PolesYBand4, Coefficients);
+    CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
+    CalculateBandResponse(3, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -816,9 +776,8 @@ void DNREQPanel::setBandwidthBand5(double NewBandwidthBand5)
   if (FBandwidthBand5 != NewBandwidthBand5)
   {
     FBandwidthBand5 = NewBandwidthBand5;
-    GainFactorBand5 = CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
-    CalculateZeroPosition(ZerosXBand5, ZerosYBand5, Coefficients);
-    CalculatePolePosition(PolesXBand5, PolesYBand5, Coefficients);
+    CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
+    CalculateBandResponse(4, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -836,9 +795,8 @@ void DNREQPanel::setBandwidthBand6(double NewBandwidthBand6)
   if (FBandwidthBand6 != NewBandwidthBand6)
   {
     FBandwidthBand6 = NewBandwidthBand6;
-    GainFactorBand6 = CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
-    CalculateZeroPosition(ZerosXBand6, ZerosYBand6, Coefficients);
-    CalculatePolePosition(PolesXBand6, PolesYBand6, Coefficients);
+    CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
+    CalculateBandResponse(5, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -863,7 +821,9 @@ void DNREQPanel::setNrOfPoints(int NewNrOfPoints)
       NewNrOfPoints = 0;
     }
     FNrOfPoints = NewNrOfPoints;
+    CalculateGrid();
     CalculateEQCurve();
+    CalculateLCCurve();
     update();
   }
 }
@@ -1092,9 +1052,8 @@ void DNREQPanel::setTypeBand1(int NewTypeBand1)
   if (FTypeBand1 != NewTypeBand1)
   {
     FTypeBand1 = NewTypeBand1;
-    GainFactorBand1 = CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
-    CalculateZeroPosition(ZerosXBand1, ZerosYBand1, Coefficients);
-    CalculatePolePosition(PolesXBand1, PolesYBand1, Coefficients);
+    CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
+    CalculateBandResponse(0, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1112,9 +1071,8 @@ void DNREQPanel::setTypeBand2(int NewTypeBand2)
   if (FTypeBand2 != NewTypeBand2)
   {
     FTypeBand2 = NewTypeBand2;
-    GainFactorBand2 = CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
-    CalculateZeroPosition(ZerosXBand2, ZerosYBand2, Coefficients);
-    CalculatePolePosition(PolesXBand2, PolesYBand2, Coefficients);
+    CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
+    CalculateBandResponse(1, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1132,9 +1090,8 @@ void DNREQPanel::setTypeBand3(int NewTypeBand3)
   if (FTypeBand3 != NewTypeBand3)
   {
     FTypeBand3 = NewTypeBand3;
-    GainFactorBand3 = CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
-    CalculateZeroPosition(ZerosXBand3, ZerosYBand3, Coefficients);
-    CalculatePolePosition(PolesXBand3, PolesYBand3, Coefficients);
+    CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
+    CalculateBandResponse(2, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1152,9 +1109,8 @@ void DNREQPanel::setTypeBand4(int NewTypeBand4)
   if (FTypeBand4 != NewTypeBand4)
   {
     FTypeBand4 = NewTypeBand4;
-    GainFactorBand4 = CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
-    CalculateZeroPosition(ZerosXBand4, ZerosYBand4, Coefficients);
-    CalculatePolePosition(PolesXBand4, PolesYBand4, Coefficients);
+    CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
+    CalculateBandResponse(3, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1172,9 +1128,8 @@ void DNREQPanel::setTypeBand5(int NewTypeBand5)
   if (FTypeBand5 != NewTypeBand5)
   {
     FTypeBand5 = NewTypeBand5;
-    GainFactorBand5 = CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
-    CalculateZeroPosition(ZerosXBand5, ZerosYBand5, Coefficients);
-    CalculatePolePosition(PolesXBand5, PolesYBand5, Coefficients);
+    CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
+    CalculateBandResponse(4, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1192,9 +1147,8 @@ void DNREQPanel::setTypeBand6(int NewTypeBand6)
   if (FTypeBand6 != NewTypeBand6)
   {
     FTypeBand6 = NewTypeBand6;
-    GainFactorBand6 = CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
-    CalculateZeroPosition(ZerosXBand6, ZerosYBand6, Coefficients);
-    CalculatePolePosition(PolesXBand6, PolesYBand6, Coefficients);
+    CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
+    CalculateBandResponse(5, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1210,6 +1164,9 @@ void DNREQPanel::setSamplerate(int NewSamplerate)
   if (FSamplerate != NewSamplerate)
   {
     FSamplerate = NewSamplerate;
+    CalculateAllBands();
+    CalculateEQCurve();
+    CalculateLCCurve();
     update();
   }
 }
@@ -1224,6 +1181,9 @@ void DNREQPanel::setNequistDivide(double NewNequistDivide)
   if (FNequistDivide != NewNequistDivide)
   {
     FNequistDivide = NewNequistDivide;
+    CalculateAllBands();
+    CalculateEQCurve();
+    CalculateLCCurve();
     update();
   }
 }
@@ -1282,9 +1242,8 @@ void DNREQPanel::setOnBand1(bool NewOnBand1)
   if (FOnBand1 != NewOnBand1)
   {
     FOnBand1 = NewOnBand1;
-    GainFactorBand1 = CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
-    CalculateZeroPosition(ZerosXBand1, ZerosYBand1, Coefficients);
-    CalculatePolePosition(PolesXBand1, PolesYBand1, Coefficients);
+    CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
+    CalculateBandResponse(0, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1302,9 +1261,8 @@ void DNREQPanel::setOnBand2(bool NewOnBand2)
   if (FOnBand2 != NewOnBand2)
   {
     FOnBand2 = NewOnBand2;
-    GainFactorBand2 = CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
-    CalculateZeroPosition(ZerosXBand2, ZerosYBand2, Coefficients);
-    CalculatePolePosition(PolesXBand2, PolesYBand2, Coefficients);
+    CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
+    CalculateBandResponse(1, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1322,9 +1280,8 @@ void DNREQPanel::setOnBand3(bool NewOnBand3)
   if (FOnBand3 != NewOnBand3)
   {
     FOnBand3 = NewOnBand3;
-    GainFactorBand3 = CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
-    CalculateZeroPosition(ZerosXBand3, ZerosYBand3, Coefficients);
-    CalculatePolePosition(PolesXBand3, PolesYBand3, Coefficients);
+    CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
+    CalculateBandResponse(2, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1342,9 +1299,8 @@ void DNREQPanel::setOnBand4(bool NewOnBand4)
   if (FOnBand4 != NewOnBand4)
   {
     FOnBand4 = NewOnBand4;
-    GainFactorBand4 = CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
-    CalculateZeroPosition(ZerosXBand4, ZerosYBand4, Coefficients);
-    CalculatePolePosition(PolesXBand4, PolesYBand4, Coefficients);
+    CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
+    CalculateBandResponse(3, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1362,9 +1318,8 @@ void DNREQPanel::setOnBand5(bool NewOnBand5)
   if (FOnBand5 != NewOnBand5)
   {
     FOnBand5 = NewOnBand5;
-    GainFactorBand5 = CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
-    CalculateZeroPosition(ZerosXBand5, ZerosYBand5, Coefficients);
-    CalculatePolePosition(PolesXBand5, PolesYBand5, Coefficients);
+    CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
+    CalculateBandResponse(4, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1382,9 +1337,8 @@ void DNREQPanel::setOnBand6(bool NewOnBand6)
   if (FOnBand6 != NewOnBand6)
   {
     FOnBand6 = NewOnBand6;
-    GainFactorBand6 = CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
-    CalculateZeroPosition(ZerosXBand6, ZerosYBand6, Coefficients);
-    CalculatePolePosition(PolesXBand6, PolesYBand6, Coefficients);
+    CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
+    CalculateBandResponse(5, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1430,9 +1384,8 @@ void DNREQPanel::setSlopeBand1(double NewSlopeBand1)
   if (FSlopeBand1 != NewSlopeBand1)
   {
     FSlopeBand1 = NewSlopeBand1;
-    GainFactorBand1 = CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
-    CalculateZeroPosition(ZerosXBand1, ZerosYBand1, Coefficients);
-    CalculatePolePosition(PolesXBand1, PolesYBand1, Coefficients);
+    CalculateEQ(Coefficients, FGainBand1, FFrequencyBand1, FBandwidthBand1,FSlopeBand1, FTypeBand1, FOnBand1);
+    CalculateBandResponse(0, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1450,9 +1403,8 @@ void DNREQPanel::setSlopeBand2(double NewSlopeBand2)
   if (FSlopeBand2 != NewSlopeBand2)
   {
     FSlopeBand2 = NewSlopeBand2;
-    GainFactorBand2 = CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
-    CalculateZeroPosition(ZerosXBand2, ZerosYBand2, Coefficients);
-    CalculatePolePosition(PolesXBand2, PolesYBand2, Coefficients);
+    CalculateEQ(Coefficients, FGainBand2, FFrequencyBand2, FBandwidthBand2,FSlopeBand2, FTypeBand2, FOnBand2);
+    CalculateBandResponse(1, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1470,9 +1422,8 @@ void DNREQPanel::setSlopeBand3(double NewSlopeBand3)
   if (FSlopeBand3 != NewSlopeBand3)
   {
     FSlopeBand3 = NewSlopeBand3;
-    GainFactorBand3 = CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
-    CalculateZeroPosition(ZerosXBand3, ZerosYBand3, Coefficients);
-    CalculatePolePosition(PolesXBand3, PolesYBand3, Coefficients);
+    CalculateEQ(Coefficients, FGainBand3, FFrequencyBand3, FBandwidthBand3,FSlopeBand3, FTypeBand3, FOnBand3);
+    CalculateBandResponse(2, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1490,9 +1441,8 @@ void DNREQPanel::setSlopeBand4(double NewSlopeBand4)
   if (FSlopeBand4 != NewSlopeBand4)
   {
     FSlopeBand4 = NewSlopeBand4;
-    GainFactorBand4 = CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
-    CalculateZeroPosition(ZerosXBand4, ZerosYBand4, Coefficients);
-    CalculatePolePosition(PolesXBand4, PolesYBand4, Coefficients);
+    CalculateEQ(Coefficients, FGainBand4, FFrequencyBand4, FBandwidthBand4,FSlopeBand4, FTypeBand4, FOnBand4);
+    CalculateBandResponse(3, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1510,9 +1460,8 @@ void DNREQPanel::setSlopeBand5(double NewSlopeBand5)
   if (FSlopeBand5 != NewSlopeBand5)
   {
     FSlopeBand5 = NewSlopeBand5;
-    GainFactorBand5 = CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
-    CalculateZeroPosition(ZerosXBand5, ZerosYBand5, Coefficients);
-    CalculatePolePosition(PolesXBand5, PolesYBand5, Coefficients);
+    CalculateEQ(Coefficients, FGainBand5, FFrequencyBand5, FBandwidthBand5,FSlopeBand5, FTypeBand5, FOnBand5);
+    CalculateBandResponse(4, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1530,9 +1479,8 @@ void DNREQPanel::setSlopeBand6(double NewSlopeBand6)
   if (FSlopeBand6 != NewSlopeBand6)
   {
     FSlopeBand6 = NewSlopeBand6;
-    GainFactorBand6 = CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
-    CalculateZeroPosition(ZerosXBand6, ZerosYBand6, Coefficients);
-    CalculatePolePosition(PolesXBand6, PolesYBand6, Coefficients);
+    CalculateEQ(Coefficients, FGainBand6, FFrequencyBand6, FBandwidthBand6,FSlopeBand6, FTypeBand6, FOnBand6);
+    CalculateBandResponse(5, Coefficients);
     CalculateEQCurve();
     update();
   }
@@ -1542,147 +1490,22 @@ void DNREQPanel::setSlopeBand6(double NewSlopeBand6)
 void DNREQPanel::CalculateEQCurve()
 {
   int cnt;
-  double Freq, Alpha;
-  double X,Y, DeltaX, DeltaY;
-  double Length, dBGain;
 
   int BorderWidth = FAxisBorderWidth;
 
   int HorizontalAxisLength = width()-(2*BorderWidth)-FAxisLeftMargin;
   int VerticalAxisLength = height()-(2*BorderWidth);
 
+  if (FNrOfPoints<4)
+  {
+    return;
+  }
+
   EQCurve[0] = QPoint(FAxisLeftMargin+BorderWidth, height()-BorderWidth-(VerticalAxisLength/2));
   for (cnt=0; cnt<FNrOfPoints-2; cnt++)
   {
-    Freq = pow(10,(float) (cnt*log10((FSamplerate)/(FNequistDivide*10)))/(FNrOfPoints-3))*10;
-    Alpha = (double)(M_PI*2*Freq)/(FSamplerate);
-
-    X = cos(Alpha);
-    Y = sin(Alpha);
-
-    Length = 1;
-
-    // Band 1
-    DeltaX = X-ZerosXBand1[0];
-    DeltaY = Y-ZerosYBand1[0];
-    Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-    DeltaX = X-ZerosXBand1[1];
-    DeltaY = Y-ZerosYBand1[1];
-    Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-    DeltaX = X-PolesXBand1[0];
-    DeltaY = Y-PolesYBand1[0];
-    Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand1[1];
-	  DeltaY = Y-PolesYBand1[1];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  Length *= GainFactorBand1;
-
-    // Band 2
-    DeltaX = X-ZerosXBand2[0];
-	  DeltaY = Y-ZerosYBand2[0];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-    DeltaX = X-ZerosXBand2[1];
-	  DeltaY = Y-ZerosYBand2[1];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand2[0];
-	  DeltaY = Y-PolesYBand2[0];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand2[1];
-	  DeltaY = Y-PolesYBand2[1];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  Length *= GainFactorBand2;
-
-    // Band 3
-    DeltaX = X-ZerosXBand3[0];
-	  DeltaY = Y-ZerosYBand3[0];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-ZerosXBand3[1];
-	  DeltaY = Y-ZerosYBand3[1];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand3[0];
-	  DeltaY = Y-PolesYBand3[0];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-  	DeltaX = X-PolesXBand3[1];
-  	DeltaY = Y-PolesYBand3[1];
-  	Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-  	Length *= GainFactorBand3;
-
-    // Band 4
-    DeltaX = X-ZerosXBand4[0];
-	  DeltaY = Y-ZerosYBand4[0];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-ZerosXBand4[1];
-	  DeltaY = Y-ZerosYBand4[1];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand4[0];
-	  DeltaY = Y-PolesYBand4[0];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand4[1];
-	  DeltaY = Y-PolesYBand4[1];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  Length *= GainFactorBand4;
-
-    // Band 5
-    DeltaX = X-ZerosXBand5[0];
-	  DeltaY = Y-ZerosYBand5[0];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-ZerosXBand5[1];
-	  DeltaY = Y-ZerosYBand5[1];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand5[0];
-	  DeltaY = Y-PolesYBand5[0];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand5[1];
-	  DeltaY = Y-PolesYBand5[1];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  Length *= GainFactorBand5;
-
-    // Band 6
-    DeltaX = X-ZerosXBand6[0];
-	  DeltaY = Y-ZerosYBand6[0];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-ZerosXBand6[1];
-	  DeltaY = Y-ZerosYBand6[1];
-	  Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand6[0];
-	  DeltaY = Y-PolesYBand6[0];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXBand6[1];
-	  DeltaY = Y-PolesYBand6[1];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  Length *= GainFactorBand6;
-
-    if (Length==0)
-      dBGain = -90;
-    else
-		  dBGain = log10(Length)*-20;
-
     int X1 = FAxisLeftMargin+BorderWidth+((float)(cnt*HorizontalAxisLength)/(FNrOfPoints-3));
-    int Y1 = height()-BorderWidth-(((float)(18-dBGain)*VerticalAxisLength)/36);
+    int Y1 = height()-BorderWidth-(((float)(18+EQdB[cnt])*VerticalAxisLength)/36);
 	  EQCurve[cnt+1] = QPoint(X1, Y1);
   }
   EQCurve[FNrOfPoints-1] = QPoint(FAxisLeftMargin+BorderWidth+HorizontalAxisLength, height()-BorderWidth-(VerticalAxisLength/2));
@@ -1691,118 +1514,139 @@ void DNREQPanel::CalculateEQCurve()
 void DNREQPanel::CalculateLCCurve()
 {
   int cnt;
-  double Freq, Alpha;
-  double X,Y, DeltaX, DeltaY;
-  double Length, dBGain;
 
   int BorderWidth = FAxisBorderWidth;
 
   int HorizontalAxisLength = width()-(2*BorderWidth)-FAxisLeftMargin;
   int VerticalAxisLength = height()-(2*BorderWidth);
 
-  for (cnt=0; cnt<FNrOfPoints; cnt++)
+  if (FNrOfPoints<4)
   {
-    Freq = pow(10,(float) (cnt*log10((FSamplerate)/(FNequistDivide*10)))/(FNrOfPoints-1))*10;
-    Alpha = (double)(M_PI*2*Freq)/(FSamplerate);
-
-    X = cos(Alpha);
-    Y = sin(Alpha);
-
-    Length = 1;
-
-    // Low cut
-    DeltaX = X-ZerosXLowCut[0];
-    DeltaY = Y-ZerosYLowCut[0];
-    Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-    DeltaX = X-ZerosXLowCut[1];
-    DeltaY = Y-ZerosYLowCut[1];
-    Length *= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-    DeltaX = X-PolesXLowCut[0];
-    DeltaY = Y-PolesYLowCut[0];
-    Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  DeltaX = X-PolesXLowCut[1];
-	  DeltaY = Y-PolesYLowCut[1];
-	  Length /= sqrt(DeltaX*DeltaX+DeltaY*DeltaY);
-
-	  Length *= GainFactorLowCut;
-
-    if (Length==0)
-      dBGain = -90;
-    else
-		  dBGain = log10(Length)*-20;
+    return;
+  }
 
+  for (cnt=0; cnt<FNrOfPoints; cnt++)
+  {
     int X1 = FAxisLeftMargin+BorderWidth+((float)(cnt*HorizontalAxisLength)/(FNrOfPoints-1));
-    int Y1 = height()-BorderWidth-(((float)(18-dBGain)*VerticalAxisLength)/36);
+    int Y1 = height()-BorderWidth-(((float)(18+BanddB[LOWCUT_BAND][cnt])*VerticalAxisLength)/36);
 	  LCCurve[cnt] = QPoint(X1, Y1);
   }
 }
 
-void DNREQPanel::CalculatePolePosition(float *X, float *Y, float *Coefficients)
+//Log spaced frequencies from 10Hz to the nyquist frequency, stored as
+//sin^2(w/2) which is all the magnitude of a biquad needs.
+//The EQ curve has FNrOfPoints-2 points, the low cut curve FNrOfPoints.
+void DNREQPanel::CalculateGrid()
 {
-	float a = Coefficients[3];
-	float b = Coefficients[4];
-	float c = Coefficients[5];
+  int cnt;
+  double Decades = log10((FSamplerate)/(FNequistDivide*10));
+  double Alpha;
 
-	float R = 0;
-	float I = 0;
-	float B = b/(2*a);
+  if (FNrOfPoints<4)
+  {
+    return;
+  }
 
-	if (((b*b) - (4*a*c))>0)
-	{
-		R =  sqrt((b*b)-4*a*c)/(2*a);
+  for (cnt=0; cnt<FNrOfPoints; cnt++)
+  {
+    Alpha = (M_PI*2*pow(10, (cnt*Decades)/(FNrOfPoints-3))*10)/FSamplerate;
+    EQGridPhi[cnt] = sin(Alpha/2)*sin(Alpha/2);
 
-		X[0] = (R-B);
-		Y[0] = 0;
+    Alpha = (M_PI*2*pow(10, (cnt*Decades)/(FNrOfPoints-1))*10)/FSamplerate;
+    LCGridPhi[cnt] = sin(Alpha/2)*sin(Alpha/2);
+  }
 
-		X[1] = (-R-B);
-		Y[1] = 0;
-	}
-	else
-	{
-		I =  sqrt(4*a*c-(b*b))/(2*a);
-		X[0] = -B;
-		Y[0] = I;
+  for (cnt=0; cnt<FNrOfPoints-2; cnt++)
+  {
+    EQdB[cnt] = 0;
+  }
+  for (int Band=0; Band<LOWCUT_BAND; Band++)
+  {
+    CalculateMagnitude(BanddB[Band], BandCoefficients[Band], EQGridPhi, FNrOfPoints-2);
+    for (cnt=0; cnt<FNrOfPoints-2; cnt++)
+    {
+      EQdB[cnt] += BanddB[Band][cnt];
+    }
+  }
+  CalculateMagnitude(BanddB[LOWCUT_BAND], BandCoefficients[LOWCUT_BAND], LCGridPhi, FNrOfPoints);
+}
 
-		X[1] = -B;
-		Y[1] = -I;
-	}
+//Coefficients of all bands, needed after a samplerate change
+void DNREQPanel::CalculateAllBands()
+{
+  CalculateEQ(BandCoefficients[0], FGainBand1, FFrequencyBand1, FBandwidthBand1, FSlopeBand1, FTypeBand1, FOnBand1);
+  CalculateEQ(BandCoefficients[1], FGainBand2, FFrequencyBand2, FBandwidthBand2, FSlopeBand2, FTypeBand2, FOnBand2);
+  CalculateEQ(BandCoefficients[2], FGainBand3, FFrequencyBand3, FBandwidthBand3, FSlopeBand3, FTypeBand3, FOnBand3);
+  CalculateEQ(BandCoefficients[3], FGainBand4, FFrequencyBand4, FBandwidthBand4, FSlopeBand4, FTypeBand4, FOnBand4);
+  CalculateEQ(BandCoefficients[4], FGainBand5, FFrequencyBand5, FBandwidthBand5, FSlopeBand5, FTypeBand5, FOnBand5);
+  CalculateEQ(BandCoefficients[5], FGainBand6, FFrequencyBand6, FBandwidthBand6, FSlopeBand6, FTypeBand6, FOnBand6);
+  CalculateEQ(BandCoefficients[LOWCUT_BAND], 0, FFrequencyLowCut, 1.0, 1.0, 1, true);
+  CalculateGrid();
 }
 
-void DNREQPanel::CalculateZeroPosition(float *X, float *Y, float *Coefficients)
+//Only the changed band is evaluated, the EQ total is corrected by the difference
+void DNREQPanel::CalculateBandResponse(int Band, float *Coefficients)
 {
-    //TODO: Add your source code here
+  float NewdB[1024];
+  int cnt;
 
-    // zeros
-    float a = Coefficients[0];
-    float b = Coefficients[1];
-    float c = Coefficients[2];
+  for (cnt=0; cnt<6; cnt++)
+  {
+    BandCoefficients[Band][cnt] = Coefficients[cnt];
+  }
 
-    float R = 0;
-    float I = 0;
-    float B = b/(2*a);
+  if (FNrOfPoints<4)
+  {
+    return;
+  }
 
-        if (((b*b) - (4*a*c))>0)
-	{
-		R =  sqrt((b*b)-4*a*c)/(2*a);
+  if (Band == LOWCUT_BAND)
+  {
+    CalculateMagnitude(BanddB[LOWCUT_BAND], Coefficients, LCGridPhi, FNrOfPoints);
+  }
+  else
+  {
+    CalculateMagnitude(NewdB, Coefficients, EQGridPhi, FNrOfPoints-2);
+    for (cnt=0; cnt<FNrOfPoints-2; cnt++)
+    {
+      EQdB[cnt] += NewdB[cnt]-BanddB[Band][cnt];
+      BanddB[Band][cnt] = NewdB[cnt];
+    }
+  }
+}
 
-		X[0] = (R-B);
-		Y[0] = 0;
+//Magnitude in dB of b0+b1z^-1+b2z^-2 / a0+a1z^-1+a2z^-2 on the grid, with
+//phi = sin^2(w/2): |N|^2 = (b0+b1+b2)^2 - 4(b0b1+4b0b2+b1b2)phi + 16b0b2phi^2.
+//This form keeps its precision for deep cuts, unlike the cos(w) expansion.
+//The loop only does multiply/add on float arrays, so it is vectorized by the
+//compiler; the log is taken once per point.
+void DNREQPanel::CalculateMagnitude(float *dB, float *Coefficients, float *GridPhi, int NrOfPoints)
+{
+  double b0 = Coefficients[0], b1 = Coefficients[1], b2 = Coefficients[2];
+  double a0 = Coefficients[3], a1 = Coefficients[4], a2 = Coefficients[5];
+  float Power[1024];
+  int cnt;
 
-		X[1] = (-R-B);
-		Y[1] = 0;
-	}
-	else
-	{
-		I =  sqrt(4*a*c-(b*b))/(2*a);
-		X[0] = -B;
-		Y[0] = I;
+  float N0 = (b0+b1+b2)*(b0+b1+b2);
+  float N1 = -4*((b0*b1)+(4*b0*b2)+(b1*b2));
+  float N2 = 16*b0*b2;
+  float D0 = (a0+a1+a2)*(a0+a1+a2);
+  float D1 = -4*((a0*a1)+(4*a0*a2)+(a1*a2));
+  float D2 = 16*a0*a2;
 
-		X[1] = -B;
-		Y[1] = -I;
-	}
+  for (cnt=0; cnt<NrOfPoints; cnt++)
+  {
+    float Phi = GridPhi[cnt];
+    float Numerator = N0+(Phi*(N1+(Phi*N2)));
+    float Denominator = D0+(Phi*(D1+(Phi*D2)));
+    Numerator = (Numerator<1e-9f) ? 1e-9f : Numerator;
+    Denominator = (Denominator<1e-9f) ? 1e-9f : Denominator;
+    Power[cnt] = Numerator/Denominator;
+  }
+  for (cnt=0; cnt<NrOfPoints; cnt++)
+  {
+    dB[cnt] = 10*log10f(Power[cnt]);
+  }
 }
 
 float DNREQPanel::CalculateEQ(float *Coefficients, double Gain, int Frequency, double Bandwidth, double Slope, int Type, bool On)
@@ -28,6 +28,8 @@
 #include <QWidget>
 #include <QtDesigner/QDesignerExportWidget>
 
+#define LOWCUT_BAND 6
+
 class QDESIGNER_WIDGET_EXPORT DNREQPanel : public QWidget
 {
     Q_OBJECT
@@ -354,81 +356,23 @@ private:
     QPoint EQCurve[1024];
     QPoint LCCurve[1024];
 
-    float GainFactorLowCut;
-
-    float GainFactorBand1;
-    float GainFactorBand2;
-    float GainFactorBand3;
-    float GainFactorBand4;
-    float GainFactorBand5;
-    float GainFactorBand6;
-    float GainFactorBand1On;
-    float GainFactorBand2On;
-    float GainFactorBand3On;
-    float GainFactorBand4On;
-    float GainFactorBand5On;
-    float GainFactorBand6On;
-
-    float PolesXLowCut[2];
-    float PolesYLowCut[2];
-    float ZerosXLowCut[2];
-    float ZerosYLowCut[2];
-
-    float PolesXBand1[2];
-    float PolesYBand1[2];
-    float ZerosXBand1[2];
-    float ZerosYBand1[2];
-    float PolesXBand2[2];
-    float PolesYBand2[2];
-    float ZerosXBand2[2];
-    float ZerosYBand2[2];
-    float PolesXBand3[2];
-    float PolesYBand3[2];
-    float ZerosXBand3[2];
-    float ZerosYBand3[2];
-    float PolesXBand4[2];
-    float PolesYBand4[2];
-    float ZerosXBand4[2];
-    float ZerosYBand4[2];
-    float PolesXBand5[2];
-    float PolesYBand5[2];
-    float ZerosXBand5[2];
-    float ZerosYBand5[2];
-    float PolesXBand6[2];
-    float PolesYBand6[2];
-    float ZerosXBand6[2];
-    float ZerosYBand6[2];
-    float PolesXBand1On[2];
-    float PolesYBand1On[2];
-    float ZerosXBand1On[2];
-    float ZerosYBand1On[2];
-    float PolesXBand2On[2];
-    float PolesYBand2On[2];
-    float ZerosXBand2On[2];
-    float ZerosYBand2On[2];
-    float PolesXBand3On[2];
-    float PolesYBand3On[2];
-    float ZerosXBand3On[2];
-    float ZerosYBand3On[2];
-    float PolesXBand4On[2];
-    float PolesYBand4On[2];
-    float ZerosXBand4On[2];
-    float ZerosYBand4On[2];
-    float PolesXBand5On[2];
-    float PolesYBand5On[2];
-    float ZerosXBand5On[2];
-    float ZerosYBand5On[2];
-    float PolesXBand6On[2];
-    float PolesYBand6On[2];
-    float ZerosXBand6On[2];
-    float ZerosYBand6On[2];
+    //Frequency grids as sin^2(w/2), for the EQ and the low cut curve
+    float EQGridPhi[1024];
+    float LCGridPhi[1024];
+
+    //Coefficients and response per band, band LOWCUT_BAND is the low cut
+    float BandCoefficients[7][6];
+    float BanddB[7][1024];
+    float EQdB[1024];
 
 protected:
     void paintEvent(QPaintEvent *event);
     void CalculateEQCurve();
     void CalculateLCCurve();
-    void CalculatePolePosition(float *X, float *Y, float *Coefficients);
-    void CalculateZeroPosition(float *X, float *Y, float *Coefficients);
+    void CalculateGrid();
+    void CalculateAllBands();
+    void CalculateBandResponse(int Band, float *Coefficients);
+    void CalculateMagnitude(float *dB, float *Coefficients, float *GridPhi, int NrOfPoints);
     float CalculateEQ(float *Coefficients, double Gain, int Frequency, double Bandwidth, double Slope, int Type, bool On);
 
 //    void mouseMoveEvent(QMouseEvent *ev);
@@ -23,12 +23,15 @@
 
 #include "DNREngineThread.h"
 #include "qstringlist.h"
+#include <QSocketNotifier>
+#include <QTimer>
 #include <private/qthread_p.h>
 #include "linux/serial.h" //for serial_struct
 #include <asm/ioctls.h>   //for TIOCGSERIAL
 #include <sys/ioctl.h>
 #include <termios.h>
 #include <errno.h>
+#include <string.h>
 //#include <fcntl.h>
 //#include <sys/signal.h>
 //#include <sys/types.h>
@@ -215,19 +218,18 @@ DNREngineThread::DNREngineThread(QObject *parent): QThread(parent)
 {
    registerDNRTypes();
 
-   for (int cntChannel=0; cntChannel<MAXNUMBEROFCHANNELS; cntChannel++)
-	{
-		AxumData.ModuleData[cntChannel].FaderPosition = 0;
-		PreviousAxumData.ModuleData[cntChannel].FaderPosition = 0;
-	}
+   memset(&AxumData, 0, sizeof(AxumData));
+   memset(&PreviousAxumData, 0, sizeof(PreviousAxumData));
+   memset(&PreviousSignalling, 0, sizeof(PreviousSignalling));
+
    ProcessID = 0;
    LastElapsedTime = 0;
-   abort = false;
+   previousNumberOfSeconds = 0;
 }
 
 DNREngineThread::~DNREngineThread()
 {
-   abort = true;
+   quit();
 	wait();
 }
 
@@ -241,64 +243,19 @@ QStringList DNREngineThread::GetReceivingSlotsList(const char *signal, const cha
 	return d_func()->receivingSlotsList(signal, receiver);
 }
 
+//The thread runs an event loop: serial input wakes it through a socket
+//notifier and the timers come from QTimers created in this thread. Those
+//are connected direct, so doSerialRead and the timer slots run in this
+//thread. The object itself lives in the thread that created it, so the
+//public slots connected from the widgets run there, and so does all
+//access to AxumData.
 void DNREngineThread::run()
 {
-	//counter for thread
-	int cntStudio;
-	int cntOutput;
-
-	SIGNALLING_STRUCT Signalling;
-	SIGNALLING_STRUCT PreviousSignalling;
-
-#ifdef Q_OS_WIN32
-	LARGE_INTEGER freq, newTime;
-	QueryPerformanceFrequency(&freq);
-	QueryPerformanceCounter(&newTime);
-	double newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
-#else
-   timespec newTime;
-   clock_gettime(CLOCK_MONOTONIC, &newTime);
-   double newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
-#endif
-
-   double previousNumberOfSeconds = newNumberOfSeconds;
-   double previousNumberOfSeconds_ms = newNumberOfSeconds;
-   double previousNumberOfSeconds_s = newNumberOfSeconds;
-   double ElapsedTime;
-
-	PreviousSignalling.CUEActive = 0;
-	PreviousSignalling.CommActive = 0;
-	PreviousSignalling.Redlight1Active = 0;
-	PreviousSignalling.Redlight2Active = 0;
-	PreviousSignalling.Redlight3Active = 0;
-	PreviousSignalling.Redlight4Active = 0;
-	PreviousSignalling.Redlight5Active = 0;
-	PreviousSignalling.Redlight6Active = 0;
-	PreviousSignalling.Redlight7Active = 0;
-	PreviousSignalling.Redlight8Active = 0;
-	PreviousSignalling.CRMMuteActive = 0;
-	PreviousSignalling.CUEMuteActive = 0;
-	PreviousSignalling.Studio1MuteActive = 0;
-	PreviousSignalling.Studio2MuteActive = 0;
-	PreviousSignalling.Studio3MuteActive = 0;
-	PreviousSignalling.Studio4MuteActive = 0;
-	PreviousSignalling.Studio5MuteActive = 0;
-	PreviousSignalling.Studio6MuteActive = 0;
-	PreviousSignalling.Studio7MuteActive = 0;
-	PreviousSignalling.Studio8MuteActive = 0;
-	for (cntStudio=0; cntStudio<9; cntStudio++)
-	{
-		for (cntOutput=0; cntOutput<3; cntOutput++)
-		{
-			PreviousSignalling.RelatedOutput[cntStudio][cntOutput] = 0;
-		}
-	}
    ProcessID = getpid();
-         
+
    serial_struct SerialInformation;              
    struct termios tio;
    int ioctl_arg;
-   fd_set readfs;
    
    fd = open("/dev/ttyS1", O_RDWR | O_NOCTTY | O_NDELAY);
    if (fd<0)
@@ -355,199 +312,197 @@ void DNREngineThread::run()
          printf("could not enable signals.r\n");
       }
    
-      FD_SET(fd, &readfs);       // set testing for source 
    }
-   
-   int maxfd;
-   struct timeval tw;           
-   
-   maxfd = fd+1;              // maximum bit entry (fd) to test 
 
-   // block until input becomes available
-   tw.tv_sec = 0;           
-   tw.tv_usec = 1000;
-   
-   
-   forever
+#ifdef Q_OS_WIN32
+	LARGE_INTEGER freq, newTime;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&newTime);
+	previousNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
+#else
+   timespec newTime;
+   clock_gettime(CLOCK_MONOTONIC, &newTime);
+   previousNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
+#endif
+
+   QSocketNotifier *SerialNotifier = NULL;
+   if (fd>=0)
    {
-		if (abort)
-      {
-         ::close((int)fd);
-			return;
-      }
-      
-      if (fd>=0)
-      {
-         FD_SET(fd, &readfs);       // set testing for source 
-         select(maxfd, &readfs, NULL, NULL, &tw);          
-         if (FD_ISSET(fd, &readfs))         // input from source 1 available 
-         {        
-            int NrOfBytesReceived = read(fd, ReceiveBuffer, 128);
-            SerialPortDebugMessage.sprintf("Received %d\n", NrOfBytesReceived);
-            
-            if (NrOfBytesReceived>0)
-            {
-               unsigned char Buffer8Bit[99];
-               unsigned char Buffer8BitLength;
-               unsigned int Level;
-               unsigned int MessageType;
-               
-               MessageType = (((unsigned int)ReceiveBuffer[9])<<7)&0x3F80;
-               MessageType |= (ReceiveBuffer[10]&0x7F);
-               
-               if (MessageType == 1)
-               {
-                  Buffer8BitLength = Decode7to8bits(&ReceiveBuffer[PROTOCOL_OVERHEAD-1], cntReceiveBuffer-PROTOCOL_OVERHEAD, Buffer8Bit);
-                  Level = ((unsigned int)Buffer8Bit[0]<<8) | Buffer8Bit[1];
-
-                  emit FaderLevelChanged(0, Level*4);
-               }
-            }
-         }
-      }
-      else
+      SerialNotifier = new QSocketNotifier(fd, QSocketNotifier::Read);
+      connect(SerialNotifier, SIGNAL(activated(int)), this, SLOT(doSerialRead()), Qt::DirectConnection);
+   }
+   else
+   {
+      SerialPortDebugMessage.sprintf("fd = %d\n", fd);
+   }
+
+	//30Hz timers for meter releas
+   QTimer TickTimer;
+   connect(&TickTimer, SIGNAL(timeout()), this, SLOT(doTimerTick()), Qt::DirectConnection);
+   TickTimer.start(33);
+
+   //3Hz timer for debug
+   QTimer MeterTimer;
+   connect(&MeterTimer, SIGNAL(timeout()), this, SLOT(doMeterTimer()), Qt::DirectConnection);
+   MeterTimer.start(330);
+
+   exec();
+
+   delete SerialNotifier;
+   if (fd>=0)
+   {
+      ::close((int)fd);
+      fd = -1;
+   }
+}
+
+void DNREngineThread::doSerialRead()
+{
+   int NrOfBytesReceived;
+
+   //the line discipline returns one message per read
+   while ((NrOfBytesReceived = read(fd, ReceiveBuffer, 128)) > 0)
+   {
+      unsigned char Buffer8Bit[99];
+      unsigned char Buffer8BitLength;
+      unsigned int Level;
+      unsigned int MessageType;
+
+      cntReceiveBuffer = NrOfBytesReceived;
+      SerialPortDebugMessage.sprintf("Received %d\n", NrOfBytesReceived);
+
+      MessageType = (((unsigned int)ReceiveBuffer[9])<<7)&0x3F80;
+      MessageType |= (ReceiveBuffer[10]&0x7F);
+
+      if ((MessageType == 1) && (cntReceiveBuffer > PROTOCOL_OVERHEAD))
       {
-         SerialPortDebugMessage.sprintf("fd = %d\n", fd);
+         Buffer8BitLength = Decode7to8bits(&ReceiveBuffer[PROTOCOL_OVERHEAD-1], cntReceiveBuffer-PROTOCOL_OVERHEAD, Buffer8Bit);
+         Level = ((unsigned int)Buffer8Bit[0]<<8) | Buffer8Bit[1];
+
+         emit FaderLevelChanged(0, Level*4);
       }
-      
+   }
+}
 
+void DNREngineThread::doTimerTick()
+{
 #ifdef Q_OS_WIN32
-		QueryPerformanceCounter(&newTime);
-		newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
+	LARGE_INTEGER freq, newTime;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&newTime);
+	double newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
 #else
-	   clock_gettime(CLOCK_MONOTONIC, &newTime);
-   	newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
+   timespec newTime;
+   clock_gettime(CLOCK_MONOTONIC, &newTime);
+   double newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
 #endif
 
-      LastElapsedTime = newNumberOfSeconds-previousNumberOfSeconds;
-      previousNumberOfSeconds = newNumberOfSeconds;
+   LastElapsedTime = newNumberOfSeconds-previousNumberOfSeconds;
+   previousNumberOfSeconds = newNumberOfSeconds;
 
-//Timers
-		//30Hz timers for meter releas
-      ElapsedTime = newNumberOfSeconds-previousNumberOfSeconds_ms;
-      if (ElapsedTime >= 0.033)
-      {
-         emit TimerTick(0);
-         previousNumberOfSeconds_ms = newNumberOfSeconds;
-      }
-      //1 Second timer for debug
-      ElapsedTime = newNumberOfSeconds-previousNumberOfSeconds_s;
-      if (ElapsedTime >= 0.33)
-      {
-         float level = -20+(((float)rand()*25)/RAND_MAX);
-         
-         emit MeterChange(level);
-         previousNumberOfSeconds_s = newNumberOfSeconds;
-      }
+   emit TimerTick(0);
+}
+
+void DNREngineThread::doMeterTimer()
+{
+   float level = -20+(((float)rand()*25)/RAND_MAX);
+
+   emit MeterChange(level);
+}
+
+//Emits the changes of one channel, called from the slots that change it
+void DNREngineThread::ProcessChannelChanges(int cntChannel)
+{
+   if (PreviousAxumData.ModuleData[cntChannel].FaderPosition != AxumData.ModuleData[cntChannel].FaderPosition)
+   {
+      emit FaderLevelChanged(cntChannel, AxumData.ModuleData[cntChannel].FaderPosition);
+      PreviousAxumData.ModuleData[cntChannel].FaderPosition = AxumData.ModuleData[cntChannel].FaderPosition;
+   }
+
+   if (PreviousAxumData.ModuleData[cntChannel].EQBand1.Level != AxumData.ModuleData[cntChannel].EQBand1.Level)
+   {
+      emit EQBand1LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand1.Level);
+      PreviousAxumData.ModuleData[cntChannel].EQBand1.Level = AxumData.ModuleData[cntChannel].EQBand1.Level;
+   }
+
+   if (PreviousAxumData.ModuleData[cntChannel].EQBand2.Level != AxumData.ModuleData[cntChannel].EQBand2.Level)
+   {
+      emit EQBand2LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand2.Level);
+      PreviousAxumData.ModuleData[cntChannel].EQBand2.Level = AxumData.ModuleData[cntChannel].EQBand2.Level;
+   }
+
+   if (PreviousAxumData.ModuleData[cntChannel].EQBand3.Level != AxumData.ModuleData[cntChannel].EQBand3.Level)
+   {
+      emit EQBand3LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand3.Level);
+      PreviousAxumData.ModuleData[cntChannel].EQBand3.Level = AxumData.ModuleData[cntChannel].EQBand3.Level;
+   }
+
+   if (PreviousAxumData.ModuleData[cntChannel].EQBand4.Level != AxumData.ModuleData[cntChannel].EQBand4.Level)
+   {
+      emit EQBand4LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand4.Level);
+      PreviousAxumData.ModuleData[cntChannel].EQBand4.Level = AxumData.ModuleData[cntChannel].EQBand4.Level;
+   }
+}
+
+//Redlight 1 is on while any open fader has the redlight 1 setting
+void DNREngineThread::ProcessSignalling()
+{
+   SIGNALLING_STRUCT Signalling;
 
-		//Start of signalling functions
-	   Signalling.CUEActive = 0;
-		Signalling.CommActive = 0;
-		Signalling.Redlight1Active = 0;
-		Signalling.Redlight2Active = 0;
-		Signalling.Redlight3Active = 0;
-		Signalling.Redlight4Active = 0;
-		Signalling.Redlight5Active = 0;
-		Signalling.Redlight6Active = 0;
-		Signalling.Redlight7Active = 0;
-		Signalling.Redlight8Active = 0;
-	   Signalling.CRMMuteActive = 0;
-   	Signalling.CUEMuteActive = 0;
-	   Signalling.Studio1MuteActive = 0;
-   	Signalling.Studio2MuteActive = 0;
-	   Signalling.Studio3MuteActive = 0;
-   	Signalling.Studio4MuteActive = 0;
-	   Signalling.Studio5MuteActive = 0;
-   	Signalling.Studio6MuteActive = 0;
-	   Signalling.Studio7MuteActive = 0;
-   	Signalling.Studio8MuteActive = 0;
-	   for (cntStudio=0; cntStudio<9; cntStudio++)
-   	{
-      	for (cntOutput=0; cntOutput<3; cntOutput++)
-	      {
-         	Signalling.RelatedOutput[cntStudio][cntOutput] = 0;
-      	}
-   	}
-
-      for (int cntChannel=0; cntChannel<MAXNUMBEROFCHANNELS; cntChannel++)
+   memset(&Signalling, 0, sizeof(Signalling));
+   for (int cntChannel=0; cntChannel<MAXNUMBEROFCHANNELS; cntChannel++)
+   {
+      if ((AxumData.ModuleData[cntChannel].FaderPosition > FADER_CLOSE_LEVEL) &&
+          (AxumData.ModuleData[cntChannel].Settings.Redlight1))
       {
-         if (PreviousAxumData.ModuleData[cntChannel].FaderPosition != AxumData.ModuleData[cntChannel].FaderPosition)
-         {
-				if (AxumData.ModuleData[cntChannel].FaderPosition > FADER_CLOSE_LEVEL)
-				{
-					if (AxumData.ModuleData[cntChannel].Settings.Redlight1)
-					{
-						Signalling.Redlight1Active = 1;
-					}
-				}
-            emit FaderLevelChanged(cntChannel, AxumData.ModuleData[cntChannel].FaderPosition);
-            PreviousAxumData.ModuleData[cntChannel].FaderPosition = AxumData.ModuleData[cntChannel].FaderPosition;
-         }
-
-         if (PreviousAxumData.ModuleData[cntChannel].EQBand1.Level != AxumData.ModuleData[cntChannel].EQBand1.Level)
-         {
-            emit EQBand1LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand1.Level);
-            PreviousAxumData.ModuleData[cntChannel].EQBand1.Level = AxumData.ModuleData[cntChannel].EQBand1.Level;
-         }
-
-         if (PreviousAxumData.ModuleData[cntChannel].EQBand2.Level != AxumData.ModuleData[cntChannel].EQBand2.Level)
-         {
-            emit EQBand2LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand2.Level);
-            PreviousAxumData.ModuleData[cntChannel].EQBand2.Level = AxumData.ModuleData[cntChannel].EQBand2.Level;
-         }
-
-         if (PreviousAxumData.ModuleData[cntChannel].EQBand3.Level != AxumData.ModuleData[cntChannel].EQBand3.Level)
-         {
-            emit EQBand3LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand3.Level);
-            PreviousAxumData.ModuleData[cntChannel].EQBand3.Level = AxumData.ModuleData[cntChannel].EQBand3.Level;
-         }
-
-         if (PreviousAxumData.ModuleData[cntChannel].EQBand4.Level != AxumData.ModuleData[cntChannel].EQBand4.Level)
-         {
-            emit EQBand4LevelChanged(cntChannel, AxumData.ModuleData[cntChannel].EQBand4.Level);
-            PreviousAxumData.ModuleData[cntChannel].EQBand4.Level = AxumData.ModuleData[cntChannel].EQBand4.Level;
-         }
+         Signalling.Redlight1Active = 1;
+         break;
       }
+   }
 
-      if (PreviousSignalling.Redlight1Active != Signalling.Redlight1Active)
-      {
-			if (Signalling.Redlight1Active)
-			{
-				emit Redlight1Changed(POSITION_RESOLUTION);
-			}
-			else
-			{
-				emit Redlight1Changed(0);
-			}
-			PreviousSignalling.Redlight1Active = Signalling.Redlight1Active;
+   if (PreviousSignalling.Redlight1Active != Signalling.Redlight1Active)
+   {
+		if (Signalling.Redlight1Active)
+		{
+			emit Redlight1Changed(POSITION_RESOLUTION);
 		}
-      usleep(100);
-   }
+		else
+		{
+			emit Redlight1Changed(0);
+		}
+		PreviousSignalling.Redlight1Active = Signalling.Redlight1Active;
+	}
 }
 
 void DNREngineThread::doBand1EQPositionChange(int_number ChannelNr, double_position Position)
 {
 	AxumData.ModuleData[ChannelNr].EQBand1.Level = Position;
+	ProcessChannelChanges(ChannelNr);
 }
 
 void DNREngineThread::doBand2EQPositionChange(int_number ChannelNr, double_position Position)
 {
 	AxumData.ModuleData[ChannelNr].EQBand2.Level = Position;
+	ProcessChannelChanges(ChannelNr);
 }
 
 void DNREngineThread::doBand3EQPositionChange(int_number ChannelNr, double_position Position)
 {
 	AxumData.ModuleData[ChannelNr].EQBand3.Level = Position;
+	ProcessChannelChanges(ChannelNr);
 }
 
 void DNREngineThread::doBand4EQPositionChange(int_number ChannelNr, double_position Position)
 {
 	AxumData.ModuleData[ChannelNr].EQBand4.Level = Position;
+	ProcessChannelChanges(ChannelNr);
 }
 
 void DNREngineThread::doFaderChange(int_number ChannelNr, double_position Position)
 {
 	AxumData.ModuleData[ChannelNr].FaderPosition = Position;
+	ProcessChannelChanges(ChannelNr);
+	ProcessSignalling();
 
    if (ChannelNr == 0)
    {
@@ -573,6 +528,7 @@ void DNREngineThread::doRedlight1SettingChange(int_number ChannelNr, double_posi
 	{
 		AxumData.ModuleData[ChannelNr].Settings.Redlight1 = 1;
 	}
+	ProcessSignalling();
 }
 
 int DNREngineThread::getProcessID()
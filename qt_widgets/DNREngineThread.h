@@ -122,6 +122,11 @@ public slots:
 
 	void doRedlight1SettingChange(int_number ChannelNr, double_position Position);
 
+private slots:
+	void doSerialRead();
+	void doTimerTick();
+	void doMeterTimer();
+
 signals:
 	void FaderLevelChanged(int_number ChannelNr, double_position Position);
 	void EQBand1LevelChanged(int_number ChannelNr, double_position Position);
@@ -135,7 +140,11 @@ signals:
    
 protected:
 	void run();
-	bool abort;
+	void ProcessChannelChanges(int cntChannel);
+	void ProcessSignalling();
+
+	SIGNALLING_STRUCT PreviousSignalling;
+	double previousNumberOfSeconds;
    
    
 
@@ -24,6 +24,7 @@
 #include <QtGui>
 
 #include "DNRFader.h"
+#include "DNRSkinAtlas.h"
 
 DNRFader::DNRFader(QWidget *parent)
     : QWidget(parent)
@@ -34,9 +35,6 @@ DNRFader::DNRFader(QWidget *parent)
    FBorderColor = QColor(0,64,128);
    FKnobColor = QColor(192,224,255);
 
-   QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-   FaderKnobQImage = new QImage(AxumSkinPath + "/" + FFaderKnobFileName);
-
    setWindowTitle(tr("Fader"));
    resize(27, 256);
 }
@@ -68,7 +66,7 @@ void DNRFader::paintEvent(QPaintEvent *)
     painter.setPen(FBorderColor);
     painter.setBrush(FKnobColor);
 
-    if (FaderKnobQImage->isNull())
+    if (FaderKnobPixmap.isNull())
     {
 		double dx = 1600/FADER_KNOB_WIDTH;
 		double dy = 1600/FADER_KNOB_HEIGHT;
@@ -78,7 +76,13 @@ void DNRFader::paintEvent(QPaintEvent *)
     }
     else
     {
-      painter.drawImage((FADER_GRAPHICS_RESOLUTION_X-FADER_KNOB_WIDTH)/2,FADER_GRAPHICS_RESOLUTION_Y-(((FADER_GRAPHICS_RESOLUTION_Y-FADER_TRACK_LENGTH)/2)+(FADER_KNOB_HEIGHT/2)+((FPosition*FADER_TRACK_LENGTH)/POSITION_RESOLUTION)), *FaderKnobQImage);
+      double KnobX = (FADER_GRAPHICS_RESOLUTION_X-FADER_KNOB_WIDTH)/2;
+      double KnobY = FADER_GRAPHICS_RESOLUTION_Y-(((FADER_GRAPHICS_RESOLUTION_Y-FADER_TRACK_LENGTH)/2)+(FADER_KNOB_HEIGHT/2)+((FPosition*FADER_TRACK_LENGTH)/POSITION_RESOLUTION));
+      QSize KnobSize((int)((FaderKnobPixmap.width()*Ratio)+0.5), (int)((FaderKnobPixmap.height()*Ratio)+0.5));
+
+      //the knob comes pre-scaled from the skin atlas and is drawn unscaled
+      painter.resetMatrix();
+      painter.drawPixmap((int)((KnobX*Ratio)+0.5), (int)((KnobY*Ratio)+0.5), DNRSkinAtlas::ScaledPixmap(FSkinEnvironmentVariable, FFaderKnobFileName, KnobSize));
     }
 
 }
@@ -158,13 +162,7 @@ void DNRFader::setSkinEnvironmentVariable(const QString &NewSkinEnvironmentVaria
    {
       FSkinEnvironmentVariable = NewSkinEnvironmentVariable;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!FaderKnobQImage->load(AxumSkinPath + "/" + FFaderKnobFileName))
-      {
-		  delete FaderKnobQImage;
-		  FaderKnobQImage = new QImage();
-
-	  }
+      FaderKnobPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FFaderKnobFileName);
       update();
    }
 }
@@ -180,13 +178,7 @@ void DNRFader::setFaderKnobFileName(const QString &NewFaderKnobFileName)
    {
       FFaderKnobFileName = NewFaderKnobFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!FaderKnobQImage->load(AxumSkinPath + "/" + FFaderKnobFileName))
-      {
-		  delete FaderKnobQImage;
-		  FaderKnobQImage = new QImage();
-
-	  }
+      FaderKnobPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FFaderKnobFileName);
       update();
    }
 }
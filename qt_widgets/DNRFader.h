@@ -42,6 +42,7 @@
 
 #include "DNRDefines.h"
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QDESIGNER_WIDGET_EXPORT DNRFader : public QWidget
@@ -56,7 +57,7 @@ class QDESIGNER_WIDGET_EXPORT DNRFader : public QWidget
     Q_PROPERTY(QString FaderKnobFileName READ getFaderKnobFileName WRITE setFaderKnobFileName);
 public:
     DNRFader(QWidget *parent = 0);
-    QImage *FaderKnobQImage;
+    QPixmap FaderKnobPixmap;
 
     int FNumber;
     void setNumber(int NewNumber);
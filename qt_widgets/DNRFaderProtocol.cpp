@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QTcpSocket>
+
+#include "DNRFaderProtocol.h"
+
+#ifndef Q_OS_WIN32
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+DNRFaderDecoder::DNRFaderDecoder()
+{
+   cntByteInSlot = 0;
+}
+
+void DNRFaderDecoder::Reset()
+{
+   cntByteInSlot = 0;
+}
+
+bool DNRFaderDecoder::Decode(const unsigned char *&Data, const unsigned char *End, int &ChannelNr, int &Position)
+{
+   while (Data<End)
+   {
+      unsigned char Byte = *Data++;
+
+      if ((Byte&0x81) == 0x80)
+      {
+         cntByteInSlot = 0;
+      }
+
+      if (cntByteInSlot<FADER_MAX_SLOT_LENGTH)
+      {
+         MessageSlot[cntByteInSlot++] = Byte;
+
+         if ((Byte&0x81) == 0x81)
+         {  //End of a message
+            if ((MessageSlot[0] == 0x80) && (cntByteInSlot >= FADER_MESSAGE_LENGTH))
+            {
+               ChannelNr = (MessageSlot[2]<<7) | MessageSlot[1];
+               Position = (MessageSlot[4]<<7) | MessageSlot[3];
+               cntByteInSlot = 0;
+               return true;
+            }
+         }
+      }
+      else
+      {
+         cntByteInSlot = 0;
+      }
+   }
+   return false;
+}
+
+bool DNRFaderEncoder::Add(int ChannelNr, int Position)
+{
+   bool FirstChange = PendingChannels.isEmpty();
+
+   if (!PendingPosition.contains(ChannelNr))
+   {
+      PendingChannels.append(ChannelNr);
+   }
+   PendingPosition.insert(ChannelNr, Position);
+
+   return FirstChange;
+}
+
+bool DNRFaderEncoder::IsEmpty() const
+{
+   return PendingChannels.isEmpty();
+}
+
+void DNRFaderEncoder::Encode(QByteArray &Buffer)
+{
+   int Offset = Buffer.size();
+
+   Buffer.resize(Offset+(PendingChannels.count()*FADER_MESSAGE_LENGTH));
+   unsigned char *MessageData = (unsigned char *)Buffer.data()+Offset;
+
+   for (int cntChannel=0; cntChannel<PendingChannels.count(); cntChannel++)
+   {
+      int ChannelNr = PendingChannels.at(cntChannel);
+      int Position = PendingPosition.value(ChannelNr);
+
+      MessageData[0] = 0x80;
+      MessageData[1] = ChannelNr&0x7F;
+      MessageData[2] = (ChannelNr>>7)&0x7F;
+      MessageData[3] = Position&0x7F;
+      MessageData[4] = (Position>>7)&0x7F;
+      MessageData[5] = MessageData[0] | 0x01;
+      MessageData += FADER_MESSAGE_LENGTH;
+   }
+
+   PendingPosition.clear();
+   PendingChannels.clear();
+}
+
+void setLowDelay(QTcpSocket *Socket)
+{
+#ifndef Q_OS_WIN32
+   int Enable = 1;
+   if (Socket->socketDescriptor() != -1)
+   {
+      setsockopt(Socket->socketDescriptor(), IPPROTO_TCP, TCP_NODELAY, &Enable, sizeof(Enable));
+   }
+#else
+   Q_UNUSED(Socket);
+#endif
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef DNRFADERPROTOCOL_H
+#define DNRFADERPROTOCOL_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QtDesigner/QDesignerExportWidget>
+
+class QTcpSocket;
+
+//Fader position message: 0x80, channel (2x7 bits), position (2x7 bits), 0x81
+#define FADER_MESSAGE_LENGTH     6
+#define FADER_MAX_SLOT_LENGTH    16
+
+//Outbound positions are collected for this many ms and sent as one write
+#define FADER_FRAME_INTERVAL     10
+
+//Streaming decoder, a partial message is kept until the next read.
+//Decode() walks the buffer in place and stops after each complete message.
+class QDESIGNER_WIDGET_EXPORT DNRFaderDecoder
+{
+public:
+    DNRFaderDecoder();
+
+    bool Decode(const unsigned char *&Data, const unsigned char *End, int &ChannelNr, int &Position);
+    void Reset();
+
+protected:
+    unsigned char MessageSlot[FADER_MAX_SLOT_LENGTH];
+    int cntByteInSlot;
+};
+
+//Keeps only the latest position per channel until the frame is flushed
+class QDESIGNER_WIDGET_EXPORT DNRFaderEncoder
+{
+public:
+    //Returns true if this is the first pending change of the frame
+    bool Add(int ChannelNr, int Position);
+    bool IsEmpty() const;
+
+    //Appends all pending messages to Buffer and clears them
+    void Encode(QByteArray &Buffer);
+
+protected:
+    QHash<int, int> PendingPosition;
+    QList<int> PendingChannels;
+};
+
+//Disables Nagle, the frame interval already batches the small writes
+extern void setLowDelay(QTcpSocket *Socket);
+
+#endif
@@ -24,6 +24,7 @@
 #include <QtGui>
 #include "DNRDefines.h"
 #include "DNRIndication.h"
+#include "DNRSkinAtlas.h"
 
 DNRIndication::DNRIndication(QWidget *parent)
     : QWidget(parent)
@@ -31,12 +32,6 @@ DNRIndication::DNRIndication(QWidget *parent)
     FNumber = 0;
     FState = 0;
 
-    QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-    State1QImage = new QImage(AxumSkinPath + "/" + FState1ImageFileName);
-    State2QImage = new QImage(AxumSkinPath + "/" + FState2ImageFileName);
-    State3QImage = new QImage(AxumSkinPath + "/" + FState3ImageFileName);
-    State4QImage = new QImage(AxumSkinPath + "/" + FState4ImageFileName);
-
     setWindowTitle(tr("Indication"));
     resize(16, 16);
 }
@@ -50,7 +45,7 @@ void DNRIndication::paintEvent(QPaintEvent *)
 	{
 		case 0:
 		{
-		    if (State1QImage->isNull())
+		    if (State1Pixmap.isNull())
     		{
 				painter.setBrush(Qt::NoBrush);
 				painter.setPen(QColor(0,0,0));
@@ -60,13 +55,13 @@ void DNRIndication::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *State1QImage);
+			    painter.drawPixmap(0, 0, State1Pixmap);
 		    }
 		}
 		break;
 		case 1:
 		{
-		    if (State2QImage->isNull())
+		    if (State2Pixmap.isNull())
     		{
 				painter.setBrush(Qt::NoBrush);
 				painter.setPen(QColor(0,0,0));
@@ -76,13 +71,13 @@ void DNRIndication::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *State2QImage);
+			    painter.drawPixmap(0, 0, State2Pixmap);
 		    }
 		}
 		break;
 		case 2:
 		{
-		    if (State3QImage->isNull())
+		    if (State3Pixmap.isNull())
     		{
 				painter.setBrush(Qt::NoBrush);
 				painter.setPen(QColor(0,0,0));
@@ -92,13 +87,13 @@ void DNRIndication::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *State3QImage);
+			    painter.drawPixmap(0, 0, State3Pixmap);
 		    }
 		}
 		break;
 		case 3:
 		{
-		    if (State4QImage->isNull())
+		    if (State4Pixmap.isNull())
     		{
 				painter.setBrush(Qt::NoBrush);
 				painter.setPen(QColor(0,0,0));
@@ -108,7 +103,7 @@ void DNRIndication::paintEvent(QPaintEvent *)
     		}
 		    else
     		{
-			    painter.drawImage(0, 0, *State4QImage);
+			    painter.drawPixmap(0, 0, State4Pixmap);
 		    }
 		}
 		break;
@@ -176,32 +171,11 @@ void DNRIndication::setSkinEnvironmentVariable(const QString &NewSkinEnvironment
    {
       FSkinEnvironmentVariable = NewSkinEnvironmentVariable;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-
-      if (!State1QImage->load(AxumSkinPath + "/" + FState1ImageFileName))
-      {
-		  delete State1QImage;
-		  State1QImage = new QImage();
-
-	  }
-      if (!State2QImage->load(AxumSkinPath + "/" + FState2ImageFileName))
-      {
-		  delete State2QImage;
-		  State2QImage = new QImage();
-
-	  }
-      if (!State3QImage->load(AxumSkinPath + "/" + FState3ImageFileName))
-      {
-		  delete State3QImage;
-		  State3QImage = new QImage();
-
-	  }
-      if (!State4QImage->load(AxumSkinPath + "/" + FState4ImageFileName))
-      {
-		  delete State4QImage;
-		  State4QImage = new QImage();
 
-	  }
+      State1Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState1ImageFileName);
+      State2Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState2ImageFileName);
+      State3Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState3ImageFileName);
+      State4Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState4ImageFileName);
 
       update();
    }
@@ -218,13 +192,7 @@ void DNRIndication::setState1ImageFileName(const QString &NewState1ImageFileName
    {
       FState1ImageFileName = NewState1ImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!State1QImage->load(AxumSkinPath + "/" + FState1ImageFileName))
-      {
-		  delete State1QImage;
-		  State1QImage = new QImage();
-
-	  }
+      State1Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState1ImageFileName);
       update();
    }
 }
@@ -240,13 +208,7 @@ void DNRIndication::setState2ImageFileName(const QString &NewState2ImageFileName
    {
       FState2ImageFileName = NewState2ImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!State2QImage->load(AxumSkinPath + "/" + FState2ImageFileName))
-      {
-		  delete State2QImage;
-		  State2QImage = new QImage();
-
-	  }
+      State2Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState2ImageFileName);
       update();
    }
 }
@@ -262,13 +224,7 @@ void DNRIndication::setState3ImageFileName(const QString &NewState3ImageFileName
    {
       FState3ImageFileName = NewState3ImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!State3QImage->load(AxumSkinPath + "/" + FState3ImageFileName))
-      {
-		  delete State3QImage;
-		  State3QImage = new QImage();
-
-	  }
+      State3Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState3ImageFileName);
       update();
    }
 }
@@ -284,13 +240,7 @@ void DNRIndication::setState4ImageFileName(const QString &NewState4ImageFileName
    {
       FState4ImageFileName = NewState4ImageFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!State4QImage->load(AxumSkinPath + "/" + FState4ImageFileName))
-      {
-		  delete State4QImage;
-		  State4QImage = new QImage();
-
-	  }
+      State4Pixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FState4ImageFileName);
       update();
    }
 }
@@ -26,6 +26,7 @@
 
 #include "DNRDefines.h"
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QDESIGNER_WIDGET_EXPORT DNRIndication : public QWidget
@@ -42,10 +43,10 @@ class QDESIGNER_WIDGET_EXPORT DNRIndication : public QWidget
 public:
     DNRIndication(QWidget *parent = 0);
 
-    QImage *State1QImage;
-    QImage *State2QImage;
-    QImage *State3QImage;
-    QImage *State4QImage;
+    QPixmap State1Pixmap;
+    QPixmap State2Pixmap;
+    QPixmap State3Pixmap;
+    QPixmap State4Pixmap;
 
     int FNumber;
     void setNumber(int NewNumber);
@@ -0,0 +1,569 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+
+#include <QtGui>
+#include <math.h>
+
+#include "DNRMeterBridge.h"
+
+DNRMeterBridge::DNRMeterBridge(QWidget *parent)
+    : QWidget(parent)
+{
+    FNumberOfChannels = 0;
+    FFirstChannel = 0;
+    FMeterSpacing = 2;
+    FLabelHeight = 0;
+    FMindBPosition = -50;
+    FMaxdBPosition = +5;
+    FDINCurve = true;
+    FGradientBackground = true;
+    FGradientForground = false;
+
+    FMaxColor = QColor(255,0,0,255);
+    FMinColor = QColor(0,255,0,255);
+    FMaxBackgroundColor = QColor(64,0,0,255);
+    FMinBackgroundColor = QColor(0,64,0,255);
+    FLabelColor = QColor(255,255,255,255);
+
+    MeterWidth = 0;
+    StripHeight = 0;
+    ZerodBHeight = 0;
+    StripsValid = false;
+
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    setWindowTitle(tr("Meter Bridge"));
+    resize(200, 200);
+    setNumberOfChannels(8);
+}
+
+void DNRMeterBridge::CalculateScale()
+{
+   double LiniearMax = pow(10,((double)FMaxdBPosition+MINCURVE)/DIVCURVE);
+   LiniearMin = pow(10,((double)FMindBPosition+MINCURVE)/DIVCURVE);
+   LiniearRange = LiniearMax-LiniearMin;
+   dBRange = FMaxdBPosition-FMindBPosition;
+
+   MeterWidth = 1;
+   if (FNumberOfChannels>0)
+   {
+      MeterWidth = (width()-((FNumberOfChannels-1)*FMeterSpacing))/FNumberOfChannels;
+      if (MeterWidth<1)
+      {
+         MeterWidth = 1;
+      }
+   }
+   StripHeight = height()-FLabelHeight;
+   if (StripHeight<0)
+   {
+      StripHeight = 0;
+   }
+
+   if (FDINCurve)
+   {
+      ZerodBHeight = (int)(((1-LiniearMin)*StripHeight)/LiniearRange);
+   }
+   else
+   {
+      ZerodBHeight = (int)(-FMindBPosition*StripHeight)/dBRange;
+   }
+}
+
+int DNRMeterBridge::CalculateHeight(double dBPosition)
+{
+   if (FDINCurve)
+   {
+      double Pos = pow(10,((double)dBPosition+MINCURVE)/DIVCURVE);
+      return (int)(((Pos-LiniearMin)*StripHeight)/LiniearRange);
+   }
+   else
+   {
+      double AbsolutedBPosition = dBPosition-FMindBPosition;
+      return (int)(AbsolutedBPosition*StripHeight)/dBRange;
+   }
+}
+
+QRect DNRMeterBridge::MeterRect(int Channel)
+{
+   return QRect(Channel*(MeterWidth+FMeterSpacing), 0, MeterWidth, StripHeight);
+}
+
+//Adds the band between the previous and the new level to Dirty
+bool DNRMeterBridge::CalculateMeter(int Channel, QRegion &Dirty)
+{
+   double dBPosition = FdBPositions[Channel];
+   if (dBPosition<FMindBPosition)
+   {
+      dBPosition = FMindBPosition;
+   }
+   if (dBPosition>FMaxdBPosition)
+   {
+      dBPosition = FMaxdBPosition;
+   }
+   FdBPositions[Channel] = dBPosition;
+
+   bool Changed = 0;
+   int NewHeight = CalculateHeight(dBPosition);
+   int OldHeight = MeterHeights[Channel];
+   if (NewHeight != OldHeight)
+   {
+      int Top = StripHeight-((OldHeight>NewHeight) ? OldHeight : NewHeight);
+      Dirty += QRect(MeterRect(Channel).left(), Top, MeterWidth, qAbs(OldHeight-NewHeight));
+      MeterHeights[Channel] = NewHeight;
+      Changed = 1;
+   }
+
+   int NewPeakHeight = 0;
+   if (FPeakdBPositions[Channel]>dBPosition)
+   {
+      double PeakdBPosition = FPeakdBPositions[Channel];
+      if (PeakdBPosition>FMaxdBPosition)
+      {
+         PeakdBPosition = FMaxdBPosition;
+      }
+      NewPeakHeight = CalculateHeight(PeakdBPosition);
+   }
+   int OldPeakHeight = PeakHeights[Channel];
+   if (NewPeakHeight != OldPeakHeight)
+   {
+      if (OldPeakHeight>0)
+      {
+         Dirty += QRect(MeterRect(Channel).left(), StripHeight-OldPeakHeight, MeterWidth, PEAK_HOLD_HEIGHT);
+      }
+      if (NewPeakHeight>0)
+      {
+         Dirty += QRect(MeterRect(Channel).left(), StripHeight-NewPeakHeight, MeterWidth, PEAK_HOLD_HEIGHT);
+      }
+      PeakHeights[Channel] = NewPeakHeight;
+      Changed = 1;
+   }
+   return Changed;
+}
+
+void DNRMeterBridge::setLevels(const float *dBPositions, const float *PeakdBPositions, int Count)
+{
+   QRegion Dirty;
+
+   if (Count>FNumberOfChannels)
+   {
+      Count = FNumberOfChannels;
+   }
+   for (int cntChannel=0; cntChannel<Count; cntChannel++)
+   {
+      FdBPositions[cntChannel] = dBPositions[cntChannel];
+      FPeakdBPositions[cntChannel] = PeakdBPositions ? PeakdBPositions[cntChannel] : FMindBPosition;
+      CalculateMeter(cntChannel, Dirty);
+   }
+
+   if (!Dirty.isEmpty())
+   {
+      update(Dirty);
+   }
+}
+
+void DNRMeterBridge::setdBPosition(int_number Channel, double_db NewdBPosition)
+{
+   if ((Channel>=0) && (Channel<FNumberOfChannels))
+   {
+      QRegion Dirty;
+
+      FdBPositions[Channel] = NewdBPosition;
+      if (CalculateMeter(Channel, Dirty))
+      {
+         update(Dirty);
+      }
+   }
+}
+
+double DNRMeterBridge::getdBPosition(int Channel)
+{
+   if ((Channel>=0) && (Channel<FNumberOfChannels))
+   {
+      return FdBPositions[Channel];
+   }
+   return FMindBPosition;
+}
+
+void DNRMeterBridge::PaintBackground(QPainter &painter, int Left)
+{
+  int HalfHeight = ((float)StripHeight/2)+0.5;
+
+  if (FGradientBackground)
+  {
+    QLinearGradient BackgroundGradient(0, HalfHeight, 0, 0);
+    BackgroundGradient.setColorAt(0, FMinBackgroundColor);
+    BackgroundGradient.setColorAt(1, FMaxBackgroundColor);
+
+    painter.setBrush(FMinBackgroundColor);
+    painter.drawRect(Left, HalfHeight, MeterWidth, StripHeight-HalfHeight);
+
+    painter.setBrush(QBrush(BackgroundGradient));
+    painter.drawRect(Left, 0, MeterWidth, HalfHeight);
+  }
+  else
+  {
+    painter.setBrush(FMinBackgroundColor);
+    painter.drawRect(Left, StripHeight-ZerodBHeight, MeterWidth, ZerodBHeight);
+
+    painter.setBrush(FMaxBackgroundColor);
+    painter.drawRect(Left, 0, MeterWidth, StripHeight-ZerodBHeight);
+  }
+}
+
+//Draws a meter at full level at the left of the painter
+void DNRMeterBridge::PaintForground(QPainter &painter)
+{
+  int HalfHeight = ((float)StripHeight/2)+0.5;
+
+  if (FGradientForground)
+  {
+    QLinearGradient ForgroundGradient(0, HalfHeight, 0, 0);
+    ForgroundGradient.setColorAt(0, FMinColor);
+    ForgroundGradient.setColorAt(1, FMaxColor);
+
+    painter.setBrush(FMinColor);
+    painter.drawRect(0, HalfHeight, MeterWidth, StripHeight-HalfHeight);
+
+    painter.setBrush(QBrush(ForgroundGradient));
+    painter.drawRect(0, 0, MeterWidth, HalfHeight);
+  }
+  else
+  {
+    painter.setBrush(FMinColor);
+    painter.drawRect(0, StripHeight-ZerodBHeight, MeterWidth, ZerodBHeight);
+
+    painter.setBrush(FMaxColor);
+    painter.drawRect(0, 0, MeterWidth, StripHeight-ZerodBHeight);
+  }
+}
+
+void DNRMeterBridge::RenderStrips()
+{
+  BridgePixmap = QPixmap(size());
+  BridgePixmap.fill(palette().color(QPalette::Window));
+
+  QPainter BridgePainter(&BridgePixmap);
+  BridgePainter.setPen(Qt::NoPen);
+  for (int cntChannel=0; cntChannel<FNumberOfChannels; cntChannel++)
+  {
+    PaintBackground(BridgePainter, MeterRect(cntChannel).left());
+  }
+  if (FLabelHeight>0)
+  {
+    BridgePainter.setPen(FLabelColor);
+    for (int cntChannel=0; cntChannel<FNumberOfChannels; cntChannel++)
+    {
+      QRect LabelRect(MeterRect(cntChannel).left(), StripHeight, MeterWidth, FLabelHeight);
+      BridgePainter.drawText(LabelRect, Qt::AlignCenter, Labels.at(cntChannel));
+    }
+  }
+  BridgePainter.end();
+
+  LitPixmap = QPixmap(MeterWidth, (StripHeight>0) ? StripHeight : 1);
+  QPainter LitPainter(&LitPixmap);
+  LitPainter.setPen(Qt::NoPen);
+  PaintBackground(LitPainter, 0);
+  PaintForground(LitPainter);
+  LitPainter.end();
+
+  StripsValid = true;
+}
+
+void DNRMeterBridge::InvalidateStrips()
+{
+  QRegion Dirty;
+
+  StripsValid = false;
+  CalculateScale();
+  for (int cntChannel=0; cntChannel<FNumberOfChannels; cntChannel++)
+  {
+    MeterHeights[cntChannel] = -1;
+    PeakHeights[cntChannel] = 0;
+    CalculateMeter(cntChannel, Dirty);
+  }
+  update();
+}
+
+void DNRMeterBridge::resizeEvent(QResizeEvent *)
+{
+  InvalidateStrips();
+}
+
+void DNRMeterBridge::paintEvent(QPaintEvent *event)
+{
+  if (!StripsValid)
+  {
+    RenderStrips();
+  }
+
+  QPainter painter(this);
+  painter.drawPixmap(event->rect(), BridgePixmap, event->rect());
+
+  //only the meters inside the update region are visited
+  int Pitch = MeterWidth+FMeterSpacing;
+  int FirstMeter = event->rect().left()/Pitch;
+  int LastMeter = event->rect().right()/Pitch;
+  if (LastMeter>=FNumberOfChannels)
+  {
+    LastMeter = FNumberOfChannels-1;
+  }
+
+  for (int cntChannel=FirstMeter; cntChannel<=LastMeter; cntChannel++)
+  {
+    QRect Meter = MeterRect(cntChannel);
+    QRect LitRect = QRect(Meter.left(), StripHeight-MeterHeights[cntChannel], MeterWidth, MeterHeights[cntChannel]) & event->rect();
+
+    if (!LitRect.isEmpty())
+    {
+      painter.drawPixmap(LitRect, LitPixmap, LitRect.translated(-Meter.left(), 0));
+    }
+
+    if (PeakHeights[cntChannel]>MeterHeights[cntChannel])
+    {
+      QRect PeakRect = QRect(Meter.left(), StripHeight-PeakHeights[cntChannel], MeterWidth, PEAK_HOLD_HEIGHT) & event->rect();
+      if (!PeakRect.isEmpty())
+      {
+        painter.drawPixmap(PeakRect, LitPixmap, PeakRect.translated(-Meter.left(), 0));
+      }
+    }
+  }
+}
+
+void DNRMeterBridge::setChannelLabel(int Channel, const QString &NewLabel)
+{
+   if ((Channel>=0) && (Channel<FNumberOfChannels) && (Labels.at(Channel) != NewLabel))
+   {
+      Labels[Channel] = NewLabel;
+      if (FLabelHeight>0)
+      {
+         StripsValid = false;
+         update(MeterRect(Channel).left(), StripHeight, MeterWidth, FLabelHeight);
+      }
+   }
+}
+
+QString DNRMeterBridge::getChannelLabel(int Channel) const
+{
+   if ((Channel>=0) && (Channel<FNumberOfChannels))
+   {
+      return Labels.at(Channel);
+   }
+   return QString();
+}
+
+void DNRMeterBridge::setNumberOfChannels(int NewNumberOfChannels)
+{
+   if (NewNumberOfChannels<0)
+   {
+      NewNumberOfChannels = 0;
+   }
+   if (FNumberOfChannels != NewNumberOfChannels)
+   {
+      FdBPositions.resize(NewNumberOfChannels);
+      MeterHeights.resize(NewNumberOfChannels);
+      FPeakdBPositions.resize(NewNumberOfChannels);
+      PeakHeights.resize(NewNumberOfChannels);
+      for (int cntChannel=FNumberOfChannels; cntChannel<NewNumberOfChannels; cntChannel++)
+      {
+         FdBPositions[cntChannel] = FMindBPosition;
+         FPeakdBPositions[cntChannel] = FMindBPosition;
+         Labels.append(QString());
+      }
+      while (Labels.count()>NewNumberOfChannels)
+      {
+         Labels.removeLast();
+      }
+      FNumberOfChannels = NewNumberOfChannels;
+
+      InvalidateStrips();
+   }
+}
+
+int DNRMeterBridge::getNumberOfChannels()
+{
+   return FNumberOfChannels;
+}
+
+void DNRMeterBridge::setFirstChannel(int NewFirstChannel)
+{
+   FFirstChannel = NewFirstChannel;
+}
+
+int DNRMeterBridge::getFirstChannel()
+{
+   return FFirstChannel;
+}
+
+void DNRMeterBridge::setMeterSpacing(int NewMeterSpacing)
+{
+   if (FMeterSpacing != NewMeterSpacing)
+   {
+      FMeterSpacing = NewMeterSpacing;
+      InvalidateStrips();
+   }
+}
+
+int DNRMeterBridge::getMeterSpacing()
+{
+   return FMeterSpacing;
+}
+
+void DNRMeterBridge::setLabelHeight(int NewLabelHeight)
+{
+   if (FLabelHeight != NewLabelHeight)
+   {
+      FLabelHeight = NewLabelHeight;
+      InvalidateStrips();
+   }
+}
+
+int DNRMeterBridge::getLabelHeight()
+{
+   return FLabelHeight;
+}
+
+void DNRMeterBridge::setMindBPosition(double NewMindBPosition)
+{
+   if (FMindBPosition != NewMindBPosition)
+   {
+      FMindBPosition = NewMindBPosition;
+      InvalidateStrips();
+   }
+}
+
+double DNRMeterBridge::getMindBPosition()
+{
+   return FMindBPosition;
+}
+
+void DNRMeterBridge::setMaxdBPosition(double NewMaxdBPosition)
+{
+   if (FMaxdBPosition != NewMaxdBPosition)
+   {
+      FMaxdBPosition = NewMaxdBPosition;
+      InvalidateStrips();
+   }
+}
+
+double DNRMeterBridge::getMaxdBPosition()
+{
+   return FMaxdBPosition;
+}
+
+void DNRMeterBridge::setDINCurve(bool NewDINCurve)
+{
+   if (FDINCurve != NewDINCurve)
+   {
+      FDINCurve = NewDINCurve;
+      InvalidateStrips();
+   }
+}
+
+bool DNRMeterBridge::getDINCurve()
+{
+   return FDINCurve;
+}
+
+void DNRMeterBridge::setGradientBackground(bool NewGradientBackground)
+{
+   if (FGradientBackground != NewGradientBackground)
+   {
+      FGradientBackground = NewGradientBackground;
+      InvalidateStrips();
+   }
+}
+
+bool DNRMeterBridge::getGradientBackground()
+{
+   return FGradientBackground;
+}
+
+void DNRMeterBridge::setGradientForground(bool NewGradientForground)
+{
+   if (FGradientForground != NewGradientForground)
+   {
+      FGradientForground = NewGradientForground;
+      InvalidateStrips();
+   }
+}
+
+bool DNRMeterBridge::getGradientForground()
+{
+   return FGradientForground;
+}
+
+const QColor & DNRMeterBridge::getMaxColor() const
+{
+	return FMaxColor;
+}
+
+void DNRMeterBridge::setMaxColor(const QColor & NewMaxColor)
+{
+	FMaxColor = NewMaxColor;
+	InvalidateStrips();
+}
+
+const QColor & DNRMeterBridge::getMinColor() const
+{
+	return FMinColor;
+}
+
+void DNRMeterBridge::setMinColor(const QColor & NewMinColor)
+{
+	FMinColor = NewMinColor;
+	InvalidateStrips();
+}
+
+const QColor & DNRMeterBridge::getMaxBackgroundColor() const
+{
+	return FMaxBackgroundColor;
+}
+
+void DNRMeterBridge::setMaxBackgroundColor(const QColor & NewMaxBackgroundColor)
+{
+	FMaxBackgroundColor = NewMaxBackgroundColor;
+	InvalidateStrips();
+}
+
+const QColor & DNRMeterBridge::getMinBackgroundColor() const
+{
+	return FMinBackgroundColor;
+}
+
+void DNRMeterBridge::setMinBackgroundColor(const QColor & NewMinBackgroundColor)
+{
+	FMinBackgroundColor = NewMinBackgroundColor;
+	InvalidateStrips();
+}
+
+const QColor & DNRMeterBridge::getLabelColor() const
+{
+	return FLabelColor;
+}
+
+void DNRMeterBridge::setLabelColor(const QColor & NewLabelColor)
+{
+	FLabelColor = NewLabelColor;
+	InvalidateStrips();
+}
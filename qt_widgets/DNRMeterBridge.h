@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+
+#ifndef DNRMETERBRIDGE_H
+#define DNRMETERBRIDGE_H
+
+#include "DNRDefines.h"
+#include "DNRPPMMeter.h"
+#include <QWidget>
+#include <QPixmap>
+#include <QVector>
+#include <QStringList>
+#include <QtDesigner/QDesignerExportWidget>
+
+//A row of PPM meters in one widget. All meters share one pair of
+//pre-rendered strips and are drawn in a single paint pass.
+class QDESIGNER_WIDGET_EXPORT DNRMeterBridge : public QWidget
+{
+    Q_OBJECT
+    Q_PROPERTY(int NumberOfChannels READ getNumberOfChannels WRITE setNumberOfChannels);
+    Q_PROPERTY(int FirstChannel READ getFirstChannel WRITE setFirstChannel);
+    Q_PROPERTY(int MeterSpacing READ getMeterSpacing WRITE setMeterSpacing);
+    Q_PROPERTY(int LabelHeight READ getLabelHeight WRITE setLabelHeight);
+    Q_PROPERTY(double MindBPosition READ getMindBPosition WRITE setMindBPosition);
+    Q_PROPERTY(double MaxdBPosition READ getMaxdBPosition WRITE setMaxdBPosition);
+    Q_PROPERTY(bool DINCurve READ getDINCurve WRITE setDINCurve);
+    Q_PROPERTY(bool GradientBackground READ getGradientBackground WRITE setGradientBackground);
+    Q_PROPERTY(bool GradientForground READ getGradientForground WRITE setGradientForground);
+    Q_PROPERTY(QColor MaxColor READ getMaxColor WRITE setMaxColor);
+    Q_PROPERTY(QColor MinColor READ getMinColor WRITE setMinColor);
+    Q_PROPERTY(QColor MaxBackgroundColor READ getMaxBackgroundColor WRITE setMaxBackgroundColor);
+    Q_PROPERTY(QColor MinBackgroundColor READ getMinBackgroundColor WRITE setMinBackgroundColor);
+    Q_PROPERTY(QColor LabelColor READ getLabelColor WRITE setLabelColor);
+public:
+    DNRMeterBridge(QWidget *parent = 0);
+
+    //Sets Count levels starting at the first meter, one update per call.
+    //PeakdBPositions may be 0, a peak is only drawn above its level.
+    void setLevels(const float *dBPositions, const float *PeakdBPositions, int Count);
+    double getdBPosition(int Channel);
+
+    void setChannelLabel(int Channel, const QString &NewLabel);
+    QString getChannelLabel(int Channel) const;
+
+    int FNumberOfChannels;
+    void setNumberOfChannels(int NewNumberOfChannels);
+    int getNumberOfChannels();
+
+    //Index of the first meter in the application's channel array
+    int FFirstChannel;
+    void setFirstChannel(int NewFirstChannel);
+    int getFirstChannel();
+
+    int FMeterSpacing;
+    void setMeterSpacing(int NewMeterSpacing);
+    int getMeterSpacing();
+
+    int FLabelHeight;
+    void setLabelHeight(int NewLabelHeight);
+    int getLabelHeight();
+
+    double FMindBPosition;
+    void setMindBPosition(double NewMindBPosition);
+    double getMindBPosition();
+
+    double FMaxdBPosition;
+    void setMaxdBPosition(double NewMaxdBPosition);
+    double getMaxdBPosition();
+
+    bool FDINCurve;
+    void setDINCurve(bool NewDINCurve);
+    bool getDINCurve();
+
+    bool FGradientBackground;
+    void setGradientBackground(bool NewGradientBackground);
+    bool getGradientBackground();
+
+    bool FGradientForground;
+    void setGradientForground(bool NewGradientForground);
+    bool getGradientForground();
+
+    QColor FMaxColor;
+	const QColor & getMaxColor() const;
+    virtual void setMaxColor(const QColor & NewMaxColor);
+
+    QColor FMinColor;
+	const QColor & getMinColor() const;
+    virtual void setMinColor(const QColor & NewMinColor);
+
+    QColor FMaxBackgroundColor;
+	const QColor & getMaxBackgroundColor() const;
+    virtual void setMaxBackgroundColor(const QColor & NewMaxBackgroundColor);
+
+    QColor FMinBackgroundColor;
+	const QColor & getMinBackgroundColor() const;
+    virtual void setMinBackgroundColor(const QColor & NewMinBackgroundColor);
+
+    QColor FLabelColor;
+	const QColor & getLabelColor() const;
+    virtual void setLabelColor(const QColor & NewLabelColor);
+
+public slots:
+	void setdBPosition(int_number Channel, double_db NewdBPosition);
+
+private:
+	double LiniearMin;
+	double LiniearRange;
+	double dBRange;
+	int MeterWidth;
+	int StripHeight;
+	int ZerodBHeight;
+
+    QVector<double> FdBPositions;
+    QVector<int> MeterHeights;
+    QVector<double> FPeakdBPositions;
+    QVector<int> PeakHeights;
+    QStringList Labels;
+
+    //Unlit bridge (all meters, gaps and labels) and one lit strip
+    //shared by all meters
+    QPixmap BridgePixmap;
+    QPixmap LitPixmap;
+    bool StripsValid;
+    void CalculateScale();
+    int CalculateHeight(double dBPosition);
+    bool CalculateMeter(int Channel, QRegion &Dirty);
+    QRect MeterRect(int Channel);
+    void RenderStrips();
+    void InvalidateStrips();
+    void PaintBackground(QPainter &painter, int Left);
+    void PaintForground(QPainter &painter);
+
+protected:
+    void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
+};
+
+#endif
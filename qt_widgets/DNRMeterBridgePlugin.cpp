@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "DNRMeterBridge.h"
+#include "DNRMeterBridgePlugin.h"
+
+#include <QtPlugin>
+
+MeterBridgePlugin::MeterBridgePlugin(QObject *parent)
+    : QObject(parent)
+{
+    initialized = false;
+}
+
+void MeterBridgePlugin::initialize(QDesignerFormEditorInterface * /* core */)
+{
+    if (initialized)
+        return;
+
+    initialized = true;
+}
+
+bool MeterBridgePlugin::isInitialized() const
+{
+    return initialized;
+}
+
+QWidget *MeterBridgePlugin::createWidget(QWidget *parent)
+{
+    return new DNRMeterBridge(parent);
+}
+
+QString MeterBridgePlugin::name() const
+{
+    return "DNRMeterBridge";
+}
+
+QString MeterBridgePlugin::group() const
+{
+    return "DNR Widgets";
+}
+
+QIcon MeterBridgePlugin::icon() const
+{
+    return QIcon();
+}
+
+QString MeterBridgePlugin::toolTip() const
+{
+    return "";
+}
+
+QString MeterBridgePlugin::whatsThis() const
+{
+    return "";
+}
+
+bool MeterBridgePlugin::isContainer() const
+{
+    return false;
+}
+
+QString MeterBridgePlugin::domXml() const
+{
+    return "<widget class=\"DNRMeterBridge\" name=\"NewDNRMeterBridge\">\n"
+           " <property name=\"geometry\">\n"
+           "  <rect>\n"
+           "   <x>0</x>\n"
+           "   <y>0</y>\n"
+           "   <width>200</width>\n"
+           "   <height>200</height>\n"
+           "  </rect>\n"
+           " </property>\n"
+           " <property name=\"toolTip\" >\n"
+           "  <string>The Meter Bridge</string>\n"
+           " </property>\n"
+           " <property name=\"whatsThis\" >\n"
+           "  <string>The Meter Bridge widget displays a row of PPM meters</string>\n"
+           " </property>\n"
+           "</widget>\n";
+}
+
+QString MeterBridgePlugin::includeFile() const
+{
+    return "DNRMeterBridge.h";
+}
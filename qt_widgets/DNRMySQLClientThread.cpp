@@ -42,6 +42,7 @@ DNRMySQLClientThread::DNRMySQLClientThread(QObject *parent): QThread(parent)
    registerDNRTypes();
    ProcessID = 0;
    LastElapsedTime = 0;
+   previousNumberOfSeconds = 0;
    abort = false;
 }
 
@@ -61,24 +62,22 @@ QStringList DNRMySQLClientThread::GetReceivingSlotsList(const char *signal, cons
 	return d_func()->receivingSlotsList(signal, receiver);
 }
 
-void DNRMySQLClientThread::run()
+double DNRMySQLClientThread::CurrentTime()
 {
-	//counter for thread
 #ifdef Q_OS_WIN32
 	LARGE_INTEGER freq, newTime;
 	QueryPerformanceFrequency(&freq);
 	QueryPerformanceCounter(&newTime);
-	double newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
+	return (double)newTime.QuadPart/freq.QuadPart;
 #else
    timespec newTime;
    clock_gettime(CLOCK_MONOTONIC, &newTime);
-   double newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
+   return newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
 #endif
+}
 
-   double previousNumberOfSeconds = newNumberOfSeconds;
-   double previousNumberOfSeconds_ms = newNumberOfSeconds;
-   double ElapsedTime;
-
+void DNRMySQLClientThread::run()
+{
 #ifndef Q_OS_WIN32
    if (QSqlDatabase::drivers().isEmpty())
    {
@@ -88,18 +87,147 @@ void DNRMySQLClientThread::run()
    }
    emit SQLErrorMessage(tr("Data base driver found"));
 
-   QSqlDatabase db = QSqlDatabase::addDatabase("QMYSQL", objectName());
-   db.setDatabaseName("hardware_status");
-   db.setHostName("localhost");
-   db.setPort(3306);
-   if (!db.open("root", "root"))
    {
-      //err = db.lastError();
-      emit SQLErrorMessage(db.lastError().text());
-      QSqlDatabase::removeDatabase(objectName());
-      return;
+      QSqlDatabase db = QSqlDatabase::addDatabase("QMYSQL", objectName());
+      db.setDatabaseName("hardware_status");
+      db.setHostName("localhost");
+      db.setPort(3306);
+      if (!db.open("root", "root"))
+      {
+         //err = db.lastError();
+         emit SQLErrorMessage(db.lastError().text());
+      }
+      else
+      {
+         emit SQLErrorMessage(tr("Starting thread-loop"));
+
+         ProcessID = getpid();
+         previousNumberOfSeconds = CurrentTime();
+
+         //The ChangeVersion column and its trigger from sql/hardware_status.sql
+         //let us probe one row instead of reading the tables.
+         if (db.record("configuration_rack_axum").contains("ChangeVersion"))
+         {
+            RunChangeDriven(db);
+         }
+         else
+         {
+            emit SQLErrorMessage(tr("No ChangeVersion column (see hardware_status.sql), polling the tables"));
+            RunPolling(db);
+         }
+         db.close();
+      }
    }
-   emit SQLErrorMessage(tr("Starting thread-loop"));
+   QSqlDatabase::removeDatabase(objectName());
+#endif
+}
+
+//Probes the configuration version every 33 ms and only reads the slot table
+//when it changed. Write-backs are collected and flushed in one statement.
+void DNRMySQLClientThread::RunChangeDriven(QSqlDatabase &db)
+{
+   double newNumberOfSeconds = previousNumberOfSeconds;
+   double previousNumberOfSeconds_ms = newNumberOfSeconds;
+   double previousNumberOfSeconds_flush = newNumberOfSeconds;
+
+   QSqlQuery VersionQuery(db);
+   QSqlQuery StatusQuery(db);
+   QSqlQuery ClearQuery(db);
+   VersionQuery.setForwardOnly(true);
+   StatusQuery.setForwardOnly(true);
+   VersionQuery.prepare("SELECT ChangeVersion, HardwareSet, TableNameCurrentConfiguration FROM configuration_rack_axum LIMIT 1");
+
+   bool VersionValid = false;
+   qlonglong ChangeVersion = 0;
+   QString SlotTableName;
+   bool ClearPending = false;
+
+   forever
+   {
+		if (abort)
+      {
+         if (ClearPending)
+         {
+            ClearQuery.exec();
+         }
+			return;
+      }
+
+      newNumberOfSeconds = CurrentTime();
+      LastElapsedTime = newNumberOfSeconds-previousNumberOfSeconds;
+      previousNumberOfSeconds = newNumberOfSeconds;
+
+      if ((newNumberOfSeconds-previousNumberOfSeconds_ms) >= 0.033)
+      {
+         if (!VersionQuery.exec())
+         {
+            emit SQLErrorMessage(VersionQuery.lastError().text());
+         }
+         else if (VersionQuery.next())
+         {
+            qlonglong NewChangeVersion = VersionQuery.value(0).toLongLong();
+            if ((!VersionValid) || (NewChangeVersion != ChangeVersion))
+            {
+               VersionValid = true;
+               ChangeVersion = NewChangeVersion;
+
+               QString NewSlotTableName = VersionQuery.value(2).toString();
+               if (NewSlotTableName != SlotTableName)
+               {
+                  if (ClearPending)
+                  {
+                     ClearQuery.exec();
+                     ClearPending = false;
+                  }
+                  SlotTableName = NewSlotTableName;
+                  QString EscapedName = db.driver()->escapeIdentifier(SlotTableName, QSqlDriver::TableName);
+                  StatusQuery.prepare(QString("SELECT GPI1 FROM %1 LIMIT 1").arg(EscapedName));
+                  ClearQuery.prepare(QString("UPDATE %1 SET HardwareSet=0 WHERE HardwareSet<>0").arg(EscapedName));
+               }
+
+               if (VersionQuery.value(1).toInt() == 1)
+               {
+                  if (!StatusQuery.exec())
+                  {
+                     emit SQLErrorMessage(StatusQuery.lastError().text());
+                  }
+                  else if (StatusQuery.next())
+                  {
+                     double GPI1Value = StatusQuery.value(0).toInt();
+                     if (GPI1Value != 0)
+                     {
+                        GPI1Value = POSITION_RESOLUTION;
+                     }
+                     emit HardwareStatusChange(0, GPI1Value);
+                     ClearPending = true;
+                  }
+                  StatusQuery.finish();
+               }
+            }
+         }
+         VersionQuery.finish();
+         previousNumberOfSeconds_ms = newNumberOfSeconds;
+      }
+
+      if ((ClearPending) && ((newNumberOfSeconds-previousNumberOfSeconds_flush) >= 0.1))
+      {
+         if (!ClearQuery.exec())
+         {
+            emit SQLErrorMessage(ClearQuery.lastError().text());
+         }
+         ClearPending = false;
+         previousNumberOfSeconds_flush = newNumberOfSeconds;
+      }
+      msleep(10);
+   }
+}
+
+//Fallback for databases without a ChangeVersion column
+void DNRMySQLClientThread::RunPolling(QSqlDatabase &db)
+{
+   double newNumberOfSeconds = previousNumberOfSeconds;
+   double previousNumberOfSeconds_ms = newNumberOfSeconds;
+   double ElapsedTime;
 
    QSqlTableModel *configurationTable = new QSqlTableModel(0, db);
    QSqlTableModel *slot0Table = new QSqlTableModel(0, db);
@@ -111,8 +239,6 @@ void DNRMySQLClientThread::run()
    slot0Table->setTable(configurationTable->record(0).value("TableNameCurrentConfiguration").toString());
    slot0Table->setEditStrategy(QSqlTableModel::OnFieldChange);
    slot0Table->select();
-   
-   ProcessID = getpid();
 
    forever
    {
@@ -120,18 +246,10 @@ void DNRMySQLClientThread::run()
       {
          delete configurationTable;
          delete slot0Table;
-         QSqlDatabase::removeDatabase(objectName());
 			return;
       }
 
-#ifdef Q_OS_WIN32
-		QueryPerformanceCounter(&newTime);
-		newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
-#else
-	   clock_gettime(CLOCK_MONOTONIC, &newTime);
-   	newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
-#endif
-
+      newNumberOfSeconds = CurrentTime();
       LastElapsedTime = newNumberOfSeconds-previousNumberOfSeconds;
       previousNumberOfSeconds = newNumberOfSeconds;
 
@@ -161,7 +279,6 @@ void DNRMySQLClientThread::run()
       }
       msleep(10);
    }
-#endif
 }
 
 
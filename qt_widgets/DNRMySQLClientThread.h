@@ -57,7 +57,12 @@ signals:
 
 protected:
 	void run();
+	void RunChangeDriven(QSqlDatabase &db);
+	void RunPolling(QSqlDatabase &db);
+	double CurrentTime();
+
 	bool abort;
+	double previousNumberOfSeconds;
 
 };
 
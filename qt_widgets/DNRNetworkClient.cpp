@@ -29,11 +29,12 @@
 DNRNetworkClient::DNRNetworkClient(QWidget *parent)
     : QWidget(parent)
 {
-	cntSlot = 0;
-	cntByteInSlot = 0;
-
 	clientConnection = new QTcpSocket(this);
 
+	FrameTimer = new QTimer(this);
+	FrameTimer->setSingleShot(true);
+	connect(FrameTimer, SIGNAL(timeout()), this, SLOT(doFlushFaderPositions()));
+
    DebugMessage = tr("The client tries to connect!");
 
 	connect(clientConnection, SIGNAL(connected()), this, SLOT(doConnected()));
@@ -63,51 +64,39 @@ void DNRNetworkClient::paintEvent(QPaintEvent *)
 
 void DNRNetworkClient::doReadTCPSocket()
 {
-	QByteArray Temp = clientConnection->readAll();
-	unsigned char *ByteData = (unsigned char *)Temp.data();
-	int count = Temp.count();
+	unsigned char Buffer[1024];
+	qint64 Length;
 
-	for (int cntByte=0; cntByte<count; cntByte++)
+	while ((Length = clientConnection->read((char *)Buffer, sizeof(Buffer))) > 0)
 	{
-		if ((ByteData[cntByte]&0x81) == 0x80)
-		{
-			cntByteInSlot = 0;
-		}
+		const unsigned char *Data = Buffer;
+		const unsigned char *End = Buffer+Length;
+		int ChannelNr, Position;
 
-		if (cntByteInSlot<16)
+		while (FaderDecoder.Decode(Data, End, ChannelNr, Position))
 		{
-			MessageSlot[cntByteInSlot++] = ByteData[cntByte];
-		
-         if ((ByteData[cntByte]&0x81) == 0x81)
-		   {	//End of a message
-			   if (MessageSlot[0] == 0x80)
-			   {
-				  int ChannelNr = (MessageSlot[2]<<7) | MessageSlot[1];
-				  int Data = (MessageSlot[4]<<7) | MessageSlot[3];
-				  emit FaderPositionChanged(ChannelNr,Data);
-			   }
-         }
+			emit FaderPositionChanged(ChannelNr, Position);
 		}
-      else
-      {
-         cntByteInSlot = 0;
-      }
 	}
 }
 
 void DNRNetworkClient::doFaderPositionChange(int_number ChannelNr, double_position Position)
 {
-		unsigned char MessageData[16];
-		int int_position = Position;
+	if (FaderEncoder.Add(ChannelNr, (int)Position))
+	{
+		FrameTimer->start(FADER_FRAME_INTERVAL);
+	}
+}
 
-		MessageData[0] = 0x80;
-		MessageData[1] = ChannelNr&0x7F;
-		MessageData[2] = (ChannelNr>>7)&0x7F;
-		MessageData[3] = int_position&0x7F;
-		MessageData[4] = (int_position>>7)&0x7F;
-		MessageData[5] = MessageData[0] | 0x01;
+void DNRNetworkClient::doFlushFaderPositions()
+{
+	QByteArray MessageData;
 
-		clientConnection->write((char *)MessageData, 6);
+	FaderEncoder.Encode(MessageData);
+	if (clientConnection->state() == QAbstractSocket::ConnectedState)
+	{
+		clientConnection->write(MessageData);
+	}
 }
 
 
@@ -116,6 +105,9 @@ void DNRNetworkClient::doConnected()
    DebugMessage = tr("Connected!");
    update();
 
+    setLowDelay(clientConnection);
+    FaderDecoder.Reset();
+
     connect(clientConnection, SIGNAL(disconnected()), clientConnection, SLOT(deleteLater()));
     connect(clientConnection, SIGNAL(readyRead()), this, SLOT(doReadTCPSocket()));
 }
@@ -25,10 +25,12 @@
 #define DNRNETWORKCLIENT_H
 
 #include "DNRDefines.h"
+#include "DNRFaderProtocol.h"
 #include <QWidget>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QTcpSocket;
+class QTimer;
 
 class QDESIGNER_WIDGET_EXPORT DNRNetworkClient : public QWidget
 {
@@ -40,6 +42,7 @@ public:
 private slots:
 	void doReadTCPSocket();
 	void doConnected();
+	void doFlushFaderPositions();
 
 signals:
 	void FaderPositionChanged(int_number ChannelNr, double_position Position);
@@ -54,9 +57,9 @@ protected:
     void paintEvent(QPaintEvent *event);
     QTcpSocket *clientConnection;
 
-    unsigned char MessageSlot[16];
-    char cntSlot;
-    char cntByteInSlot;
+    DNRFaderDecoder FaderDecoder;
+    DNRFaderEncoder FaderEncoder;
+    QTimer *FrameTimer;
 
     QString DebugMessage;
 
@@ -29,9 +29,9 @@
 DNRNetworkServer::DNRNetworkServer(QWidget *parent)
     : QWidget(parent)
 {
-	cntSlot = 0;
-	cntByteInSlot = 0;
-
+	FrameTimer = new QTimer(this);
+	FrameTimer->setSingleShot(true);
+	connect(FrameTimer, SIGNAL(timeout()), this, SLOT(doFlushFaderPositions()));
 
 	tcpServer = new QTcpServer(this);
 	tcpServer->setMaxPendingConnections(MAX_NUMBER_OF_CONNECTIONS_TO_SERVER);
@@ -65,52 +65,43 @@ void DNRNetworkServer::paintEvent(QPaintEvent *)
 void DNRNetworkServer::doReadTCPSocket()
 {
 	QTcpSocket *clientConnection = (QTcpSocket *)sender();
-	QByteArray Temp = clientConnection->readAll();
-	unsigned char *ByteData = (unsigned char *)Temp.data();
-	int count = Temp.count();
+	DNRFaderDecoder &FaderDecoder = FaderDecoders[clientConnection];
+	unsigned char Buffer[1024];
+	qint64 Length;
 
-	for (int cntByte=0; cntByte<count; cntByte++)
+	while ((Length = clientConnection->read((char *)Buffer, sizeof(Buffer))) > 0)
 	{
-		if ((ByteData[cntByte]&0x81) == 0x80)
-		{
-			cntByteInSlot = 0;
-		}
+		const unsigned char *Data = Buffer;
+		const unsigned char *End = Buffer+Length;
+		int ChannelNr, PositionData;
 
-		if (cntByteInSlot<16)
+		while (FaderDecoder.Decode(Data, End, ChannelNr, PositionData))
 		{
-			MessageSlot[cntByteInSlot++] = ByteData[cntByte];
-		}
-
-		if ((ByteData[cntByte]&0x81) == 0x81)
-		{	//End of a message
-			if (MessageSlot[0] == 0x80)
-			{
-				int ChannelNr = (MessageSlot[2]<<7) | MessageSlot[1];
-				int PositionData = (MessageSlot[4]<<7) | MessageSlot[3];
-            emit FaderPositionChanged(ChannelNr,PositionData);
-       	}
+			emit FaderPositionChanged(ChannelNr, PositionData);
 		}
 	}
 }
 
 void DNRNetworkServer::doFaderPositionChange(int_number ChannelNr, double_position Position)
 {
-	unsigned char MessageData[16];
-	int int_position = Position;
+	if (FaderEncoder.Add(ChannelNr, (int)Position))
+	{
+		FrameTimer->start(FADER_FRAME_INTERVAL);
+	}
+}
 
-	MessageData[0] = 0x80;
-	MessageData[1] = ChannelNr&0x7F;
-	MessageData[2] = (ChannelNr>>7)&0x7F;
-	MessageData[3] = int_position&0x7F;
-	MessageData[4] = (int_position>>7)&0x7F;
-	MessageData[5] = MessageData[0] | 0x01;
+//One encoded frame is shared by all clients
+void DNRNetworkServer::doFlushFaderPositions()
+{
+	QByteArray MessageData;
 
+	FaderEncoder.Encode(MessageData);
 	for (int cntSocket=0; cntSocket<clientConnectionList.count(); cntSocket++)
 	{
 		QTcpSocket *clientConnection = clientConnectionList.at(cntSocket);
 		if (clientConnection->state() == QAbstractSocket::ConnectedState)
 		{
-			clientConnection->write((char *)MessageData, 6);
+			clientConnection->write(MessageData);
 		}
 	}
 }
@@ -120,6 +111,7 @@ void DNRNetworkServer::doConnected()
 {
 	QTcpSocket *clientConnection = tcpServer->nextPendingConnection();
 	clientConnectionList.append(clientConnection);
+	setLowDelay(clientConnection);
 	connect(clientConnection, SIGNAL(disconnected()), clientConnection, SLOT(deleteLater()));
 	connect(clientConnection, SIGNAL(disconnected()), this, SLOT(RemoveFromClientConnectionList()));
 	connect(clientConnection, SIGNAL(readyRead()), this, SLOT(doReadTCPSocket()));
@@ -132,4 +124,5 @@ void DNRNetworkServer::RemoveFromClientConnectionList()
 	{
 		clientConnectionList.removeAt(ClientIndex);
 	}
+	FaderDecoders.remove((QTcpSocket *)sender());
 }
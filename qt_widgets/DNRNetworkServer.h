@@ -25,11 +25,13 @@
 #define DNRNETWORKSERVER_H
 
 #include "DNRDefines.h"
+#include "DNRFaderProtocol.h"
 #include <QWidget>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QTcpServer;
 class QTcpSocket;
+class QTimer;
 
 class QDESIGNER_WIDGET_EXPORT DNRNetworkServer : public QWidget
 {
@@ -42,6 +44,7 @@ private slots:
 	void doReadTCPSocket();
 	void doConnected();
 	void RemoveFromClientConnectionList();
+	void doFlushFaderPositions();
 
 signals:
 	void FaderPositionChanged(int_number ChannelNr, double_position Position);
@@ -54,9 +57,9 @@ protected:
     QTcpServer *tcpServer;
     QList<QTcpSocket *> clientConnectionList;
 
-    unsigned char MessageSlot[16];
-    char cntSlot;
-    char cntByteInSlot;
+    QHash<QTcpSocket *, DNRFaderDecoder> FaderDecoders;
+    DNRFaderEncoder FaderEncoder;
+    QTimer *FrameTimer;
 
     QString DebugMessage;
 
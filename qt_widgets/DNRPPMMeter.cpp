@@ -41,6 +41,9 @@ DNRPPMMeter::DNRPPMMeter(QWidget *parent)
     FMindBPosition = -50;
     FMaxdBPosition = +5;
     FReleasePerSecond = 18;
+    FPeakdBPosition = -50;
+    FPeakHoldTime = 0;
+    FBallisticsMode = 0;
     FDINCurve = true;
     FGradientBackground = true;
     FGradientForground = false;
@@ -52,11 +55,14 @@ DNRPPMMeter::DNRPPMMeter(QWidget *parent)
     CurrentMeterHeight = 0;
     MeterHeight = 0;
     ZerodBHeight = 0;
+    CurrentPeakHeight = 0;
+    PeakHeight = 0;
 
     FMaxColor = QColor(255,0,0,255);
     FMinColor = QColor(0,255,0,255);
     FMaxBackgroundColor = QColor(64,0,0,255);
     FMinBackgroundColor = QColor(0,64,0,255);
+    StripsValid = false;
 
     QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
     PPMMeterBackgroundQImage = new QImage(AxumSkinPath + "/" + FPPMMeterBackgroundFileName);
@@ -78,8 +84,24 @@ DNRPPMMeter::DNRPPMMeter(QWidget *parent)
 #endif
 }
 
+int DNRPPMMeter::CalculateHeight(double dBPosition)
+{
+   if (FDINCurve)
+   {
+      double Pos = pow(10,((double)dBPosition+MINCURVE)/DIVCURVE);
+      return (int)(((Pos-LiniearMin)*height())/LiniearRange);
+   }
+   else
+   {
+	   double AbsolutedBPosition = dBPosition-FMindBPosition;
+      return (int)(AbsolutedBPosition*height())/dBRange;
+   }
+}
+
 bool DNRPPMMeter::CalculateMeter()
 {
+   bool Changed = 0;
+
    if (FdBPosition<FMindBPosition)
    {
       FdBPosition = FMindBPosition;
@@ -89,36 +111,50 @@ bool DNRPPMMeter::CalculateMeter()
       FdBPosition = FMaxdBPosition;
    }
 
-   MeterHeight = 0;
-   ZerodBHeight = 0;
-
+   MeterHeight = CalculateHeight(FdBPosition);
    if (FDINCurve)
    {
-      double Pos = pow(10,((double)FdBPosition+MINCURVE)/DIVCURVE);
-      MeterHeight = (int)(((Pos-LiniearMin)*height())/LiniearRange);
       ZerodBHeight = (int)(((1-LiniearMin)*height())/LiniearRange);
    }
    else
    {
-	   double AbsolutedBPosition = FdBPosition-FMindBPosition;
-      MeterHeight = (int)(AbsolutedBPosition*height())/dBRange;
       ZerodBHeight = (int)(-FMindBPosition*height())/dBRange;
    }
 
+   PeakHeight = 0;
+   if ((FPeakHoldTime>0) && (FPeakdBPosition>FdBPosition))
+   {
+      double PeakdBPosition = (FPeakdBPosition>FMaxdBPosition) ? FMaxdBPosition : FPeakdBPosition;
+      PeakHeight = CalculateHeight(PeakdBPosition);
+   }
+
   if (CurrentMeterHeight != MeterHeight)
   {
+    //only the band between the previous and the new level changed
+    int Top = height()-((CurrentMeterHeight>MeterHeight) ? CurrentMeterHeight : MeterHeight);
+    update(0, Top, width(), qAbs(CurrentMeterHeight-MeterHeight));
     CurrentMeterHeight = MeterHeight;
-    return 1;
+    Changed = 1;
+  }
+  if (CurrentPeakHeight != PeakHeight)
+  {
+    //the marker moved, repaint where it was and where it is now
+    if (CurrentPeakHeight>0)
+    {
+      update(0, height()-CurrentPeakHeight, width(), PEAK_HOLD_HEIGHT);
+    }
+    if (PeakHeight>0)
+    {
+      update(0, height()-PeakHeight, width(), PEAK_HOLD_HEIGHT);
+    }
+    CurrentPeakHeight = PeakHeight;
+    Changed = 1;
   }
-  return 0;
+  return Changed;
 }
 
-void DNRPPMMeter::paintEvent(QPaintEvent *)
+void DNRPPMMeter::PaintBackground(QPainter &painter)
 {
-  QPainter painter(this);
-  painter.setRenderHint(QPainter::Antialiasing);
-  painter.setPen(Qt::NoPen);
-
   if (PPMMeterBackgroundQImage->isNull())
   {
   }
@@ -126,19 +162,15 @@ void DNRPPMMeter::paintEvent(QPaintEvent *)
   {
     painter.drawImage(0,0, *PPMMeterBackgroundQImage);
   }
-  
-  int HalfHeight = ((float)height()/2)+0.5;
-
-  QLinearGradient BackgroundGradient(0, HalfHeight, 0, 0);
-  BackgroundGradient.setColorAt(0, FMinBackgroundColor);
-  BackgroundGradient.setColorAt(1, FMaxBackgroundColor);
 
-  QLinearGradient ForgroundGradient(0, HalfHeight, 0, 0);
-  ForgroundGradient.setColorAt(0, FMinColor);
-  ForgroundGradient.setColorAt(1, FMaxColor);
+  int HalfHeight = ((float)height()/2)+0.5;
 
   if (FGradientBackground)
   {
+    QLinearGradient BackgroundGradient(0, HalfHeight, 0, 0);
+    BackgroundGradient.setColorAt(0, FMinBackgroundColor);
+    BackgroundGradient.setColorAt(1, FMaxBackgroundColor);
+
     painter.setBrush(FMinBackgroundColor);
     painter.drawRect(0, HalfHeight, width(), HalfHeight);
 
@@ -153,18 +185,27 @@ void DNRPPMMeter::paintEvent(QPaintEvent *)
     painter.setBrush(FMaxBackgroundColor);
     painter.drawRect(0, 0, width(), height()-ZerodBHeight);
   }
+}
+
+void DNRPPMMeter::PaintForground(QPainter &painter, int Height)
+{
+  int HalfHeight = ((float)height()/2)+0.5;
 
   if (FGradientForground)
   {
+    QLinearGradient ForgroundGradient(0, HalfHeight, 0, 0);
+    ForgroundGradient.setColorAt(0, FMinColor);
+    ForgroundGradient.setColorAt(1, FMaxColor);
+
     painter.setBrush(FMinColor);
     int SingleColorHeight = HalfHeight+2;
-    if (MeterHeight<SingleColorHeight)
+    if (Height<SingleColorHeight)
     {
-      SingleColorHeight = MeterHeight;
+      SingleColorHeight = Height;
     }
     painter.drawRect(0, height()-SingleColorHeight, width(), SingleColorHeight);
 
-    int GradientHeight = MeterHeight-HalfHeight;
+    int GradientHeight = Height-HalfHeight;
     if (GradientHeight>0)
     {
       painter.setBrush(QBrush(ForgroundGradient));
@@ -173,18 +214,84 @@ void DNRPPMMeter::paintEvent(QPaintEvent *)
   }
   else
   {
-    if (MeterHeight>ZerodBHeight)
+    if (Height>ZerodBHeight)
     {
       painter.setBrush(FMinColor);
       painter.drawRect(0, height()-ZerodBHeight, width(), ZerodBHeight);
 
       painter.setBrush(FMaxColor);
-      painter.drawRect(0, height()-MeterHeight, width(), MeterHeight-ZerodBHeight);
+      painter.drawRect(0, height()-Height, width(), Height-ZerodBHeight);
     }
     else
     {
       painter.setBrush(FMinColor);
-      painter.drawRect(0, height()-MeterHeight, width(), MeterHeight);
+      painter.drawRect(0, height()-Height, width(), Height);
+    }
+  }
+}
+
+void DNRPPMMeter::RenderStrips()
+{
+  UnlitPixmap = QPixmap(size());
+  LitPixmap = QPixmap(size());
+
+  QPainter UnlitPainter(&UnlitPixmap);
+  UnlitPainter.setRenderHint(QPainter::Antialiasing);
+  UnlitPainter.setPen(Qt::NoPen);
+  PaintBackground(UnlitPainter);
+  UnlitPainter.end();
+
+  //a bar at full height only shows the lower part of this strip
+  QPainter LitPainter(&LitPixmap);
+  LitPainter.setRenderHint(QPainter::Antialiasing);
+  LitPainter.setPen(Qt::NoPen);
+  PaintBackground(LitPainter);
+  PaintForground(LitPainter, height());
+  LitPainter.end();
+
+  StripsValid = true;
+}
+
+void DNRPPMMeter::InvalidateStrips()
+{
+  StripsValid = false;
+  CalculateMeter();
+  update();
+}
+
+void DNRPPMMeter::resizeEvent(QResizeEvent *)
+{
+  InvalidateStrips();
+}
+
+void DNRPPMMeter::paintEvent(QPaintEvent *event)
+{
+  if (!StripsValid)
+  {
+    RenderStrips();
+  }
+
+  QPainter painter(this);
+  int Top = height()-MeterHeight;
+  QRect UnlitRect = QRect(0, 0, width(), Top) & event->rect();
+  QRect LitRect = QRect(0, Top, width(), MeterHeight) & event->rect();
+
+  if (!UnlitRect.isEmpty())
+  {
+    painter.drawPixmap(UnlitRect, UnlitPixmap, UnlitRect);
+  }
+  if (!LitRect.isEmpty())
+  {
+    painter.drawPixmap(LitRect, LitPixmap, LitRect);
+  }
+
+  //the marker is a slice of the lit strip at the peak level
+  if (PeakHeight>MeterHeight)
+  {
+    QRect PeakRect = QRect(0, height()-PeakHeight, width(), PEAK_HOLD_HEIGHT) & event->rect();
+    if (!PeakRect.isEmpty())
+    {
+      painter.drawPixmap(PeakRect, LitPixmap, PeakRect);
     }
   }
 }
@@ -197,7 +304,7 @@ void DNRPPMMeter::paintEvent(QPaintEvent *)
 void DNRPPMMeter::setdBPosition(double_db NewdBPosition)
 {
 	FdBPosition = NewdBPosition;
-   update();
+   CalculateMeter();
 }
 
 double DNRPPMMeter::getdBPosition()
@@ -205,6 +312,12 @@ double DNRPPMMeter::getdBPosition()
    return FdBPosition;
 }
 
+void DNRPPMMeter::setPeakdBPosition(double_db NewPeakdBPosition)
+{
+	FPeakdBPosition = NewPeakdBPosition;
+   CalculateMeter();
+}
+
 void DNRPPMMeter::setMindBPosition(double NewMindBPosition)
 {
    if (FMindBPosition != NewMindBPosition)
@@ -216,7 +329,7 @@ void DNRPPMMeter::setMindBPosition(double NewMindBPosition)
       LiniearRange = LiniearMax-LiniearMin;
       dBRange = FMaxdBPosition-FMindBPosition;
 
-      update();
+      InvalidateStrips();
    }
 }
 
@@ -236,7 +349,7 @@ void DNRPPMMeter::setMaxdBPosition(double NewMaxdBPosition)
       LiniearRange = LiniearMax-LiniearMin;
       dBRange = FMaxdBPosition-FMindBPosition;
 
-      update();
+      InvalidateStrips();
    }
 }
 
@@ -258,12 +371,39 @@ double DNRPPMMeter::getReleasePerSecond()
    return FReleasePerSecond;
 }
 
+void DNRPPMMeter::setPeakHoldTime(double NewPeakHoldTime)
+{
+   if (FPeakHoldTime != NewPeakHoldTime)
+   {
+      FPeakHoldTime = NewPeakHoldTime;
+      CalculateMeter();
+   }
+}
+
+double DNRPPMMeter::getPeakHoldTime()
+{
+   return FPeakHoldTime;
+}
+
+void DNRPPMMeter::setBallisticsMode(int NewBallisticsMode)
+{
+   if (FBallisticsMode != NewBallisticsMode)
+   {
+      FBallisticsMode = NewBallisticsMode;
+   }
+}
+
+int DNRPPMMeter::getBallisticsMode()
+{
+   return FBallisticsMode;
+}
+
 void DNRPPMMeter::setDINCurve(bool NewDINCurve)
 {
    if (FDINCurve != NewDINCurve)
    {
       FDINCurve = NewDINCurve;
-      update();
+      InvalidateStrips();
    }
 }
 
@@ -277,7 +417,7 @@ void DNRPPMMeter::setGradientBackground(bool NewGradientBackground)
    if (FGradientBackground != NewGradientBackground)
    {
       FGradientBackground = NewGradientBackground;
-      update();
+      InvalidateStrips();
    }
 }
 
@@ -291,7 +431,7 @@ void DNRPPMMeter::setGradientForground(bool NewGradientForground)
    if (FGradientForground != NewGradientForground)
    {
       FGradientForground = NewGradientForground;
-      update();
+      InvalidateStrips();
    }
 }
 
@@ -308,7 +448,7 @@ const QColor & DNRPPMMeter::getMaxColor() const
 void DNRPPMMeter::setMaxColor(const QColor & NewMaxColor)
 {
 	FMaxColor = NewMaxColor;
-	update();
+	InvalidateStrips();
 }
 
 const QColor & DNRPPMMeter::getMinColor() const
@@ -319,7 +459,7 @@ const QColor & DNRPPMMeter::getMinColor() const
 void DNRPPMMeter::setMinColor(const QColor & NewMinColor)
 {
 	FMinColor = NewMinColor;
-	update();
+	InvalidateStrips();
 }
 
 const QColor & DNRPPMMeter::getMaxBackgroundColor() const
@@ -330,7 +470,7 @@ const QColor & DNRPPMMeter::getMaxBackgroundColor() const
 void DNRPPMMeter::setMaxBackgroundColor(const QColor & NewMaxBackgroundColor)
 {
 	FMaxBackgroundColor = NewMaxBackgroundColor;
-	update();
+	InvalidateStrips();
 }
 
 const QColor & DNRPPMMeter::getMinBackgroundColor() const
@@ -341,7 +481,7 @@ const QColor & DNRPPMMeter::getMinBackgroundColor() const
 void DNRPPMMeter::setMinBackgroundColor(const QColor & NewMinBackgroundColor)
 {
 	FMinBackgroundColor = NewMinBackgroundColor;
-	update();
+	InvalidateStrips();
 }
 
 void DNRPPMMeter::setSkinEnvironmentVariable(const QString &NewSkinEnvironmentVariable)
@@ -357,7 +497,7 @@ void DNRPPMMeter::setSkinEnvironmentVariable(const QString &NewSkinEnvironmentVa
 		  PPMMeterBackgroundQImage = new QImage();
 
 	  }
-      update();
+      InvalidateStrips();
    }
 }
 
@@ -379,7 +519,7 @@ void DNRPPMMeter::setPPMMeterBackgroundFileName(const QString &NewPPMMeterBackgr
 		  PPMMeterBackgroundQImage = new QImage();
 
 	  }
-      update();
+      InvalidateStrips();
    }
 }
 
@@ -26,12 +26,16 @@
 
 #include "DNRDefines.h"
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 //Values for MeterCurve
 #define DIVCURVE 80.0
 #define MINCURVE 0.0
 
+//Height in pixels of the peak hold marker
+#define PEAK_HOLD_HEIGHT 2
+
 
 class QDESIGNER_WIDGET_EXPORT DNRPPMMeter : public QWidget
 {
@@ -40,6 +44,8 @@ class QDESIGNER_WIDGET_EXPORT DNRPPMMeter : public QWidget
     Q_PROPERTY(double MindBPosition READ getMindBPosition WRITE setMindBPosition);
     Q_PROPERTY(double MaxdBPosition READ getMaxdBPosition WRITE setMaxdBPosition);
     Q_PROPERTY(double ReleasePerSecond READ getReleasePerSecond WRITE setReleasePerSecond);
+    Q_PROPERTY(double PeakHoldTime READ getPeakHoldTime WRITE setPeakHoldTime);
+    Q_PROPERTY(int BallisticsMode READ getBallisticsMode WRITE setBallisticsMode);
     Q_PROPERTY(bool DINCurve READ getDINCurve WRITE setDINCurve);
     Q_PROPERTY(bool GradientBackground READ getGradientBackground WRITE setGradientBackground);
     Q_PROPERTY(bool GradientForground READ getGradientForground WRITE setGradientForground);
@@ -59,6 +65,11 @@ public:
     int MeterHeight;
     int ZerodBHeight;
 
+    //Marker above the bar, only drawn when higher than FdBPosition
+    double FPeakdBPosition;
+    int CurrentPeakHeight;
+    int PeakHeight;
+
 public:
     bool CalculateMeter();
     double getdBPosition();
@@ -75,6 +86,16 @@ public:
     void setReleasePerSecond(double NewReleasePerSecond);
     double getReleasePerSecond();
 
+    //Seconds the peak marker holds, 0 disables it
+    double FPeakHoldTime;
+    void setPeakHoldTime(double NewPeakHoldTime);
+    double getPeakHoldTime();
+
+    //One of the BALLISTICS_ modes in DNRBallistics.h
+    int FBallisticsMode;
+    void setBallisticsMode(int NewBallisticsMode);
+    int getBallisticsMode();
+
     bool FDINCurve;
     void setDINCurve(bool NewDINCurve);
     bool getDINCurve();
@@ -113,14 +134,27 @@ public:
 
 public slots:
 	void setdBPosition(double_db NewdBPosition);
+	void setPeakdBPosition(double_db NewPeakdBPosition);
 
 private:
 	double LiniearMin;
 	double LiniearRange;
 	double dBRange;
+    int CalculateHeight(double dBPosition);
+
+    //Pre-rendered meter at full and at zero level, the bar is
+    //blitted from these so only the changed band is repainted
+    QPixmap LitPixmap;
+    QPixmap UnlitPixmap;
+    bool StripsValid;
+    void RenderStrips();
+    void InvalidateStrips();
+    void PaintBackground(QPainter &painter);
+    void PaintForground(QPainter &painter, int Height);
 
 protected:
     void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
 //    void mouseMoveEvent(QMouseEvent *ev);
 
     double previousNumberOfSeconds;
@@ -38,6 +38,7 @@ DNRPhaseMeter::DNRPhaseMeter(QWidget *parent)
     FBackgroundMonoColor = QColor(0,128,0,255);
     FBackgroundOutOfPhaseColor = QColor(128,0,0,255);
     FHorizontal = false;
+    BackgroundValid = false;
 
     QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
     PhaseMeterBackgroundQImage = new QImage(AxumSkinPath + "/" + FPhaseMeterBackgroundFileName);
@@ -46,30 +47,15 @@ DNRPhaseMeter::DNRPhaseMeter(QWidget *parent)
     resize(16, 200);
 }
 
-void DNRPhaseMeter::paintEvent(QPaintEvent *)
+void DNRPhaseMeter::RenderBackground()
 {
-   QPainter painter(this);
+   BackgroundPixmap = QPixmap(size());
+   BackgroundPixmap.fill(Qt::transparent);
+
+   QPainter painter(&BackgroundPixmap);
    painter.setRenderHint(QPainter::Antialiasing);
    painter.setPen(Qt::NoPen);
 
-   double Range = FMaxPosition-FMinPosition;
-   if (FPosition<FMinPosition)
-   {
-      FPosition = FMinPosition;
-   }
-   if (FPosition>FMaxPosition)
-   {
-      FPosition = FMaxPosition;
-   }
-
-   double Factor = (FPosition-FMinPosition)/Range;
-   int Red = FPointerMinColor.red()*Factor + FPointerMaxColor.red()*(1-Factor);
-   int Green = FPointerMinColor.green()*Factor + FPointerMaxColor.green()*(1-Factor);
-   int Blue = FPointerMinColor.blue()*Factor + FPointerMaxColor.blue()*(1-Factor);
-   int Alpha = FPointerMinColor.alpha()*Factor + FPointerMaxColor.alpha()*(1-Factor);
-
-   QColor PointerColor(Red, Green, Blue, Alpha);
-
     if (PhaseMeterBackgroundQImage->isNull())
     {
     }
@@ -97,11 +83,6 @@ void DNRPhaseMeter::paintEvent(QPaintEvent *)
 		    painter.setBrush(FBackgroundMonoColor);
     		painter.drawRect(width()/2,0,width()/2, height());
 		}
-
-	 	painter.setPen(QPen(QBrush(PointerColor), FPointerWidth));
-    	painter.setBrush(Qt::NoBrush);
-
-	    painter.drawLine(width()-(width()*Factor), 0, width()-(width()*Factor), height());
 	}
 	else
 	{
@@ -122,20 +103,99 @@ void DNRPhaseMeter::paintEvent(QPaintEvent *)
 		    painter.setBrush(FBackgroundOutOfPhaseColor);
     		painter.drawRect(0,height()/2,width(), height()/2);
 		}
+	}
+   BackgroundValid = true;
+}
+
+void DNRPhaseMeter::InvalidateBackground()
+{
+   BackgroundValid = false;
+   update();
+}
 
-	 	painter.setPen(QPen(QBrush(PointerColor), FPointerWidth));
-    	painter.setBrush(Qt::NoBrush);
+void DNRPhaseMeter::resizeEvent(QResizeEvent *)
+{
+   BackgroundValid = false;
+}
 
-	    painter.drawLine(0, height()*Factor , width(), height()*Factor);
-	}
+//Area covered by the pointer at the current position
+QRect DNRPhaseMeter::PointerRect()
+{
+   double Range = FMaxPosition-FMinPosition;
+   double Position = FPosition;
+   if (Position<FMinPosition)
+   {
+      Position = FMinPosition;
+   }
+   if (Position>FMaxPosition)
+   {
+      Position = FMaxPosition;
+   }
+   double Factor = (Position-FMinPosition)/Range;
+   int Margin = FPointerWidth+2;
+
+   if (FHorizontal)
+   {
+      int X = width()-(width()*Factor);
+      return QRect(X-Margin, 0, 2*Margin, height());
+   }
+   int Y = height()*Factor;
+   return QRect(0, Y-Margin, width(), 2*Margin);
+}
+
+void DNRPhaseMeter::paintEvent(QPaintEvent *event)
+{
+   if (!BackgroundValid)
+   {
+      RenderBackground();
+   }
+
+   QPainter painter(this);
+   painter.drawPixmap(event->rect(), BackgroundPixmap, event->rect());
+   painter.setRenderHint(QPainter::Antialiasing);
+
+   double Range = FMaxPosition-FMinPosition;
+   if (FPosition<FMinPosition)
+   {
+      FPosition = FMinPosition;
+   }
+   if (FPosition>FMaxPosition)
+   {
+      FPosition = FMaxPosition;
+   }
+
+   double Factor = (FPosition-FMinPosition)/Range;
+   int Red = FPointerMinColor.red()*Factor + FPointerMaxColor.red()*(1-Factor);
+   int Green = FPointerMinColor.green()*Factor + FPointerMaxColor.green()*(1-Factor);
+   int Blue = FPointerMinColor.blue()*Factor + FPointerMaxColor.blue()*(1-Factor);
+   int Alpha = FPointerMinColor.alpha()*Factor + FPointerMaxColor.alpha()*(1-Factor);
+
+   QColor PointerColor(Red, Green, Blue, Alpha);
+
+   painter.setPen(QPen(QBrush(PointerColor), FPointerWidth));
+   painter.setBrush(Qt::NoBrush);
+
+   if (FHorizontal)
+   {
+      painter.drawLine(width()-(width()*Factor), 0, width()-(width()*Factor), height());
+   }
+   else
+   {
+      painter.drawLine(0, height()*Factor , width(), height()*Factor);
+   }
 }
 
 void DNRPhaseMeter::setPosition(double_phase NewPosition)
 {
    if (FPosition != NewPosition)
    {
+      QRect OldRect = PointerRect();
       FPosition = NewPosition;
-      update();
+      QRect NewRect = PointerRect();
+      if (NewRect != OldRect)
+      {
+         update(OldRect | NewRect);
+      }
    }
 }
 
@@ -216,7 +276,7 @@ const QColor & DNRPhaseMeter::getBackgroundMonoColor() const
 void DNRPhaseMeter::setBackgroundMonoColor(const QColor & NewBackgroundMonoColor)
 {
 	FBackgroundMonoColor = NewBackgroundMonoColor;
-	update();
+	InvalidateBackground();
 }
 
 const QColor & DNRPhaseMeter::getBackgroundOutOfPhaseColor() const
@@ -227,7 +287,7 @@ const QColor & DNRPhaseMeter::getBackgroundOutOfPhaseColor() const
 void DNRPhaseMeter::setBackgroundOutOfPhaseColor(const QColor & NewBackgroundOutOfPhaseColor)
 {
 	FBackgroundOutOfPhaseColor = NewBackgroundOutOfPhaseColor;
-	update();
+	InvalidateBackground();
 }
 
 void DNRPhaseMeter::setGradientBackground(bool NewGradientBackground)
@@ -235,7 +295,7 @@ void DNRPhaseMeter::setGradientBackground(bool NewGradientBackground)
    if (FGradientBackground != NewGradientBackground)
    {
       FGradientBackground = NewGradientBackground;
-      update();
+      InvalidateBackground();
    }
 }
 
@@ -249,7 +309,7 @@ void DNRPhaseMeter::setHorizontal(bool NewHorizontal)
    if (FHorizontal != NewHorizontal)
    {
       FHorizontal = NewHorizontal;
-      update();
+      InvalidateBackground();
    }
 }
 
@@ -271,7 +331,7 @@ void DNRPhaseMeter::setSkinEnvironmentVariable(const QString &NewSkinEnvironment
 		  PhaseMeterBackgroundQImage = new QImage();
 
 	  }
-      update();
+      InvalidateBackground();
    }
 }
 
@@ -293,7 +353,7 @@ void DNRPhaseMeter::setPhaseMeterBackgroundFileName(const QString &NewPhaseMeter
 		  PhaseMeterBackgroundQImage = new QImage();
 
 	  }
-      update();
+      InvalidateBackground();
    }
 }
 
@@ -26,6 +26,7 @@
 
 #include "DNRDefines.h"
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QDESIGNER_WIDGET_EXPORT DNRPhaseMeter : public QWidget
@@ -99,8 +100,17 @@ public:
 
 protected:
     void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
 //    void mouseMoveEvent(QMouseEvent *ev);
 
+private:
+    //Background image and colors rendered once, only the area
+    //around the old and new pointer is repainted
+    QPixmap BackgroundPixmap;
+    bool BackgroundValid;
+    void RenderBackground();
+    void InvalidateBackground();
+    QRect PointerRect();
 };
 
 #endif
@@ -26,6 +26,7 @@
 #include <math.h>
 #include "DNRDefines.h"
 #include "DNRRotaryKnob.h"
+#include "DNRSkinAtlas.h"
 
 DNRRotaryKnob::DNRRotaryKnob(QWidget *parent)
     : QWidget(parent)
@@ -38,9 +39,6 @@ DNRRotaryKnob::DNRRotaryKnob(QWidget *parent)
 
    PreviousDegrees = 0;
 
-   QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-   RotaryKnobQImage = new QImage(AxumSkinPath + "/" + FRotaryKnobFileName);
-
    setWindowTitle(tr("Rotary Knob"));
    resize(40, 40);
 }
@@ -56,7 +54,7 @@ void DNRRotaryKnob::paintEvent(QPaintEvent *)
       painter.setRenderHint(QPainter::Antialiasing);
       painter.translate(width() / 2, height() / 2);
 
-      if (RotaryKnobQImage->isNull())
+      if (RotaryKnobPixmap.isNull())
       {
          painter.scale(side / 40.0, side / 40.0);
 
@@ -77,19 +75,19 @@ void DNRRotaryKnob::paintEvent(QPaintEvent *)
       }
       else
       {
+         double Scale = 1;
          if (FScaleKnobImage)
          {
-            double ImageWidth = RotaryKnobQImage->width();
-            double ImageHeight = RotaryKnobQImage->height();
+            double ImageWidth = RotaryKnobPixmap.width();
+            double ImageHeight = RotaryKnobPixmap.height();
             double MaxLength = sqrt((ImageWidth*ImageWidth)+(ImageHeight*ImageHeight));
 
-            painter.scale(side / MaxLength, side / MaxLength);
+            Scale = side / MaxLength;
          }
 
-         painter.save();
-         painter.rotate(Degrees);
-         painter.drawImage(-RotaryKnobQImage->width()/2,-RotaryKnobQImage->height()/2, *RotaryKnobQImage);
-         painter.restore();
+         //pre-rotated frame from the skin atlas, no painter rotation needed
+         QPixmap KnobFrame = DNRSkinAtlas::RotatedPixmap(FSkinEnvironmentVariable, FRotaryKnobFileName, DNRSkinAtlas::RotationFrame(Degrees), Scale);
+         painter.drawPixmap(-KnobFrame.width()/2, -KnobFrame.height()/2, KnobFrame);
       }
       painter.setPen(Qt::NoPen);
       painter.setBrush(FKnobColor);
@@ -159,13 +157,7 @@ void DNRRotaryKnob::setSkinEnvironmentVariable(const QString &NewSkinEnvironment
    {
       FSkinEnvironmentVariable = NewSkinEnvironmentVariable;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!RotaryKnobQImage->load(AxumSkinPath + "/" + FRotaryKnobFileName))
-      {
-		  delete RotaryKnobQImage;
-		  RotaryKnobQImage = new QImage();
-
-	  }
+      RotaryKnobPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FRotaryKnobFileName);
       update();
    }
 }
@@ -181,13 +173,7 @@ void DNRRotaryKnob::setRotaryKnobFileName(const QString &NewRotaryKnobFileName)
    {
       FRotaryKnobFileName = NewRotaryKnobFileName;
 
-      QString AxumSkinPath = QString(getenv(FSkinEnvironmentVariable.toAscii()));
-      if (!RotaryKnobQImage->load(AxumSkinPath + "/" + FRotaryKnobFileName))
-      {
-		  delete RotaryKnobQImage;
-		  RotaryKnobQImage = new QImage();
-
-	  }
+      RotaryKnobPixmap = DNRSkinAtlas::Pixmap(FSkinEnvironmentVariable, FRotaryKnobFileName);
       update();
    }
 }
@@ -26,6 +26,7 @@
 
 #include "DNRDefines.h"
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 class QDESIGNER_WIDGET_EXPORT DNRRotaryKnob : public QWidget
@@ -40,7 +41,7 @@ class QDESIGNER_WIDGET_EXPORT DNRRotaryKnob : public QWidget
     Q_PROPERTY(QString RotaryKnobFileName READ getRotaryKnobFileName WRITE setRotaryKnobFileName);
 public:
     DNRRotaryKnob(QWidget *parent = 0);
-    QImage *RotaryKnobQImage;
+    QPixmap RotaryKnobPixmap;
 
     int FNumber;
     void setNumber(int NewNumber);
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtGui>
+#include <math.h>
+
+#include "DNRSkinAtlas.h"
+
+//Cached pixmaps live in QPixmapCache, which is bounded and released together
+//with the application. Only the names of missing files are kept here.
+QSet<QString> &DNRSkinAtlas::MissingFiles()
+{
+   static QSet<QString> Files;
+   return Files;
+}
+
+bool DNRSkinAtlas::Find(const QString &Key, QPixmap &Pixmap)
+{
+   return QPixmapCache::find("DNRSkinAtlas:"+Key, Pixmap);
+}
+
+void DNRSkinAtlas::Insert(const QString &Key, const QPixmap &Pixmap)
+{
+   if (QPixmapCache::cacheLimit() < SKIN_ATLAS_CACHE_LIMIT)
+   {
+      QPixmapCache::setCacheLimit(SKIN_ATLAS_CACHE_LIMIT);
+   }
+   QPixmapCache::insert("DNRSkinAtlas:"+Key, Pixmap);
+}
+
+QString DNRSkinAtlas::FullPath(const QString &SkinEnvironmentVariable, const QString &FileName)
+{
+   QString AxumSkinPath = QString(getenv(SkinEnvironmentVariable.toAscii()));
+   return AxumSkinPath + "/" + FileName;
+}
+
+QPixmap DNRSkinAtlas::Pixmap(const QString &SkinEnvironmentVariable, const QString &FileName)
+{
+   if (FileName.isEmpty())
+   {
+      return QPixmap();
+   }
+
+   QString Key = FullPath(SkinEnvironmentVariable, FileName);
+   QPixmap NewPixmap;
+   if ((Find(Key, NewPixmap)) || (MissingFiles().contains(Key)))
+   {
+      return NewPixmap;
+   }
+
+   //a missing file is remembered so it is not retried every paint
+   QImage Image(Key);
+   if (Image.isNull())
+   {
+      MissingFiles().insert(Key);
+      return NewPixmap;
+   }
+   NewPixmap = QPixmap::fromImage(Image);
+   Insert(Key, NewPixmap);
+
+   return NewPixmap;
+}
+
+QPixmap DNRSkinAtlas::ScaledPixmap(const QString &SkinEnvironmentVariable, const QString &FileName, const QSize &Size)
+{
+   QPixmap Original = Pixmap(SkinEnvironmentVariable, FileName);
+   if ((Original.isNull()) || (Original.size() == Size) || (Size.isEmpty()))
+   {
+      return Original;
+   }
+
+   QString Key = QString("%1@%2x%3").arg(FullPath(SkinEnvironmentVariable, FileName)).arg(Size.width()).arg(Size.height());
+   QPixmap CachedPixmap;
+   if (Find(Key, CachedPixmap))
+   {
+      return CachedPixmap;
+   }
+
+   QPixmap NewPixmap = Original.scaled(Size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+   Insert(Key, NewPixmap);
+
+   return NewPixmap;
+}
+
+int DNRSkinAtlas::RotationFrame(double Degrees)
+{
+   int Frame = (int)floor(((Degrees*SKIN_ATLAS_ROTATION_FRAMES)/360)+0.5);
+
+   Frame %= SKIN_ATLAS_ROTATION_FRAMES;
+   if (Frame<0)
+   {
+      Frame += SKIN_ATLAS_ROTATION_FRAMES;
+   }
+   return Frame;
+}
+
+QPixmap DNRSkinAtlas::RotatedPixmap(const QString &SkinEnvironmentVariable, const QString &FileName, int Frame, double Scale)
+{
+   QPixmap Original = Pixmap(SkinEnvironmentVariable, FileName);
+   if (Original.isNull())
+   {
+      return Original;
+   }
+
+   QString Key = QString("%1#%2@%3").arg(FullPath(SkinEnvironmentVariable, FileName)).arg(Frame).arg(Scale, 0, 'f', 3);
+   QPixmap CachedPixmap;
+   if (Find(Key, CachedPixmap))
+   {
+      return CachedPixmap;
+   }
+
+   double ImageWidth = Original.width();
+   double ImageHeight = Original.height();
+   int Side = (int)ceil(sqrt((ImageWidth*ImageWidth)+(ImageHeight*ImageHeight))*Scale);
+
+   QImage Frame8888(Side, Side, QImage::Format_ARGB32_Premultiplied);
+   Frame8888.fill(0);
+
+   QPainter painter(&Frame8888);
+   painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+   painter.translate(Side/2.0, Side/2.0);
+   painter.rotate((Frame*360.0)/SKIN_ATLAS_ROTATION_FRAMES);
+   painter.scale(Scale, Scale);
+   painter.drawPixmap(QPointF(-ImageWidth/2, -ImageHeight/2), Original);
+   painter.end();
+
+   QPixmap NewPixmap = QPixmap::fromImage(Frame8888);
+   Insert(Key, NewPixmap);
+
+   return NewPixmap;
+}
+
+void DNRSkinAtlas::Clear()
+{
+   QPixmapCache::clear();
+   MissingFiles().clear();
+}
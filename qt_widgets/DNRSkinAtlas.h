@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright (C) 2005-2006 Trolltech ASA. All rights reserved.
+**
+** This file is part of the example classes of the Qt Toolkit.
+**
+** This file may be used under the terms of the GNU General Public
+** License version 2.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of
+** this file.  Please review the following information to ensure GNU
+** General Public Licensing requirements will be met:
+** http://www.trolltech.com/products/qt/opensource.html
+**
+** If you are unsure which license is appropriate for your use, please
+** review the following information:
+** http://www.trolltech.com/products/qt/licensing.html or contact the
+** sales department at sales@trolltech.com.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef DNRSKINATLAS_H
+#define DNRSKINATLAS_H
+
+#include <QPixmap>
+#include <QString>
+#include <QSize>
+#include <QSet>
+#include <QtDesigner/QDesignerExportWidget>
+
+//Number of pre-rotated frames kept per knob image and scale
+#define SKIN_ATLAS_ROTATION_FRAMES  128
+
+//Minimum QPixmapCache size in KB, room for the rotation frames of a few knobs
+#define SKIN_ATLAS_CACHE_LIMIT      32768
+
+//Process wide cache of skin images. Each file is loaded once and kept as
+//a pixmap in the native format, scaled and rotated variants are rendered
+//on first use and shared by all widgets. The pixmaps are kept in
+//QPixmapCache, so the least recently used ones are dropped at its limit.
+class QDESIGNER_WIDGET_EXPORT DNRSkinAtlas
+{
+public:
+    //Image FileName from the directory in $SkinEnvironmentVariable,
+    //a null pixmap if the file does not exist
+    static QPixmap Pixmap(const QString &SkinEnvironmentVariable, const QString &FileName);
+    static QPixmap ScaledPixmap(const QString &SkinEnvironmentVariable, const QString &FileName, const QSize &Size);
+
+    //Frame of the image rotated clockwise over Frame*360/SKIN_ATLAS_ROTATION_FRAMES
+    //degrees around its center and scaled with Scale. The frame is square
+    //with the diagonal of the scaled image as side.
+    static QPixmap RotatedPixmap(const QString &SkinEnvironmentVariable, const QString &FileName, int Frame, double Scale = 1);
+    static int RotationFrame(double Degrees);
+
+    //Drops all cached pixmaps, for example after the skin changed on disk
+    static void Clear();
+
+private:
+    static QString FullPath(const QString &SkinEnvironmentVariable, const QString &FileName);
+    static QSet<QString> &MissingFiles();
+    static bool Find(const QString &Key, QPixmap &Pixmap);
+    static void Insert(const QString &Key, const QPixmap &Pixmap);
+};
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "DNRTerminalThread.h"
 #include "qstringlist.h"
+#include <QSocketNotifier>
 #include <private/qthread_p.h>
 #include "linux/serial.h" //for serial_struct
 #include <asm/ioctls.h>   //for TIOCGSERIAL
@@ -53,7 +54,7 @@ DNRTerminalThread::DNRTerminalThread(QObject *parent): QThread(parent)
 
    ProcessID = 0;
    LastElapsedTime = 0;
-   abort = false;
+   previousNumberOfSeconds = 0;
    
    SerialPortHandle = open("/dev/ttyS1", O_RDWR | O_NOCTTY | O_NDELAY);
    fcntl(SerialPortHandle, F_SETFL, FNDELAY); // don't block serial read
@@ -91,10 +92,10 @@ DNRTerminalThread::DNRTerminalThread(QObject *parent): QThread(parent)
 
 DNRTerminalThread::~DNRTerminalThread()
 {
-   ::close((int)SerialPortHandle);
-      
-   abort = true;
+   quit();
 	wait();
+
+   ::close((int)SerialPortHandle);
 }
 
 QObjectList DNRTerminalThread::GetReceiverList(const char *signal)
@@ -107,81 +108,68 @@ QStringList DNRTerminalThread::GetReceivingSlotsList(const char *signal, const c
 	return d_func()->receivingSlotsList(signal, receiver);
 }
 
+//The thread only wakes up when the serial port has data. The notifier is
+//created in this thread and connected direct, so doSerialRead runs here
+//and not in the thread that owns this object.
 void DNRTerminalThread::run()
 {
-	//counter for thread
+   ProcessID = getpid();
+
+   if (SerialPortHandle<0)
+   {
+      SerialPortDebugMessage.sprintf("SerialPortHandle = %d\n", SerialPortHandle);
+      emit SerialDebugMessage(SerialPortDebugMessage);
+      return;
+   }
+   emit SerialDebugMessage(SerialPortDebugMessage);
+
 #ifdef Q_OS_WIN32
 	LARGE_INTEGER freq, newTime;
 	QueryPerformanceFrequency(&freq);
 	QueryPerformanceCounter(&newTime);
-	double newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
+	previousNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
 #else
    timespec newTime;
    clock_gettime(CLOCK_MONOTONIC, &newTime);
-   double newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
+   previousNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
 #endif
 
-   double previousNumberOfSeconds = newNumberOfSeconds;
-   double previousNumberOfSeconds_ms = newNumberOfSeconds;
-   double previousNumberOfSeconds_s = newNumberOfSeconds;
-   double ElapsedTime;
+   QSocketNotifier SerialNotifier(SerialPortHandle, QSocketNotifier::Read);
+   connect(&SerialNotifier, SIGNAL(activated(int)), this, SLOT(doSerialRead()), Qt::DirectConnection);
 
-   ProcessID = getpid();
-         
-   forever
+   exec();
+}
+
+void DNRTerminalThread::doSerialRead()
+{
+   char TemporyReceiveBuffer[4096];
+   int NrOfBytesReceived;
+
+   //drain everything the driver has, the port is non blocking
+   while ((NrOfBytesReceived = read(SerialPortHandle, TemporyReceiveBuffer, 4096)) > 0)
    {
-		if (abort)
-			return;
-      
-      if (SerialPortHandle>=0)
-      {
-         char TemporyReceiveBuffer[4096];
-         
-         memset(TemporyReceiveBuffer, 0x00, 4096);
-         int NrOfBytesReceived = read(SerialPortHandle,TemporyReceiveBuffer, 4096);
-         
-         if (NrOfBytesReceived < 0) 
-         {
-            if (errno == EAGAIN) 
-            {
-               //SerialPortDebugMessage.sprintf("SERIAL EAGAIN ERROR\n");
-            } 
-            else 
-            {
-               SerialPortDebugMessage.sprintf("SERIAL read error %d %s\n", errno, strerror(errno));
-            }
-         }
-         else
-         {
-            //SerialPortDebugMessage.sprintf("Bytes received %d\n", NrOfBytesReceived);
-            
-            emit SerialInputCharacters(TemporyReceiveBuffer);
-         }
-      }
-      else
-      {
-         SerialPortDebugMessage.sprintf("SerialPortHandle = %d\n", SerialPortHandle);
-      }
-      
+      emit SerialInputCharacters(QString::fromLatin1(TemporyReceiveBuffer, NrOfBytesReceived));
+   }
+
+   if ((NrOfBytesReceived < 0) && (errno != EAGAIN))
+   {
+      SerialPortDebugMessage.sprintf("SERIAL read error %d %s\n", errno, strerror(errno));
       emit SerialDebugMessage(SerialPortDebugMessage);
-      
-      unsigned char TempBuffer[1] = {0xAA};
-      write(SerialPortHandle, TempBuffer, 1);
-      
+   }
 
 #ifdef Q_OS_WIN32
-		QueryPerformanceCounter(&newTime);
-		newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
+	LARGE_INTEGER freq, newTime;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&newTime);
+	double newNumberOfSeconds = (double)newTime.QuadPart/freq.QuadPart;
 #else
-	   clock_gettime(CLOCK_MONOTONIC, &newTime);
-   	newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
+   timespec newTime;
+   clock_gettime(CLOCK_MONOTONIC, &newTime);
+   double newNumberOfSeconds = newTime.tv_sec+((double)newTime.tv_nsec/1000000000);
 #endif
 
-      LastElapsedTime = newNumberOfSeconds-previousNumberOfSeconds;
-      previousNumberOfSeconds = newNumberOfSeconds;
-
-      usleep(10000);
-   }
+   LastElapsedTime = newNumberOfSeconds-previousNumberOfSeconds;
+   previousNumberOfSeconds = newNumberOfSeconds;
 }
 
 int DNRTerminalThread::getProcessID()
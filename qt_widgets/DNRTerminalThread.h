@@ -58,13 +58,16 @@ public:
 
 public slots:
 
+private slots:
+   void doSerialRead();
+
 signals:
    void SerialInputCharacters(QString Message);
    void SerialDebugMessage(QString Message);
    
 protected:
 	void run();
-	bool abort;
+	double previousNumberOfSeconds;
    
    
 
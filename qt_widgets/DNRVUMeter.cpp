@@ -46,6 +46,7 @@ DNRVUMeter::DNRVUMeter(QWidget *parent)
     FPointerColor = QColor(255,0,0,255);
     FPointerLength = 120;
     FPointerStartY = 18;
+    BackgroundValid = false;
 
 	 double LiniearMaxPositive = pow(10,((float)90+MINCURVE_POSITIVE)/DIVCURVE_POSITIVE);
 	 LiniearMinPositive = pow(10,((float)0+MINCURVE_POSITIVE)/DIVCURVE_POSITIVE);
@@ -64,7 +65,7 @@ DNRVUMeter::DNRVUMeter(QWidget *parent)
     resize(260, 136);
 }
 
-void DNRVUMeter::paintEvent(QPaintEvent *)
+QLine DNRVUMeter::PointerLine()
 {
    int Radius = FPointerLength;
    int MinDegree = 223;
@@ -104,31 +105,61 @@ void DNRVUMeter::paintEvent(QPaintEvent *)
    int X = cos(RadPosition)*Radius;
    int Y = sin(RadPosition)*Radius;
 
-	QColor PointerColor(0, 0, 255, 255);
+   return QLine((width()/2)+StartX, height()+StartY, (width()/2)+X, height()+Y);
+}
 
-	QPainter painter(this);
-	painter.setRenderHint(QPainter::Antialiasing);
+QRect DNRVUMeter::PointerRect(const QLine &Line)
+{
+   //pen width plus a pixel for the antialiasing
+   int Margin = FPointerWidth+2;
+   return QRect(Line.p1(), Line.p2()).normalized().adjusted(-Margin, -Margin, Margin, Margin);
+}
 
-	if (VUMeterBackgroundQImage->isNull())
-	{
-	}
-	else
+void DNRVUMeter::updatePointer(const QLine &OldLine)
+{
+   QLine NewLine = PointerLine();
+   if (NewLine != OldLine)
+   {
+      update(PointerRect(OldLine) | PointerRect(NewLine));
+   }
+}
+
+void DNRVUMeter::resizeEvent(QResizeEvent *)
+{
+   BackgroundValid = false;
+}
+
+void DNRVUMeter::paintEvent(QPaintEvent *event)
+{
+	if (!BackgroundValid)
 	{
-		painter.drawImage(0,0, *VUMeterBackgroundQImage);
+		BackgroundPixmap = QPixmap(size());
+		BackgroundPixmap.fill(Qt::transparent);
+		if (!VUMeterBackgroundQImage->isNull())
+		{
+			QPainter BackgroundPainter(&BackgroundPixmap);
+			BackgroundPainter.drawImage(0,0, *VUMeterBackgroundQImage);
+		}
+		BackgroundValid = true;
 	}
 
+	QPainter painter(this);
+	painter.drawPixmap(event->rect(), BackgroundPixmap, event->rect());
+
+	painter.setRenderHint(QPainter::Antialiasing);
 	painter.setPen(QPen(QBrush(FPointerColor), FPointerWidth));
 	painter.setBrush(Qt::NoBrush);
 
-	painter.drawLine((width()/2)+StartX, height()+StartY, (width()/2)+X, height()+Y);
+	painter.drawLine(PointerLine());
 }
 
 void DNRVUMeter::setdBPosition(double_db NewdBPosition)
 {
    if (FdBPosition != NewdBPosition)
    {
+      QLine OldLine = PointerLine();
       FdBPosition = NewdBPosition;
-      update();
+      updatePointer(OldLine);
    }
 }
 
@@ -280,6 +311,7 @@ void DNRVUMeter::setSkinEnvironmentVariable(const QString &NewSkinEnvironmentVar
 		  VUMeterBackgroundQImage = new QImage();
 
 	  }
+      BackgroundValid = false;
       update();
    }
 }
@@ -302,6 +334,7 @@ void DNRVUMeter::setVUMeterBackgroundFileName(const QString &NewVUMeterBackgroun
 		  VUMeterBackgroundQImage = new QImage();
 
 	  }
+      BackgroundValid = false;
       update();
    }
 }
@@ -26,6 +26,7 @@
 
 #include "DNRDefines.h"
 #include <QWidget>
+#include <QPixmap>
 #include <QtDesigner/QDesignerExportWidget>
 
 #define DIVCURVE_POSITIVE	63.0
@@ -101,11 +102,20 @@ public:
 
 protected:
     void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
 //    void mouseMoveEvent(QMouseEvent *ev);
 
     double previousNumberOfSeconds;
 
 private:
+    //Background image converted to a pixmap once, only the area
+    //around the old and new pointer is repainted
+    QPixmap BackgroundPixmap;
+    bool BackgroundValid;
+    QLine PointerLine();
+    QRect PointerRect(const QLine &Line);
+    void updatePointer(const QLine &OldLine);
+
 	double LiniearMinPositive;
   	double LiniearRangePositive;
 	double LiniearMinNegative;
@@ -22,6 +22,7 @@ DNRWidgets::DNRWidgets(QObject *parent)
         widgets.append(new PPMMeterPlugin(this));
         widgets.append(new VUMeterPlugin(this));
         widgets.append(new PhaseMeterPlugin(this));
+        widgets.append(new MeterBridgePlugin(this));
         widgets.append(new ImagePlugin(this));
         widgets.append(new IndicationPlugin(this));
         widgets.append(new EQPanelPlugin(this));
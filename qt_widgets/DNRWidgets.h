@@ -17,6 +17,7 @@
 #include "DNRPPMMeterPlugin.h"
 #include "DNRVUMeterPlugin.h"
 #include "DNRPhaseMeterPlugin.h"
+#include "DNRMeterBridgePlugin.h"
 #include "DNRImagePlugin.h"
 #include "DNRIndicationPlugin.h"
 #include "DNREQPanelPlugin.h"
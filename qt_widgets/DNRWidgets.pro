@@ -1,6 +1,7 @@
 CONFIG += qt release plugin designer
 TEMPLATE = lib
 QT += network sql
+QMAKE_CXXFLAGS_RELEASE += -ftree-vectorize
 
 HEADERS = DNRAnalogClock.h \
   DNRAnalogClockPlugin.h \
@@ -18,6 +19,9 @@ HEADERS = DNRAnalogClock.h \
   DNRVUMeterPlugin.h \
   DNRPhaseMeter.h \
   DNRPhaseMeterPlugin.h \
+  DNRBallistics.h \
+  DNRMeterBridge.h \
+  DNRMeterBridgePlugin.h \
   DNRImage.h \
   DNRImagePlugin.h \
   DNRMovie.h \
@@ -30,6 +34,8 @@ HEADERS = DNRAnalogClock.h \
   DNRNetworkServerPlugin.h \
   DNRNetworkClient.h \
   DNRNetworkClientPlugin.h \
+  DNRFaderProtocol.h \
+  DNRSkinAtlas.h \
   DNRWidgets.h \
   DNRDefines.h 
 
@@ -49,6 +55,9 @@ SOURCES = DNRAnalogClock.cpp \
   DNRVUMeterPlugin.cpp \
   DNRPhaseMeter.cpp \
   DNRPhaseMeterPlugin.cpp \
+  DNRBallistics.cpp \
+  DNRMeterBridge.cpp \
+  DNRMeterBridgePlugin.cpp \
   DNRImage.cpp \
   DNRImagePlugin.cpp \
   DNRMovie.cpp \
@@ -61,6 +70,8 @@ SOURCES = DNRAnalogClock.cpp \
   DNRNetworkServerPlugin.cpp \
   DNRNetworkClient.cpp \
   DNRNetworkClientPlugin.cpp \
+  DNRFaderProtocol.cpp \
+  DNRSkinAtlas.cpp \
   DNRWidgets.cpp \
   DNRDefines.cpp 
 
@@ -0,0 +1,19 @@
+-- On the MySQL server holding the hardware_status database, execute the
+-- following once to let the DNRMySQLClient widgets follow changes with a
+-- version probe instead of reading the tables 30 times per second:
+--
+--  $ mysql -u root hardware_status <hardware_status.sql
+--
+-- The hardware writer flags every status change by setting HardwareSet in
+-- configuration_rack_axum, so a version bumped on each update of that row
+-- covers the slot tables as well. Clients without this column keep polling.
+
+
+ALTER TABLE configuration_rack_axum
+  ADD COLUMN ChangeVersion BIGINT UNSIGNED NOT NULL DEFAULT 0;
+
+-- MySQL fires update triggers for every matched row, also when the values
+-- did not change, so setting HardwareSet again still bumps the version
+CREATE TRIGGER configuration_rack_axum_change_version
+  BEFORE UPDATE ON configuration_rack_axum
+  FOR EACH ROW SET NEW.ChangeVersion = OLD.ChangeVersion+1;